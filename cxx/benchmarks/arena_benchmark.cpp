@@ -0,0 +1,242 @@
+/*
+ * --------------------------------------------------------------------------------
+ * SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+ * Johannes Kepler University, Institute for Integrated Circuits.
+ *
+ * This file is part of KPEX 
+ * (see https://github.com/iic-jku/klayout-pex).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * --------------------------------------------------------------------------------
+ */
+//
+// Builds and serializes large kpex.request.RExtractionRequest and kpex.result.PEXResult messages,
+// once with heap allocated messages (baseline) and once in a reused kpex::pb::MessageArena,
+// and reports heap allocations, time and serialization throughput per round.
+//
+// Usage: arena_benchmark [<rounds> [<nets>]]
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include "kpex/request/pex_request.pb.h"
+#include "kpex/result/pex_result.pb.h"
+#include "message_arena.h"
+
+//-------------------------------------------------------------------------
+// counting global allocator
+
+namespace {
+
+std::atomic<uint64_t> allocationCount = 0;
+std::atomic<uint64_t> allocatedBytes = 0;
+
+void *countedAllocation(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void *p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+}
+
+void *operator new(std::size_t size) { return countedAllocation(size); }
+void *operator new[](std::size_t size) { return countedAllocation(size); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+//-------------------------------------------------------------------------
+
+namespace {
+
+struct Workload {
+    uint32_t nets = 1000;
+    uint32_t shapesPerNet = 100;     // half boxes, half polygons
+    uint32_t pointsPerPolygon = 8;
+    uint32_t nodesPerNet = 200;
+};
+
+void setPoint(kpex::geometry::Point *p, int64_t x, int64_t y) {
+    p->set_x(x);
+    p->set_y(y);
+}
+
+void buildRequest(kpex::request::RExtractionRequest *request, const Workload &w) {
+    for (uint32_t n = 0; n < w.nets; ++n) {
+        auto *net = request->add_net_extraction_requests();
+        net->set_net_name("net" + std::to_string(n));
+
+        auto *pin = net->add_pins();
+        pin->set_label("pin" + std::to_string(n));
+        pin->set_net_name(net->net_name());
+        setPoint(pin->mutable_label_point(), n, 0);
+
+        auto *lr = net->add_region_by_layer();
+        lr->mutable_layer()->set_lvs_layer_name("met1_con");
+        auto *region = lr->mutable_region();
+        for (uint32_t s = 0; s < w.shapesPerNet; ++s) {
+            auto *shape = region->add_shapes();
+            const int64_t x = static_cast<int64_t>(s) * 1000;
+            const int64_t y = static_cast<int64_t>(n) * 1000;
+            if (s % 2 == 0) {
+                shape->set_kind(kpex::geometry::Shape::SHAPE_KIND_BOX);
+                auto *box = shape->mutable_box();
+                setPoint(box->mutable_lower_left(), x, y);
+                setPoint(box->mutable_upper_right(), x + 500, y + 140);
+                box->set_net(net->net_name());
+            } else {
+                shape->set_kind(kpex::geometry::Shape::SHAPE_KIND_POLYGON);
+                auto *polygon = shape->mutable_polygon();
+                for (uint32_t i = 0; i < w.pointsPerPolygon; ++i) {
+                    setPoint(polygon->add_hull_points(), x + (i % 2) * 140, y + (i / 2) * 140);
+                }
+                polygon->set_net(net->net_name());
+            }
+        }
+    }
+}
+
+void buildResult(kpex::result::PEXResult *result, const Workload &w) {
+    auto *r = result->mutable_top_cell_extraction_result()->mutable_r_result();
+    for (uint32_t n = 0; n < w.nets; ++n) {
+        auto *network = r->add_networks();
+        network->set_net_name("net" + std::to_string(n));
+        for (uint32_t i = 0; i < w.nodesPerNet; ++i) {
+            auto *node = network->add_nodes();
+            node->set_node_id(i);
+            node->set_node_name("n" + std::to_string(i));
+            node->set_node_kind(kpex::r::RNode::KIND_WIRE_JUNCTION);
+            node->set_layer_name("met1");
+            node->set_net_name(network->net_name());
+            auto *location = node->mutable_location();
+            location->set_kind(kpex::layout::Location::LOCATION_KIND_POINT);
+            setPoint(location->mutable_point(), i * 100, n * 100);
+            node->mutable_wire_junction();
+        }
+        for (uint32_t i = 0; i + 1 < w.nodesPerNet; ++i) {
+            auto *element = network->add_elements();
+            element->set_element_id(i);
+            element->mutable_node_a()->set_node_id(i);
+            element->mutable_node_b()->set_node_id(i + 1);
+            element->set_resistance(0.125 * (i + 1));
+        }
+    }
+}
+
+struct Measurement {
+    double millisecondsPerRound = 0.0;
+    double allocationsPerRound = 0.0;
+    double allocatedMegabytesPerRound = 0.0;
+    double serializedMegabytes = 0.0;
+};
+
+Measurement measure(uint32_t rounds, const std::function<size_t()> &round) {
+    round();  // warm up (e.g. the arena's blocks, the serialization buffer)
+
+    const uint64_t allocationsBefore = allocationCount.load();
+    const uint64_t bytesBefore = allocatedBytes.load();
+    size_t serializedBytes = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < rounds; ++i) {
+        serializedBytes = round();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    Measurement m;
+    m.millisecondsPerRound = std::chrono::duration<double, std::milli>(end - start).count() / rounds;
+    m.allocationsPerRound = static_cast<double>(allocationCount.load() - allocationsBefore) / rounds;
+    m.allocatedMegabytesPerRound = static_cast<double>(allocatedBytes.load() - bytesBefore) / rounds / 1e6;
+    m.serializedMegabytes = static_cast<double>(serializedBytes) / 1e6;
+    return m;
+}
+
+void report(const std::string &message, const std::string &mode, const Measurement &m) {
+    std::cout << std::left << std::setw(20) << message
+              << std::setw(8) << mode
+              << std::right << std::fixed
+              << std::setw(12) << std::setprecision(2) << m.millisecondsPerRound << " ms"
+              << std::setw(14) << std::setprecision(0) << m.allocationsPerRound << " allocs"
+              << std::setw(10) << std::setprecision(1) << m.allocatedMegabytesPerRound << " MB heap"
+              << std::setw(10) << std::setprecision(1) << m.serializedMegabytes / (m.millisecondsPerRound / 1000.0)
+              << " MB/s serialized"
+              << std::endl;
+}
+
+template <typename M>
+void benchmark(const std::string &name,
+               uint32_t rounds,
+               const Workload &w,
+               void (*build)(M *, const Workload &))
+{
+    std::string buffer;
+
+    const Measurement heap = measure(rounds, [&]() {
+        M message;
+        build(&message, w);
+        kpex::pb::serialize(message, &buffer);
+        return buffer.size();
+    });
+    report(name, "heap", heap);
+
+    kpex::pb::MessageArena arena;
+    const Measurement arenaMeasurement = measure(rounds, [&]() {
+        M *message = arena.create<M>();
+        build(message, w);
+        kpex::pb::serialize(*message, &buffer);
+        arena.reset();
+        return buffer.size();
+    });
+    report(name, "arena", arenaMeasurement);
+}
+
+}
+
+int main(int argc, char **argv) {
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    uint32_t rounds = 10;
+    Workload w;
+    if (argc >= 2) {
+        rounds = static_cast<uint32_t>(std::max(1, std::atoi(argv[1])));
+    }
+    if (argc >= 3) {
+        w.nets = static_cast<uint32_t>(std::max(1, std::atoi(argv[2])));
+    }
+
+    std::cout << "Rounds: " << rounds << ", nets: " << w.nets
+              << ", shapes per net: " << w.shapesPerNet
+              << ", R nodes per net: " << w.nodesPerNet << std::endl;
+
+    benchmark<kpex::request::RExtractionRequest>("RExtractionRequest", rounds, w, &buildRequest);
+    benchmark<kpex::result::PEXResult>("PEXResult", rounds, w, &buildResult);
+
+    google::protobuf::ShutdownProtobufLibrary();
+
+    return 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * --------------------------------------------------------------------------------
+ * SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+ * Johannes Kepler University, Institute for Integrated Circuits.
+ *
+ * This file is part of KPEX 
+ * (see https://github.com/iic-jku/klayout-pex).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * --------------------------------------------------------------------------------
+ */
+#include "fringe_tables.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+
+// NOTE: all PDKs built by gen_tech_pb use a database unit of 1 nm,
+//       the engine falls back to the formula for layouts with another database unit
+constexpr double dbu = 0.001;
+
+// NOTE: same as fringe_halo.FRINGE_ALPHA_SCALE_FACTOR (overlap scaling is 1/50, see MAGIC ExtTech)
+constexpr double fringeAlphaScaleFactor = 0.02 * 0.01 * 0.5 * 200.0;
+
+// NOTE: same as TechInfo.internal_substrate_layer_name
+const std::string internalSubstrateLayerName = "VSUBS";
+
+// max. error of the linear interpolation (absolute, in fringe fraction)
+constexpr double tolerance = 1e-4;
+
+// candidates for FringeFractionTable.samples_per_segment
+constexpr std::array<uint32_t, 4> samplesPerSegmentChoices = { 16, 32, 64, 128 };
+
+struct TableLayout {
+    uint32_t firstStepDbu = 0;
+    uint32_t samplesPerSegment = 0;
+    uint64_t sampleCount = 0;
+};
+
+double fringeFraction(double alpha, double distance_um) {
+    return (2.0 / std::numbers::pi) * std::atan(alpha * distance_um);
+}
+
+// |f''(d)| = (2/π) · 2α³d / (1 + α²d²)², maximal at d = 1 / (√3 · alpha)
+double maxSecondDerivative(double alpha, double from_um, double to_um) {
+    const double d = std::clamp(1.0 / (std::sqrt(3.0) * alpha), from_um, to_um);
+    const double x = alpha * d;
+    return (2.0 / std::numbers::pi) * 2.0 * alpha * alpha * x / ((1.0 + x * x) * (1.0 + x * x));
+}
+
+// the linear interpolation error of each segment is bounded by step² / 8 · max|f''|,
+// returns the sample count of the layout, or 0 if the tolerance is not met
+uint64_t sampleCount(double alpha, uint32_t firstStepDbu, uint32_t samplesPerSegment, double endDbu) {
+    uint64_t start = 0;
+    uint64_t step = firstStepDbu;
+    uint64_t count = 1;
+    while (static_cast<double>(start) <= endDbu) {
+        const uint64_t end = start + samplesPerSegment * step;
+        const double step_um = static_cast<double>(step) * dbu;
+        const double err = step_um * step_um / 8.0
+                           * maxSecondDerivative(alpha, static_cast<double>(start) * dbu, static_cast<double>(end) * dbu);
+        if (err > tolerance) {
+            return 0;
+        }
+        count += samplesPerSegment;
+        start = end;
+        step *= 2;
+    }
+    return count;
+}
+
+// the smallest table within the tolerance
+TableLayout chooseLayout(double alpha, double sideHalo, double endDbu) {
+    // the first segment is within the tolerance with this step,
+    // NOTE: for a (nearly) flat fraction the step is huge, but never needs to exceed the table
+    const double step_um = std::sqrt(8.0 * tolerance / maxSecondDerivative(alpha, 0.0, sideHalo));
+    const double stepDbu = std::clamp(std::floor(step_um / dbu), 1.0, std::ceil(endDbu));
+    const uint32_t maxFirstStepDbu = static_cast<uint32_t>(stepDbu);
+    
+    TableLayout best;
+    for (uint32_t samplesPerSegment : samplesPerSegmentChoices) {
+        // the following segments have doubled steps, reduce the first step until they are within as well
+        for (uint32_t firstStepDbu = maxFirstStepDbu; firstStepDbu >= 1; --firstStepDbu) {
+            const uint64_t count = sampleCount(alpha, firstStepDbu, samplesPerSegment, endDbu);
+            if (count > 0) {
+                if (best.sampleCount == 0 || count < best.sampleCount) {
+                    best = { firstStepDbu, samplesPerSegment, count };
+                }
+                break;
+            }
+        }
+    }
+    if (best.sampleCount == 0) {
+        throw std::runtime_error("No fringe fraction table layout within the tolerance for alpha "
+                                 + std::to_string(alpha));
+    }
+    return best;
+}
+
+void addTable(kpex::tech::CapacitanceInfo *ci,
+              const std::string &topLayerName,
+              const std::string &bottomLayerName,
+              double alpha,
+              double sideHalo)
+{
+    auto *t = ci->add_fringe_fractions();
+    t->set_top_layer_name(topLayerName);
+    t->set_bottom_layer_name(bottomLayerName);
+    t->set_alpha(alpha);
+    t->set_dbu(dbu);
+    
+    // NOTE: the engine's halo is extended by 1 dbu
+    const double endDbu = sideHalo / dbu + 1.0;
+    
+    const TableLayout layout = chooseLayout(alpha, sideHalo, endDbu);
+    t->set_first_step_dbu(layout.firstStepDbu);
+    t->set_samples_per_segment(layout.samplesPerSegment);
+    
+    uint64_t start = 0;
+    uint64_t step = layout.firstStepDbu;
+    while (static_cast<double>(start) <= endDbu) {
+        for (uint32_t i = 0; i < layout.samplesPerSegment; ++i) {
+            t->add_fractions(fringeFraction(alpha, static_cast<double>(start + i * step) * dbu));
+        }
+        start += layout.samplesPerSegment * step;
+        step *= 2;
+    }
+    t->add_fractions(fringeFraction(alpha, static_cast<double>(start) * dbu));
+}
+
+void addTables(kpex::tech::ProcessParasiticsInfo *ppi) {
+    kpex::tech::CapacitanceInfo *ci = ppi->mutable_capacitance();
+    ci->clear_fringe_fractions();
+    
+    // NOTE: same specs as TechInfo.overlap_cap_by_layer_names,
+    //       the substrate caps are overlap caps to the internal substrate layer
+    std::map<std::pair<std::string, std::string>, double> capacitanceByLayerNames;
+    for (const auto &sc : ci->substrates()) {
+        capacitanceByLayerNames[{ sc.layer_name(), internalSubstrateLayerName }] = sc.area_capacitance();
+    }
+    for (const auto &oc : ci->overlaps()) {
+        capacitanceByLayerNames[{ oc.top_layer_name(), oc.bottom_layer_name() }] = oc.capacitance();
+    }
+    
+    for (const auto &[layerNames, capacitance] : capacitanceByLayerNames) {
+        // NOTE: without capacitance there is no fringe (alpha 0, fraction 0 for all distances),
+        //       the engine falls back to the formula for layer pairs without a table
+        if (capacitance <= 0.0) {
+            continue;
+        }
+        addTable(ci, layerNames.first, layerNames.second,
+                 capacitance * fringeAlphaScaleFactor, ppi->side_halo());
+    }
+}
+
+}
+
+void addFringeFractionTables(kpex::tech::Technology *tech) {
+    addTables(tech->mutable_process_parasitics());
+}
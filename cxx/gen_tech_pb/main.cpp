@@ -25,17 +25,38 @@
 #include <iostream>
 #include <filesystem>
 
+#include "fringe_tables.h"
+#include "message_arena.h"
 #include "protobuf.h"
+#include "r_extractor_tech.h"
+#include "resolved_stack.h"
+#include "tech_header.h"
 #include "pdk/gf180mcuD.h"
 #include "pdk/ihp_sg13g2.h"
 #include "pdk/sky130A.h"
 
 void writeTech(const std::filesystem::path &output_directory,
+               const std::filesystem::path &header_output_directory,
                const std::string &tech_name,
                const kpex::tech::Technology &tech)
 {
     const std::filesystem::path json_pb_path = output_directory / (tech_name + "_tech" + ".pb.json");
     write(tech, json_pb_path.string(), Format::JSON);
+    
+    if (!header_output_directory.empty()) {
+        const std::filesystem::path header_path = header_output_directory / (tech_name + "_tech" + ".h");
+        writeTechHeader(tech, header_path.string());
+    }
+}
+
+bool prepareDirectory(const std::filesystem::path &directory) {
+    if (std::filesystem::exists(directory) && !std::filesystem::is_directory(directory)) {
+        std::cerr << "ERROR: Output directory path '" << directory.string() << "' "
+                  << "already exists, but is not a directory" << std::endl;
+        return false;
+    }
+    std::filesystem::create_directories(directory);
+    return true;
 }
 
 int main(int argc, char **argv) {
@@ -45,33 +66,61 @@ int main(int argc, char **argv) {
 
     
     if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <output-directory>" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " <output-directory> [<header-output-directory>]" << std::endl;
         return 1;
     }
     
     std::filesystem::path output_directory(argv[1]);
-    if (std::filesystem::exists(output_directory) && !std::filesystem::is_directory(output_directory)) {
-        std::cerr << "ERROR: Output directory path already exists, but is not a directory" << std::endl;
+    if (!prepareDirectory(output_directory)) {
         return 2;
     }
-    std::filesystem::create_directories(output_directory);
-
-    {
-        kpex::tech::Technology tech;
-        gf180mcuD::buildTech(tech);
-        writeTech(output_directory, "gf180mcuD", tech);
+    
+    // optional: protobuf-free C++ headers with the PDK tables (see tech_tables.h)
+    std::filesystem::path header_output_directory;
+    if (argc >= 3) {
+        header_output_directory = argv[2];
+        if (!prepareDirectory(header_output_directory)) {
+            return 2;
+        }
     }
 
-    {
-        kpex::tech::Technology tech;
-        sky130A::buildTech(tech);
-        writeTech(output_directory, "sky130A", tech);
-    }
-    
-    {
-        kpex::tech::Technology tech;
-        ihp_sg13g2::buildTech(tech);
-        writeTech(output_directory, "ihp-sg13g2", tech);
+    // NOTE: all nested messages of a technology are allocated in the arena,
+    //       its memory is reused for the next technology
+    kpex::pb::MessageArena arena;
+
+    try {
+        {
+            auto *tech = arena.create<kpex::tech::Technology>();
+            gf180mcuD::buildTech(*tech);
+            resolveProcessStacks(tech);
+            resolveRExtractorTechs(tech);
+            addFringeFractionTables(tech);
+            writeTech(output_directory, header_output_directory, "gf180mcuD", *tech);
+            arena.reset();
+        }
+
+        {
+            auto *tech = arena.create<kpex::tech::Technology>();
+            sky130A::buildTech(*tech);
+            resolveProcessStacks(tech);
+            resolveRExtractorTechs(tech);
+            addFringeFractionTables(tech);
+            writeTech(output_directory, header_output_directory, "sky130A", *tech);
+            arena.reset();
+        }
+        
+        {
+            auto *tech = arena.create<kpex::tech::Technology>();
+            ihp_sg13g2::buildTech(*tech);
+            resolveProcessStacks(tech);
+            resolveRExtractorTechs(tech);
+            addFringeFractionTables(tech);
+            writeTech(output_directory, header_output_directory, "ihp-sg13g2", *tech);
+            arena.reset();
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 3;
     }
 
     // Optional:  Delete all global objects allocated by libprotobuf.
@@ -22,6 +22,10 @@
  * --------------------------------------------------------------------------------
  */
 #include "protobuf.h"
+#include "message_arena.h"
+#include "message_io.h"
+
+#include <stdexcept>
 
 const char *describeFormat(Format format) {
     switch (format) {
@@ -29,6 +33,20 @@ const char *describeFormat(Format format) {
         case Format::PROTOBUF_BINARY: return "Protobuf Binary";
         case Format::JSON: return "JSON";
     }
+    return "?";
+}
+
+namespace {
+
+kpex::pb::Format messageFormat(Format format) {
+    switch (format) {
+        case Format::PROTOBUF_TEXTUAL: return kpex::pb::Format::Text;
+        case Format::PROTOBUF_BINARY: return kpex::pb::Format::Binary;
+        case Format::JSON: return kpex::pb::Format::JSON;
+    }
+    throw std::runtime_error("Unknown format");
+}
+
 }
 
 void write(const kpex::tech::Technology &tech,
@@ -38,35 +56,7 @@ void write(const kpex::tech::Technology &tech,
     std::cout << "Writing technology protobuf message to file '" << outputPath << "' "
               << "in " << describeFormat(format) << " format." << std::endl;
     
-    switch (format) {
-        case Format::PROTOBUF_TEXTUAL: {
-            std::ofstream output(outputPath, std::ios::out | std::ios::binary);
-            output << "# proto-file: tech.proto" << std::endl
-                   << "# proto-message: kpex.tech.Technology" << std::endl << std::endl;
-            google::protobuf::io::OstreamOutputStream zcos(&output);
-            google::protobuf::TextFormat::Print(tech, &zcos);
-            break;
-        }
-
-        case Format::PROTOBUF_BINARY: {
-            std::ofstream output(outputPath, std::ios::out | std::ios::binary);
-            tech.SerializeToOstream(&output);
-            break;
-        }
-            
-        case Format::JSON: {
-            std::string jsonString;
-            google::protobuf::util::JsonPrintOptions options;
-            options.add_whitespace = true;
-            options.preserve_proto_field_names = true;
-            auto status =
-                google::protobuf::util::MessageToJsonString(tech, &jsonString, options);
-            std::ofstream output(outputPath, std::ios::out | std::ios::binary);
-            output << jsonString;
-            output.close();
-            break;
-        }
-    }
+    kpex::pb::writeMessage(tech, outputPath, messageFormat(format));
 }
 
 void read(kpex::tech::Technology *tech,
@@ -76,31 +66,7 @@ void read(kpex::tech::Technology *tech,
     std::cout << "Reading technology protobuf message from file '" << inputPath << "' "
               << "in " << describeFormat(format) << " format." << std::endl;
     
-    switch (format) {
-        case Format::PROTOBUF_TEXTUAL: {
-            std::fstream input(inputPath, std::ios::in);
-            google::protobuf::io::IstreamInputStream fis(&input);
-            google::protobuf::TextFormat::Parse(&fis, tech);
-            break;
-        }
-            
-        case Format::PROTOBUF_BINARY: {
-            std::fstream input(inputPath, std::ios::in | std::ios::binary);
-            tech->ParseFromIstream(&input);
-            break;
-        }
-        
-        case Format::JSON: {
-            google::protobuf::util::JsonParseOptions options;
-
-            std::fstream input(inputPath, std::ios::in);
-            std::ostringstream buffer;
-            buffer << input.rdbuf();
-            auto status =
-                google::protobuf::util::JsonStringToMessage(buffer.str(), tech, options);
-            break;
-        }
-    }
+    kpex::pb::readMessage(inputPath, messageFormat(format), tech);
 }
 
 void convert(const std::string &inputPath,
@@ -110,9 +76,10 @@ void convert(const std::string &inputPath,
 {
     std::cout << "Converting ..." << std::endl;
     
-    kpex::tech::Technology tech;
-    read(&tech, inputPath, inputFormat);
-    write(tech, outputPath, outputFormat);
+    kpex::pb::MessageArena arena;
+    auto *tech = arena.create<kpex::tech::Technology>();
+    read(tech, inputPath, inputFormat);
+    write(*tech, outputPath, outputFormat);
 }
 
 void addLayer(kpex::tech::Technology *tech,
@@ -402,3 +369,146 @@ void addSidewallOverlapCap(kpex::tech::CapacitanceInfo *ci,
     soc->set_capacitance(cap);
 }
 
+//-------------------------------------------------------------------------
+
+void addLayers(kpex::tech::Technology *tech,
+               std::span<const kpex::tables::Layer> layers)
+{
+    for (const auto &l : layers) {
+        addLayer(tech,
+                 static_cast<kpex::tech::LayerInfo::Purpose>(l.purpose),
+                 std::string(l.name),
+                 l.drw_gds_layer, l.drw_gds_datatype,
+                 l.pin_gds_layer, l.pin_gds_datatype,
+                 l.label_gds_layer, l.label_gds_datatype,
+                 std::string(l.description));
+    }
+}
+
+void addComputedLayers(kpex::tech::Technology *tech,
+                       std::span<const kpex::tables::ComputedLayer> layers)
+{
+    for (const auto &cl : layers) {
+        addComputedLayer(tech,
+                         static_cast<kpex::tech::LayerInfo::Purpose>(cl.purpose),
+                         static_cast<kpex::tech::ComputedLayerInfo_Kind>(cl.kind),
+                         std::string(cl.name),
+                         cl.gds_layer, cl.gds_datatype,
+                         std::string(cl.original_layer_name),
+                         std::string(cl.description));
+    }
+}
+
+static kpex::tech::ProcessStackInfo::Contact *
+mutableContactAbove(kpex::tech::ProcessStackInfo *psi,
+                    std::string_view stack_layer)
+{
+    using LayerInfo = kpex::tech::ProcessStackInfo::LayerInfo;
+    
+    for (auto &li : *psi->mutable_layers()) {
+        if (li.name() != stack_layer) {
+            continue;
+        }
+        switch (li.parameters_case()) {
+            case LayerInfo::kNwellLayer:     return li.mutable_nwell_layer()->mutable_contact_above();
+            case LayerInfo::kDiffusionLayer: return li.mutable_diffusion_layer()->mutable_contact_above();
+            case LayerInfo::kMetalLayer:     return li.mutable_metal_layer()->mutable_contact_above();
+            default:
+                break;
+        }
+    }
+    throw std::runtime_error("No NWell, Diffusion or Metal stack layer named '"
+                             + std::string(stack_layer) + "' for contact");
+}
+
+void addProcessStack(kpex::tech::ProcessStackInfo *psi,
+                     std::span<const kpex::tables::StackLayer> layers,
+                     std::span<const kpex::tables::Contact> contacts)
+{
+    using kpex::tables::StackLayerKind;
+    
+    for (const auto &sl : layers) {
+        const std::string name(sl.name);
+        const std::string reference(sl.reference);
+        
+        switch (sl.kind) {
+            case StackLayerKind::Substrate:
+                addSubstrateLayer(psi, name, sl.height, sl.thickness, reference);
+                break;
+            case StackLayerKind::NWell:
+                addNWellLayer(psi, name, sl.z, reference);
+                break;
+            case StackLayerKind::Diffusion:
+                addDiffusionLayer(psi, name, sl.z, reference);
+                break;
+            case StackLayerKind::FieldOxide:
+                addFieldOxideLayer(psi, name, sl.dielectric_k);
+                break;
+            case StackLayerKind::Metal:
+                addMetalLayer(psi, name, sl.z, sl.thickness);
+                break;
+            case StackLayerKind::SidewallDielectric:
+                addSidewallDielectric(psi, name, sl.dielectric_k,
+                                      sl.height_above_metal, sl.width_outside_sidewall,
+                                      reference);
+                break;
+            case StackLayerKind::SimpleDielectric:
+                addSimpleDielectric(psi, name, sl.dielectric_k, reference);
+                break;
+            case StackLayerKind::ConformalDielectric:
+                addConformalDielectric(psi, name, sl.dielectric_k,
+                                       sl.thickness_over_metal, sl.thickness_where_no_metal,
+                                       sl.thickness_sidewall,
+                                       reference);
+                break;
+        }
+    }
+    
+    for (const auto &c : contacts) {
+        setContact(mutableContactAbove(psi, c.stack_layer),
+                   std::string(c.name),
+                   std::string(c.layer_below),
+                   std::string(c.metal_above),
+                   c.thickness, c.width, c.spacing, c.border);
+    }
+}
+
+void addResistances(kpex::tech::ResistanceInfo *ri,
+                    std::span<const kpex::tables::LayerResistance> layers,
+                    std::span<const kpex::tables::ContactResistance> contacts,
+                    std::span<const kpex::tables::ViaResistance> vias)
+{
+    for (const auto &lr : layers) {
+        addLayerResistance(ri, std::string(lr.layer_name), lr.resistance, lr.corner_adjustment_fraction);
+    }
+    for (const auto &cr : contacts) {
+        addContactResistance(ri,
+                             std::string(cr.contact_name),
+                             std::string(cr.device_layer_name),
+                             std::string(cr.layer_above),
+                             cr.resistance);
+    }
+    for (const auto &vr : vias) {
+        addViaResistance(ri, std::string(vr.via_name), vr.resistance);
+    }
+}
+
+void addCapacitances(kpex::tech::CapacitanceInfo *ci,
+                     std::span<const kpex::tables::SubstrateCap> substrates,
+                     std::span<const kpex::tables::OverlapCap> overlaps,
+                     std::span<const kpex::tables::SidewallCap> sidewalls,
+                     std::span<const kpex::tables::SidewallOverlapCap> sideoverlaps)
+{
+    for (const auto &sc : substrates) {
+        addSubstrateCap(ci, std::string(sc.layer_name), sc.area_cap, sc.perimeter_cap);
+    }
+    for (const auto &oc : overlaps) {
+        addOverlapCap(ci, std::string(oc.top_layer), std::string(oc.bottom_layer), oc.cap);
+    }
+    for (const auto &swc : sidewalls) {
+        addSidewallCap(ci, std::string(swc.layer_name), swc.cap, swc.offset);
+    }
+    for (const auto &soc : sideoverlaps) {
+        addSidewallOverlapCap(ci, std::string(soc.in_layer), std::string(soc.out_layer), soc.cap);
+    }
+}
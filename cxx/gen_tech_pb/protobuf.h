@@ -32,10 +32,12 @@
 
 #include <iostream>
 #include <fstream>
+#include <span>
 #include <string>
 #include <sstream>
 
 #include "kpex/tech/tech.pb.h"
+#include "tech_tables.h"
 
 enum Format {
     PROTOBUF_TEXTUAL,
@@ -181,5 +183,30 @@ void addSidewallOverlapCap(kpex::tech::CapacitanceInfo *ci,
                            const std::string &out_layer,
                            float cap);
 
+//-------------------------------------------------------------------------
+// table driven variants, the rows are added in table order
+// using the functions above (see tech_tables.h)
+
+void addLayers(kpex::tech::Technology *tech,
+               std::span<const kpex::tables::Layer> layers);
+
+void addComputedLayers(kpex::tech::Technology *tech,
+                       std::span<const kpex::tables::ComputedLayer> layers);
+
+void addProcessStack(kpex::tech::ProcessStackInfo *psi,
+                     std::span<const kpex::tables::StackLayer> layers,
+                     std::span<const kpex::tables::Contact> contacts);
+
+void addResistances(kpex::tech::ResistanceInfo *ri,
+                    std::span<const kpex::tables::LayerResistance> layers,
+                    std::span<const kpex::tables::ContactResistance> contacts,
+                    std::span<const kpex::tables::ViaResistance> vias);
+
+void addCapacitances(kpex::tech::CapacitanceInfo *ci,
+                     std::span<const kpex::tables::SubstrateCap> substrates,
+                     std::span<const kpex::tables::OverlapCap> overlaps,
+                     std::span<const kpex::tables::SidewallCap> sidewalls,
+                     std::span<const kpex::tables::SidewallOverlapCap> sideoverlaps);
+
 #endif
 
@@ -0,0 +1,235 @@
+/*
+ * --------------------------------------------------------------------------------
+ * SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+ * Johannes Kepler University, Institute for Integrated Circuits.
+ *
+ * This file is part of KPEX 
+ * (see https://github.com/iic-jku/klayout-pex).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * --------------------------------------------------------------------------------
+ */
+#include "r_extractor_tech.h"
+
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace {
+
+using GDSPair = std::pair<uint32_t, uint32_t>;
+using Contact = kpex::tech::ProcessStackInfo::Contact;
+using RExtractorTech = kpex::klayout::RExtractorTech;
+
+// NOTE: same as TechInfo.internal_substrate_layer_name
+const std::string internalSubstrateLayerName = "VSUBS";
+
+GDSPair gdsPair(const kpex::tech::GDSPair &p) {
+    return { p.layer(), p.datatype() };
+}
+
+// NOTE: the lookups mirror the ones of TechInfo (python dicts, the last entry of a name wins)
+class RExtractorTechBuilder {
+public:
+    RExtractorTechBuilder(const kpex::tech::Technology &tech,
+                          const kpex::tech::ProcessStackInfo &psi,
+                          const kpex::tech::ResistanceInfo &ri)
+        : m_tech(tech)
+    {
+        for (const auto &cl : tech.lvs_computed_layers()) {
+            const GDSPair p = gdsPair(cl.layer_info().drw_gds_pair());
+            m_canonicalLayerNameByGdsPair[p] = cl.original_layer_name();
+            m_gdsPairForComputedLayerName[cl.layer_info().name()] = p;
+        }
+        for (const auto &l : tech.layers()) {
+            m_gdsPairForLayerName[l.name()] = gdsPair(l.drw_gds_pair());
+        }
+        
+        for (const auto &lr : ri.layers()) {
+            m_layerResistanceByLayerName[lr.layer_name()] = lr.resistance();
+        }
+        for (const auto &cr : ri.contacts()) {
+            m_contactResistanceByDeviceLayerName[cr.device_layer_name()] = cr.resistance();
+        }
+        for (const auto &vr : ri.vias()) {
+            m_viaResistanceByLayerName[vr.via_name()] = vr.resistance();
+        }
+        
+        for (const auto &li : psi.layers()) {
+            switch (li.parameters_case()) {
+                case kpex::tech::ProcessStackInfo::LayerInfo::kNwellLayer:
+                    m_contactByContactLvsLayerName[li.nwell_layer().contact_above().name()] =
+                        &li.nwell_layer().contact_above();
+                    break;
+                case kpex::tech::ProcessStackInfo::LayerInfo::kDiffusionLayer:
+                    m_contactByContactLvsLayerName[li.diffusion_layer().contact_above().name()] =
+                        &li.diffusion_layer().contact_above();
+                    break;
+                case kpex::tech::ProcessStackInfo::LayerInfo::kMetalLayer: {
+                    const Contact &c = li.metal_layer().contact_above();
+                    m_contactByContactLvsLayerName[c.name()] = &c;
+                    if (li.metal_layer().has_contact_above()) {
+                        m_bottomAndTopLayerNameByViaName[c.name()] = { c.layer_below(), c.metal_above() };
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+    
+    void build(RExtractorTech *rex) const {
+        using Kind = kpex::tech::ComputedLayerInfo;
+        using Purpose = kpex::tech::LayerInfo;
+        
+        rex->Clear();
+        
+        for (const auto &cl : m_tech.lvs_computed_layers()) {
+            if (cl.kind() == Kind::KIND_PIN || cl.kind() == Kind::KIND_LABEL) {
+                continue;
+            }
+            
+            const std::string &lvsLayerName = cl.layer_info().name();
+            const std::string &canonicalLayerName =
+                m_canonicalLayerNameByGdsPair.at(gdsPair(cl.layer_info().drw_gds_pair()));
+            
+            switch (cl.layer_info().purpose()) {
+                case Purpose::PURPOSE_N_IMPLANT:
+                case Purpose::PURPOSE_P_IMPLANT: {
+                    // device terminals, only pin end-points without wires (see RExtractor)
+                    RExtractorTech::Conductor *cond = rex->add_conductors();
+                    cond->mutable_layer()->set_canonical_layer_name(canonicalLayerName);
+                    cond->mutable_layer()->set_lvs_layer_name(lvsLayerName);
+                    cond->set_substrate(true);
+                    cond->set_resistance(0.0);
+                    break;
+                }
+                    
+                case Purpose::PURPOSE_METAL: {
+                    auto r = find(m_layerResistanceByLayerName, canonicalLayerName);
+                    if (!r) {
+                        break;
+                    }
+                    RExtractorTech::Conductor *cond = rex->add_conductors();
+                    cond->mutable_layer()->set_canonical_layer_name(canonicalLayerName);
+                    cond->mutable_layer()->set_lvs_layer_name(lvsLayerName);
+                    cond->set_substrate(canonicalLayerName == internalSubstrateLayerName);
+                    cond->set_resistance(*r / 1000.0);  // mΩ/square -> Ω/square
+                    break;
+                }
+                    
+                case Purpose::PURPOSE_CONTACT: {
+                    auto contact = find(m_contactByContactLvsLayerName, lvsLayerName);
+                    if (!contact) {
+                        break;
+                    }
+                    auto r = find(m_contactResistanceByDeviceLayerName, (*contact)->layer_below());
+                    if (!r) {
+                        break;
+                    }
+                    addVia(rex, lvsLayerName, canonicalLayerName,
+                           (*contact)->layer_below(), (*contact)->metal_above(),
+                           *r, **contact);
+                    break;
+                }
+                    
+                case Purpose::PURPOSE_VIA: {
+                    auto r = find(m_viaResistanceByLayerName, canonicalLayerName);
+                    auto botTop = find(m_bottomAndTopLayerNameByViaName, lvsLayerName);
+                    auto contact = find(m_contactByContactLvsLayerName, lvsLayerName);
+                    if (!r || !botTop || !contact) {
+                        break;
+                    }
+                    addVia(rex, lvsLayerName, canonicalLayerName,
+                           botTop->first, botTop->second,
+                           *r, **contact);
+                    break;
+                }
+                    
+                default:
+                    // wells, taps, ... are not part of the R extraction
+                    break;
+            }
+        }
+    }
+    
+private:
+    template <typename Map>
+    static std::optional<typename Map::mapped_type> find(const Map &m, const typename Map::key_type &key) {
+        auto it = m.find(key);
+        if (it == m.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+    
+    std::optional<GDSPair> gdsPairForName(const std::string &name) const {
+        auto p = find(m_gdsPairForComputedLayerName, name);
+        return p ? p : find(m_gdsPairForLayerName, name);
+    }
+    
+    void addVia(RExtractorTech *rex,
+                const std::string &lvsLayerName,
+                const std::string &canonicalLayerName,
+                const std::string &bottom,
+                const std::string &top,
+                double milliohmPerCnt,
+                const Contact &contact) const
+    {
+        // NOTE: layers without GDS pair can't be bound at runtime
+        auto bottomPair = gdsPairForName(bottom);
+        auto topPair = gdsPairForName(top);
+        if (!bottomPair || !topPair) {
+            return;
+        }
+        
+        RExtractorTech::Via *via = rex->add_vias();
+        via->mutable_layer()->set_canonical_layer_name(canonicalLayerName);
+        via->mutable_layer()->set_lvs_layer_name(lvsLayerName);
+        
+        // NOTE: the names as referenced by the contact, resolved to a GDS pair at runtime
+        via->mutable_bottom_conductor()->set_lvs_layer_name(bottom);
+        via->mutable_bottom_conductor()->set_canonical_layer_name(find(m_canonicalLayerNameByGdsPair, *bottomPair)
+                                                                  .value_or(std::string()));
+        via->mutable_top_conductor()->set_lvs_layer_name(top);
+        via->mutable_top_conductor()->set_canonical_layer_name(find(m_canonicalLayerNameByGdsPair, *topPair)
+                                                               .value_or(std::string()));
+        
+        // mΩ/CNT -> Ω/µm^2
+        via->set_resistance(milliohmPerCnt / 1000.0 * (contact.width() * contact.width()));
+    }
+    
+    const kpex::tech::Technology &m_tech;
+    
+    std::map<GDSPair, std::string> m_canonicalLayerNameByGdsPair;
+    std::map<std::string, GDSPair> m_gdsPairForComputedLayerName;
+    std::map<std::string, GDSPair> m_gdsPairForLayerName;
+    
+    std::map<std::string, double> m_layerResistanceByLayerName;
+    std::map<std::string, double> m_contactResistanceByDeviceLayerName;
+    std::map<std::string, double> m_viaResistanceByLayerName;
+    
+    std::map<std::string, const Contact*> m_contactByContactLvsLayerName;
+    std::map<std::string, std::pair<std::string, std::string>> m_bottomAndTopLayerNameByViaName;
+};
+
+}
+
+void resolveRExtractorTechs(kpex::tech::Technology *tech) {
+    RExtractorTechBuilder builder(*tech, tech->process_stack(), tech->process_parasitics().resistance());
+    builder.build(tech->mutable_process_parasitics()->mutable_resistance()->mutable_r_extractor_tech());
+}
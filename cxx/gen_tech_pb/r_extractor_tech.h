@@ -0,0 +1,33 @@
+/*
+ * --------------------------------------------------------------------------------
+ * SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+ * Johannes Kepler University, Institute for Integrated Circuits.
+ *
+ * This file is part of KPEX 
+ * (see https://github.com/iic-jku/klayout-pex).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * --------------------------------------------------------------------------------
+ */
+#ifndef __R_EXTRACTOR_TECH_H__
+#define __R_EXTRACTOR_TECH_H__
+
+#include "kpex/tech/tech.pb.h"
+
+// Precomputes ResistanceInfo.r_extractor_tech (KLayout R extractor conductors and vias
+// per LVS computed layer) for the nominal technology and all style variants
+void resolveRExtractorTechs(kpex::tech::Technology *tech);
+
+#endif
@@ -0,0 +1,354 @@
+/*
+ * --------------------------------------------------------------------------------
+ * SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+ * Johannes Kepler University, Institute for Integrated Circuits.
+ *
+ * This file is part of KPEX 
+ * (see https://github.com/iic-jku/klayout-pex).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * --------------------------------------------------------------------------------
+ */
+#include "resolved_stack.h"
+
+#include <map>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using LayerInfo = kpex::tech::ProcessStackInfo::LayerInfo;
+using LayerType = kpex::tech::ProcessStackInfo::LayerType;
+using ResolvedStack = kpex::tech::ProcessStackInfo::ResolvedStack;
+
+// NOTE: height of the simple dielectric above the top metal,
+//       same assumption as the one made by TechInfo.simple_dielectric_above_metal before
+constexpr double kAirHeight = 5.0;
+
+void fail(const std::string &message) {
+    throw std::runtime_error("Invalid process stack: " + message);
+}
+
+const std::string &referenceOf(const LayerInfo &li) {
+    static const std::string none;
+    switch (li.parameters_case()) {
+        case LayerInfo::kSubstrateLayer:           return li.substrate_layer().reference();
+        case LayerInfo::kNwellLayer:               return li.nwell_layer().reference();
+        case LayerInfo::kDiffusionLayer:           return li.diffusion_layer().reference();
+        case LayerInfo::kSimpleDielectricLayer:    return li.simple_dielectric_layer().reference();
+        case LayerInfo::kConformalDielectricLayer: return li.conformal_dielectric_layer().reference();
+        case LayerInfo::kSidewallDielectricLayer:  return li.sidewall_dielectric_layer().reference();
+        default:                                   return none;
+    }
+}
+
+bool isSidewallLike(const LayerInfo &li) {
+    return li.layer_type() == kpex::tech::ProcessStackInfo::LAYER_TYPE_SIDEWALL_DIELECTRIC
+        || li.layer_type() == kpex::tech::ProcessStackInfo::LAYER_TYPE_CONFORMAL_DIELECTRIC;
+}
+
+bool isMetal(const LayerInfo &li) {
+    return li.layer_type() == kpex::tech::ProcessStackInfo::LAYER_TYPE_METAL;
+}
+
+class Resolver {
+public:
+    explicit Resolver(const kpex::tech::ProcessStackInfo &psi)
+        : m_psi(psi)
+    {
+        for (int i = 0; i < psi.layers_size(); ++i) {
+            const LayerInfo &li = psi.layers(i);
+            // NOTE: names are not unique (e.g. the same dielectric above several metals),
+            //       references always point to the first layer of a name
+            m_firstIndexOfName.emplace(li.name(), i);
+            if (isMetal(li)) {
+                m_metalIndices.push_back(i);
+            }
+        }
+    }
+
+    void validate() const {
+        int substrates = 0;
+        int fieldOxides = 0;
+        
+        for (const LayerInfo &li : m_psi.layers()) {
+            if (li.name().empty()) {
+                fail("layer without name");
+            }
+            if (li.parameters_case() == LayerInfo::PARAMETERS_NOT_SET) {
+                fail("layer '" + li.name() + "' has no parameters");
+            }
+            
+            const std::string &ref = referenceOf(li);
+            if (!ref.empty() && !m_firstIndexOfName.contains(ref)) {
+                fail("layer '" + li.name() + "' references unknown layer '" + ref + "'");
+            }
+            
+            switch (li.layer_type()) {
+                case kpex::tech::ProcessStackInfo::LAYER_TYPE_SUBSTRATE:
+                    ++substrates;
+                    break;
+                case kpex::tech::ProcessStackInfo::LAYER_TYPE_FIELD_OXIDE:
+                    ++fieldOxides;
+                    break;
+                case kpex::tech::ProcessStackInfo::LAYER_TYPE_METAL:
+                    if (li.metal_layer().thickness() <= 0.0) {
+                        fail("metal '" + li.name() + "' has no thickness");
+                    }
+                    break;
+                case kpex::tech::ProcessStackInfo::LAYER_TYPE_SIDEWALL_DIELECTRIC:
+                case kpex::tech::ProcessStackInfo::LAYER_TYPE_CONFORMAL_DIELECTRIC:
+                    (void) sidewallRoot(li);  // fails if the chain does not start at a metal
+                    break;
+                default:
+                    break;
+            }
+        }
+        
+        if (substrates != 1) {
+            fail("expected exactly one substrate layer, got " + std::to_string(substrates));
+        }
+        if (fieldOxides != 1) {
+            fail("expected exactly one field oxide layer, got " + std::to_string(fieldOxides));
+        }
+        if (m_metalIndices.empty()) {
+            fail("no metal layers");
+        }
+        
+        // at most one sidewall / conformal dielectric per layer,
+        // otherwise the shells around a metal are ambiguous
+        std::set<std::string> wrapped;
+        for (const LayerInfo &li : m_psi.layers()) {
+            if (isSidewallLike(li) && !wrapped.insert(referenceOf(li)).second) {
+                fail("multiple sidewall dielectric layers for '" + referenceOf(li) + "'");
+            }
+        }
+        
+        // metals are ordered bottom up
+        for (size_t i = 1; i < m_metalIndices.size(); ++i) {
+            const LayerInfo &below = m_psi.layers(m_metalIndices[i - 1]);
+            const LayerInfo &above = m_psi.layers(m_metalIndices[i]);
+            if (above.metal_layer().z() < below.metal_layer().z()) {
+                fail("metal '" + above.name() + "' (z=" + std::to_string(above.metal_layer().z()) + ") "
+                     "is listed above metal '" + below.name() + "' "
+                     "(z=" + std::to_string(below.metal_layer().z()) + ")");
+            }
+        }
+        
+        for (const LayerInfo &li : m_psi.layers()) {
+            const kpex::tech::ProcessStackInfo::Contact *contact = nullptr;
+            switch (li.parameters_case()) {
+                case LayerInfo::kNwellLayer:     contact = &li.nwell_layer().contact_above(); break;
+                case LayerInfo::kDiffusionLayer: contact = &li.diffusion_layer().contact_above(); break;
+                case LayerInfo::kMetalLayer:     contact = &li.metal_layer().contact_above(); break;
+                default: break;
+            }
+            // NOTE: layer_below / metal_above are LVS layer names, not stack layer names
+            if (!contact || contact->name().empty()) {
+                continue;
+            }
+            if (contact->thickness() <= 0.0) {
+                fail("contact '" + contact->name() + "' above '" + li.name() + "' has no thickness");
+            }
+        }
+    }
+    
+    void resolve(ResolvedStack *rs) const {
+        rs->Clear();
+        
+        std::map<std::string, const ResolvedStack::MetalNeighbours *> metalByName;
+        for (size_t m = 0; m < m_metalIndices.size(); ++m) {
+            ResolvedStack::MetalNeighbours *mn = rs->add_metals();
+            resolveMetal(m, mn);
+            metalByName.emplace(mn->name(), mn);
+        }
+        
+        const double firstMetalZ = m_psi.layers(m_metalIndices.front()).metal_layer().z();
+        
+        for (int i = 0; i < m_psi.layers_size(); ++i) {
+            const LayerInfo &li = m_psi.layers(i);
+            ResolvedStack::Interval *iv = rs->add_intervals();
+            iv->set_name(li.name());
+            iv->set_layer_type(li.layer_type());
+            
+            switch (li.parameters_case()) {
+                case LayerInfo::kSubstrateLayer: {
+                    const auto &sl = li.substrate_layer();
+                    iv->set_z_bottom(0.0 - sl.height() - sl.thickness());
+                    iv->set_z_top(0.0 - sl.height());
+                    break;
+                }
+                case LayerInfo::kNwellLayer:
+                    iv->set_z_bottom(0.0);
+                    iv->set_z_top(li.nwell_layer().z());
+                    break;
+                case LayerInfo::kDiffusionLayer:
+                    iv->set_z_bottom(0.0);
+                    iv->set_z_top(li.diffusion_layer().z());
+                    break;
+                case LayerInfo::kFieldOxideLayer:
+                    // field oxide goes from substrate/diff/well up to below the gate-poly
+                    iv->set_z_bottom(0.0);
+                    iv->set_z_top(firstMetalZ);
+                    break;
+                case LayerInfo::kMetalLayer: {
+                    const auto &ml = li.metal_layer();
+                    iv->set_z_bottom(ml.z());
+                    iv->set_z_top(ml.z() + ml.thickness());
+                    break;
+                }
+                case LayerInfo::kSidewallDielectricLayer:
+                case LayerInfo::kConformalDielectricLayer: {
+                    const LayerInfo &root = sidewallRoot(li);
+                    const auto *mn = metalByName.at(root.name());
+                    iv->set_z_bottom(root.metal_layer().z());
+                    iv->set_z_top(root.metal_layer().z());
+                    for (const auto &shell : mn->sidewall_shells()) {
+                        if (shell.name() == li.name()) {
+                            iv->set_z_top(root.metal_layer().z() + shell.height());
+                            break;
+                        }
+                    }
+                    break;
+                }
+                case LayerInfo::kSimpleDielectricLayer: {
+                    std::optional<double> zBelow = metalZ(i, -1);
+                    std::optional<double> zAbove = metalZ(i, +1);
+                    iv->set_z_bottom(zBelow.value_or(0.0));
+                    iv->set_z_top(zAbove.value_or(iv->z_bottom() + kAirHeight));
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+    
+private:
+    // follows the references of a sidewall / conformal dielectric down to the metal it is wrapped around
+    const LayerInfo &sidewallRoot(const LayerInfo &li) const {
+        const LayerInfo *current = &li;
+        for (int hops = 0; hops <= m_psi.layers_size(); ++hops) {
+            if (isMetal(*current)) {
+                return *current;
+            }
+            if (!isSidewallLike(*current)) {
+                break;
+            }
+            auto it = m_firstIndexOfName.find(referenceOf(*current));
+            if (it == m_firstIndexOfName.end()) {
+                break;
+            }
+            current = &m_psi.layers(it->second);
+        }
+        fail("sidewall dielectric '" + li.name() + "' is not wrapped around a metal");
+        return li;  // unreachable
+    }
+    
+    // z of the nearest metal below (direction -1) or above (+1) the layer at index
+    std::optional<double> metalZ(int index, int direction) const {
+        for (int i = index + direction; i >= 0 && i < m_psi.layers_size(); i += direction) {
+            if (isMetal(m_psi.layers(i))) {
+                return m_psi.layers(i).metal_layer().z();
+            }
+        }
+        return std::nullopt;
+    }
+    
+    void resolveMetal(size_t m, ResolvedStack::MetalNeighbours *mn) const {
+        const int index = m_metalIndices[m];
+        const LayerInfo &li = m_psi.layers(index);
+        const auto &ml = li.metal_layer();
+        
+        mn->set_name(li.name());
+        if (m > 0) {
+            mn->set_metal_below(m_psi.layers(m_metalIndices[m - 1]).name());
+        }
+        if (m + 1 < m_metalIndices.size()) {
+            mn->set_metal_above(m_psi.layers(m_metalIndices[m + 1]).name());
+        }
+        
+        // shells, innermost first
+        double height = 0.0;
+        std::string wrapped = li.name();
+        while (true) {
+            const LayerInfo *shell = nullptr;
+            for (const LayerInfo &candidate : m_psi.layers()) {
+                if (isSidewallLike(candidate) && referenceOf(candidate) == wrapped) {
+                    shell = &candidate;
+                    break;
+                }
+            }
+            if (!shell) {
+                break;
+            }
+            
+            ResolvedStack::SidewallShell *s = mn->add_sidewall_shells();
+            s->set_name(shell->name());
+            s->set_layer_type(shell->layer_type());
+            if (shell->has_sidewall_dielectric_layer()) {
+                const auto &sd = shell->sidewall_dielectric_layer();
+                // NOTE: a sidewall dielectric without height_above_metal covers the metal sidewall
+                height += (sd.height_above_metal() != 0.0) ? sd.height_above_metal() : ml.thickness();
+                s->set_dielectric_k(sd.dielectric_k());
+                s->set_width_outside(sd.width_outside_sidewall());
+            } else {
+                const auto &cd = shell->conformal_dielectric_layer();
+                height += ml.thickness() + cd.thickness_over_metal();
+                s->set_dielectric_k(cd.dielectric_k());
+                s->set_width_outside(cd.thickness_sidewall());
+                s->set_thickness_where_no_metal(cd.thickness_where_no_metal());
+            }
+            s->set_height(height);
+            wrapped = shell->name();
+        }
+        
+        // the first simple dielectric listed between this and the next metal
+        for (int i = index + 1; i < m_psi.layers_size(); ++i) {
+            const LayerInfo &above = m_psi.layers(i);
+            if (isMetal(above)) {
+                break;
+            }
+            if (above.layer_type() == kpex::tech::ProcessStackInfo::LAYER_TYPE_SIMPLE_DIELECTRIC) {
+                mn->set_simple_dielectric_above(above.name());
+                break;
+            }
+        }
+        std::optional<double> zAbove = metalZ(index, +1);
+        mn->set_simple_dielectric_height(zAbove ? *zAbove - ml.z() : kAirHeight);
+    }
+    
+    const kpex::tech::ProcessStackInfo &m_psi;
+    std::map<std::string, int> m_firstIndexOfName;
+    std::vector<int> m_metalIndices;
+};
+
+}
+
+void resolveProcessStack(kpex::tech::ProcessStackInfo *psi) {
+    Resolver resolver(*psi);
+    resolver.validate();
+    
+    kpex::tech::ProcessStackInfo::ResolvedStack resolved;
+    resolver.resolve(&resolved);
+    *psi->mutable_resolved() = std::move(resolved);
+}
+
+void resolveProcessStacks(kpex::tech::Technology *tech) {
+    resolveProcessStack(tech->mutable_process_stack());
+}
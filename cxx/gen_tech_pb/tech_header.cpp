@@ -0,0 +1,342 @@
+/*
+ * --------------------------------------------------------------------------------
+ * SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+ * Johannes Kepler University, Institute for Integrated Circuits.
+ *
+ * This file is part of KPEX 
+ * (see https://github.com/iic-jku/klayout-pex).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * --------------------------------------------------------------------------------
+ */
+#include "tech_header.h"
+
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// shortest representation which parses back to the identical value
+template <typename T>
+std::string number(T value) {
+    char buf[64];
+    auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), value);
+    std::string s(buf, end);
+    if (s.find_first_of(".en") == std::string::npos) {
+        s += ".0";
+    }
+    return s;
+}
+
+std::string dbl(double value) {
+    return number(value);
+}
+
+// NOTE: capacitances are float in the tables (see tech_tables.h)
+std::string flt(double value) {
+    return number(static_cast<float>(value)) + "f";
+}
+
+std::string str(std::string_view s) {
+    std::string out = "\"";
+    for (char c : s) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:   out += c; break;
+        }
+    }
+    out += "\"";
+    return out;
+}
+
+std::string identifier(const std::string &name) {
+    std::string id;
+    for (char c : name) {
+        id += (std::isalnum(static_cast<unsigned char>(c)) ? c : '_');
+    }
+    if (id.empty() || std::isdigit(static_cast<unsigned char>(id[0]))) {
+        id = "_" + id;
+    }
+    return id;
+}
+
+std::string gdsPair(bool has, const kpex::tech::GDSPair &pair)
+{
+    if (!has) {
+        return "-1, -1";
+    }
+    return std::to_string(pair.layer()) + ", " + std::to_string(pair.datatype());
+}
+
+class TableWriter {
+public:
+    TableWriter(std::ostream &os, const std::string &name, const std::string &rowType)
+        : m_os(os), m_name(name), m_rowType(rowType)
+    {}
+    
+    void row(const std::string &r) {
+        m_rows.push_back(r);
+    }
+    
+    ~TableWriter() {
+        if (m_rows.empty()) {
+            m_os << "inline constexpr std::array<kpex::tables::" << m_rowType << ", 0> "
+                 << m_name << " {};" << std::endl << std::endl;
+            return;
+        }
+        m_os << "inline constexpr auto " << m_name
+             << " = std::to_array<kpex::tables::" << m_rowType << ">({" << std::endl;
+        for (const auto &r : m_rows) {
+            m_os << "    " << r << "," << std::endl;
+        }
+        m_os << "});" << std::endl << std::endl;
+    }
+    
+private:
+    std::ostream &m_os;
+    std::string m_name;
+    std::string m_rowType;
+    std::vector<std::string> m_rows;
+};
+
+void writeLayers(std::ostream &os, const kpex::tech::Technology &tech) {
+    TableWriter t(os, "layers", "Layer");
+    for (const auto &l : tech.layers()) {
+        std::ostringstream r;
+        r << "{" << l.purpose() << " /* " << kpex::tech::LayerInfo_Purpose_Name(l.purpose()) << " */, "
+          << str(l.name()) << ", "
+          << gdsPair(true, l.drw_gds_pair()) << ", "
+          << gdsPair(l.has_pin_gds_pair(), l.pin_gds_pair()) << ", "
+          << gdsPair(l.has_label_gds_pair(), l.label_gds_pair()) << ", "
+          << str(l.description()) << "}";
+        t.row(r.str());
+    }
+}
+
+void writeComputedLayers(std::ostream &os, const kpex::tech::Technology &tech) {
+    TableWriter t(os, "computedLayers", "ComputedLayer");
+    for (const auto &cl : tech.lvs_computed_layers()) {
+        const auto &l = cl.layer_info();
+        std::ostringstream r;
+        r << "{" << l.purpose() << " /* " << kpex::tech::LayerInfo_Purpose_Name(l.purpose()) << " */, "
+          << cl.kind() << " /* " << kpex::tech::ComputedLayerInfo_Kind_Name(cl.kind()) << " */, "
+          << str(l.name()) << ", "
+          << l.drw_gds_pair().layer() << ", " << l.drw_gds_pair().datatype() << ", "
+          << str(cl.original_layer_name()) << ", "
+          << str(l.description()) << "}";
+        t.row(r.str());
+    }
+}
+
+void writeProcessStack(std::ostream &os, const kpex::tech::ProcessStackInfo &psi) {
+    using LayerInfo = kpex::tech::ProcessStackInfo::LayerInfo;
+    
+    std::vector<std::pair<std::string, const kpex::tech::ProcessStackInfo::Contact *>> contacts;
+    
+    {
+        TableWriter t(os, "processStack", "StackLayer");
+        for (const auto &li : psi.layers()) {
+            std::ostringstream r;
+            const kpex::tech::ProcessStackInfo::Contact *contact = nullptr;
+            switch (li.parameters_case()) {
+                case LayerInfo::kSubstrateLayer: {
+                    const auto &l = li.substrate_layer();
+                    r << "kpex::tables::substrateLayer(" << str(li.name()) << ", "
+                      << dbl(l.height()) << ", " << dbl(l.thickness()) << ", " << str(l.reference()) << ")";
+                    break;
+                }
+                case LayerInfo::kNwellLayer: {
+                    const auto &l = li.nwell_layer();
+                    r << "kpex::tables::nwellLayer(" << str(li.name()) << ", "
+                      << dbl(l.z()) << ", " << str(l.reference()) << ")";
+                    if (l.has_contact_above()) contact = &l.contact_above();
+                    break;
+                }
+                case LayerInfo::kDiffusionLayer: {
+                    const auto &l = li.diffusion_layer();
+                    r << "kpex::tables::diffusionLayer(" << str(li.name()) << ", "
+                      << dbl(l.z()) << ", " << str(l.reference()) << ")";
+                    if (l.has_contact_above()) contact = &l.contact_above();
+                    break;
+                }
+                case LayerInfo::kFieldOxideLayer: {
+                    const auto &l = li.field_oxide_layer();
+                    r << "kpex::tables::fieldOxideLayer(" << str(li.name()) << ", "
+                      << dbl(l.dielectric_k()) << ")";
+                    break;
+                }
+                case LayerInfo::kMetalLayer: {
+                    const auto &l = li.metal_layer();
+                    r << "kpex::tables::metalLayer(" << str(li.name()) << ", "
+                      << dbl(l.z()) << ", " << dbl(l.thickness()) << ")";
+                    if (l.has_contact_above()) contact = &l.contact_above();
+                    break;
+                }
+                case LayerInfo::kSidewallDielectricLayer: {
+                    const auto &l = li.sidewall_dielectric_layer();
+                    r << "kpex::tables::sidewallDielectric(" << str(li.name()) << ", "
+                      << dbl(l.dielectric_k()) << ", "
+                      << dbl(l.height_above_metal()) << ", " << dbl(l.width_outside_sidewall()) << ", "
+                      << str(l.reference()) << ")";
+                    break;
+                }
+                case LayerInfo::kSimpleDielectricLayer: {
+                    const auto &l = li.simple_dielectric_layer();
+                    r << "kpex::tables::simpleDielectric(" << str(li.name()) << ", "
+                      << dbl(l.dielectric_k()) << ", " << str(l.reference()) << ")";
+                    break;
+                }
+                case LayerInfo::kConformalDielectricLayer: {
+                    const auto &l = li.conformal_dielectric_layer();
+                    r << "kpex::tables::conformalDielectric(" << str(li.name()) << ", "
+                      << dbl(l.dielectric_k()) << ", "
+                      << dbl(l.thickness_over_metal()) << ", " << dbl(l.thickness_where_no_metal()) << ", "
+                      << dbl(l.thickness_sidewall()) << ", "
+                      << str(l.reference()) << ")";
+                    break;
+                }
+                case LayerInfo::PARAMETERS_NOT_SET:
+                    std::cerr << "WARNING: process stack layer '" << li.name() << "' has no parameters, "
+                              << "skipping it in the generated header" << std::endl;
+                    continue;
+            }
+            t.row(r.str());
+            if (contact) {
+                contacts.emplace_back(li.name(), contact);
+            }
+        }
+    }
+    
+    {
+        TableWriter t(os, "contacts", "Contact");
+        for (const auto &[stack_layer, c] : contacts) {
+            std::ostringstream r;
+            r << "{" << str(stack_layer) << ", "
+              << str(c->name()) << ", " << str(c->layer_below()) << ", " << str(c->metal_above()) << ", "
+              << dbl(c->thickness()) << ", " << dbl(c->width()) << ", "
+              << dbl(c->spacing()) << ", " << dbl(c->border()) << "}";
+            t.row(r.str());
+        }
+    }
+    
+    os << "static_assert(kpex::tables::isConsistentStack(processStack, contacts));" << std::endl << std::endl;
+}
+
+void writeResistances(std::ostream &os, const kpex::tech::ResistanceInfo &ri) {
+    {
+        TableWriter t(os, "layerResistances", "LayerResistance");
+        for (const auto &lr : ri.layers()) {
+            t.row("{" + str(lr.layer_name()) + ", " + dbl(lr.resistance()) + ", "
+                  + dbl(lr.corner_adjustment_fraction()) + "}");
+        }
+    }
+    {
+        TableWriter t(os, "contactResistances", "ContactResistance");
+        for (const auto &cr : ri.contacts()) {
+            t.row("{" + str(cr.contact_name()) + ", " + str(cr.device_layer_name()) + ", "
+                  + str(cr.layer_above()) + ", " + dbl(cr.resistance()) + "}");
+        }
+    }
+    {
+        TableWriter t(os, "viaResistances", "ViaResistance");
+        for (const auto &vr : ri.vias()) {
+            t.row("{" + str(vr.via_name()) + ", " + dbl(vr.resistance()) + "}");
+        }
+    }
+}
+
+void writeCapacitances(std::ostream &os, const kpex::tech::CapacitanceInfo &ci) {
+    {
+        TableWriter t(os, "substrateCaps", "SubstrateCap");
+        for (const auto &sc : ci.substrates()) {
+            t.row("{" + str(sc.layer_name()) + ", "
+                  + flt(sc.area_capacitance()) + ", " + flt(sc.perimeter_capacitance()) + "}");
+        }
+    }
+    {
+        TableWriter t(os, "overlapCaps", "OverlapCap");
+        for (const auto &oc : ci.overlaps()) {
+            t.row("{" + str(oc.top_layer_name()) + ", " + str(oc.bottom_layer_name()) + ", "
+                  + flt(oc.capacitance()) + "}");
+        }
+    }
+    {
+        TableWriter t(os, "sidewallCaps", "SidewallCap");
+        for (const auto &swc : ci.sidewalls()) {
+            t.row("{" + str(swc.layer_name()) + ", " + flt(swc.capacitance()) + ", " + flt(swc.offset()) + "}");
+        }
+    }
+    {
+        TableWriter t(os, "sidewallOverlapCaps", "SidewallOverlapCap");
+        for (const auto &soc : ci.sideoverlaps()) {
+            t.row("{" + str(soc.in_layer_name()) + ", " + str(soc.out_layer_name()) + ", "
+                  + flt(soc.capacitance()) + "}");
+        }
+    }
+}
+
+}
+
+void writeTechHeader(const kpex::tech::Technology &tech,
+                     const std::string &outputPath)
+{
+    std::cout << "Writing technology C++ header to file '" << outputPath << "'." << std::endl;
+    
+    const std::string id = identifier(tech.name());
+    std::string guard = "__KPEX_PDK_" + id + "_TECH_H__";
+    for (auto &c : guard) {
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    
+    std::ofstream os(outputPath, std::ios::out | std::ios::binary);
+    
+    os << "//" << std::endl
+       << "// Generated by gen_tech_pb from the technology '" << tech.name() << "', do not edit." << std::endl
+       << "//" << std::endl
+       << "// NOTE: contains the nominal technology only, style variants are" << std::endl
+       << "//       available in the JSON technology file." << std::endl
+       << "//" << std::endl
+       << std::endl
+       << "#ifndef " << guard << std::endl
+       << "#define " << guard << std::endl
+       << std::endl
+       << "#include \"tech_tables.h\"" << std::endl
+       << std::endl
+       << "namespace kpex::pdk::" << id << " {" << std::endl
+       << std::endl
+       << "inline constexpr std::string_view name = " << str(tech.name()) << ";" << std::endl
+       << std::endl;
+    
+    writeLayers(os, tech);
+    writeComputedLayers(os, tech);
+    writeProcessStack(os, tech.process_stack());
+    
+    const auto &pp = tech.process_parasitics();
+    os << "inline constexpr double sideHalo = " << dbl(pp.side_halo()) << ";" << std::endl << std::endl;
+    writeResistances(os, pp.resistance());
+    writeCapacitances(os, pp.capacitance());
+    
+    os << "}" << std::endl
+       << std::endl
+       << "#endif" << std::endl;
+}
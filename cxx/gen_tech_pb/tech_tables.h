@@ -0,0 +1,300 @@
+/*
+ * --------------------------------------------------------------------------------
+ * SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+ * Johannes Kepler University, Institute for Integrated Circuits.
+ *
+ * This file is part of KPEX 
+ * (see https://github.com/iic-jku/klayout-pex).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * --------------------------------------------------------------------------------
+ */
+#ifndef __TECH_TABLES_H__
+#define __TECH_TABLES_H__
+
+//
+// Plain constexpr row types for PDK technology definitions.
+//
+// NOTE: this header must not depend on protobuf,
+//       it is included by the hand written PDK tables (cxx/gen_tech_pb/pdk)
+//       as well as by the headers generated by gen_tech_pb,
+//       so native engines can link a PDK without any runtime parsing.
+//
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+namespace kpex::tables {
+
+// NOTE: purpose and kind hold the numeric values of
+//       kpex.tech.LayerInfo.Purpose and kpex.tech.ComputedLayerInfo.Kind
+using Purpose = int32_t;
+using ComputedLayerKind = int32_t;
+
+struct Layer {
+    Purpose purpose;
+    std::string_view name;
+    uint32_t drw_gds_layer;
+    uint32_t drw_gds_datatype;
+    int64_t pin_gds_layer;      // -1 if not available
+    int64_t pin_gds_datatype;   // -1 if not available
+    int64_t label_gds_layer;    // -1 if not available
+    int64_t label_gds_datatype; // -1 if not available
+    std::string_view description;
+};
+
+struct ComputedLayer {
+    Purpose purpose;
+    ComputedLayerKind kind;
+    std::string_view name;
+    uint32_t gds_layer;
+    uint32_t gds_datatype;
+    std::string_view original_layer_name;
+    std::string_view description;
+};
+
+//-------------------------------------------------------------------------
+
+enum class StackLayerKind {
+    Substrate,
+    NWell,
+    Diffusion,
+    FieldOxide,
+    Metal,
+    SidewallDielectric,
+    SimpleDielectric,
+    ConformalDielectric
+};
+
+// One entry of the process stack, the fields not used by the kind are 0.
+// NOTE: the stack is an ordered table (not keyed by name),
+//       as some dielectrics legitimately occur more than once
+struct StackLayer {
+    StackLayerKind kind;
+    std::string_view name;
+    double height = 0.0;                   // substrate only
+    double z = 0.0;
+    double thickness = 0.0;
+    double dielectric_k = 0.0;
+    double height_above_metal = 0.0;
+    double width_outside_sidewall = 0.0;
+    double thickness_over_metal = 0.0;
+    double thickness_where_no_metal = 0.0;
+    double thickness_sidewall = 0.0;
+    std::string_view reference = {};
+};
+
+constexpr StackLayer substrateLayer(std::string_view name,
+                                    double height,
+                                    double thickness,
+                                    std::string_view reference)
+{
+    return { .kind = StackLayerKind::Substrate, .name = name,
+             .height = height, .thickness = thickness, .reference = reference };
+}
+
+constexpr StackLayer nwellLayer(std::string_view name,
+                                double z,
+                                std::string_view reference)
+{
+    return { .kind = StackLayerKind::NWell, .name = name, .z = z, .reference = reference };
+}
+
+constexpr StackLayer diffusionLayer(std::string_view name,
+                                    double z,
+                                    std::string_view reference)
+{
+    return { .kind = StackLayerKind::Diffusion, .name = name, .z = z, .reference = reference };
+}
+
+constexpr StackLayer fieldOxideLayer(std::string_view name,
+                                     double dielectric_k)
+{
+    return { .kind = StackLayerKind::FieldOxide, .name = name, .dielectric_k = dielectric_k };
+}
+
+constexpr StackLayer metalLayer(std::string_view name,
+                                double z,
+                                double thickness)
+{
+    return { .kind = StackLayerKind::Metal, .name = name, .z = z, .thickness = thickness };
+}
+
+constexpr StackLayer sidewallDielectric(std::string_view name,
+                                        double dielectric_k,
+                                        double height_above_metal,
+                                        double width_outside_sidewall,
+                                        std::string_view reference)
+{
+    return { .kind = StackLayerKind::SidewallDielectric, .name = name,
+             .dielectric_k = dielectric_k,
+             .height_above_metal = height_above_metal,
+             .width_outside_sidewall = width_outside_sidewall,
+             .reference = reference };
+}
+
+constexpr StackLayer simpleDielectric(std::string_view name,
+                                      double dielectric_k,
+                                      std::string_view reference)
+{
+    return { .kind = StackLayerKind::SimpleDielectric, .name = name,
+             .dielectric_k = dielectric_k, .reference = reference };
+}
+
+constexpr StackLayer conformalDielectric(std::string_view name,
+                                         double dielectric_k,
+                                         double thickness_over_metal,
+                                         double thickness_where_no_metal,
+                                         double thickness_sidewall,
+                                         std::string_view reference)
+{
+    return { .kind = StackLayerKind::ConformalDielectric, .name = name,
+             .dielectric_k = dielectric_k,
+             .thickness_over_metal = thickness_over_metal,
+             .thickness_where_no_metal = thickness_where_no_metal,
+             .thickness_sidewall = thickness_sidewall,
+             .reference = reference };
+}
+
+// Contact/via above the NWell, Diffusion or Metal stack layer named stack_layer
+struct Contact {
+    std::string_view stack_layer;
+    std::string_view name = {};
+    std::string_view layer_below = {};
+    std::string_view metal_above = {};
+    double thickness = 0.0;
+    double width = 0.0;
+    double spacing = 0.0;
+    double border = 0.0;
+};
+
+//-------------------------------------------------------------------------
+
+// resistance values are in mΩ / square
+struct LayerResistance {
+    std::string_view layer_name;
+    double resistance;
+    double corner_adjustment_fraction = 0.0;  // 0 if not available
+};
+
+// resistance values are in mΩ / CNT
+struct ContactResistance {
+    std::string_view contact_name;
+    std::string_view device_layer_name;
+    std::string_view layer_above;
+    double resistance;
+};
+
+// resistance values are in mΩ / CNT
+struct ViaResistance {
+    std::string_view via_name;
+    double resistance;
+};
+
+// NOTE: capacitances are float, the add*Cap functions have always rounded
+//       the coefficients to float precision before storing them in the message
+
+struct SubstrateCap {
+    std::string_view layer_name;
+    float area_cap;
+    float perimeter_cap;
+};
+
+struct OverlapCap {
+    std::string_view top_layer;
+    std::string_view bottom_layer;
+    float cap;
+};
+
+struct SidewallCap {
+    std::string_view layer_name;
+    float cap;
+    float offset;
+};
+
+struct SidewallOverlapCap {
+    std::string_view in_layer;
+    std::string_view out_layer;
+    float cap;
+};
+
+//-------------------------------------------------------------------------
+// compile time lookups, for all tables with rows having a 'name'
+
+template <typename Row, std::size_t N>
+constexpr std::optional<std::size_t> indexOf(const std::array<Row, N> &rows,
+                                             std::string_view name)
+{
+    for (std::size_t i = 0; i < N; ++i) {
+        if (rows[i].name == name) {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
+template <typename Row, std::size_t N>
+constexpr bool contains(const std::array<Row, N> &rows,
+                        std::string_view name)
+{
+    return indexOf(rows, name).has_value();
+}
+
+// NOTE: when evaluated at compile time, an unknown name is a compile error
+template <typename Row, std::size_t N>
+constexpr const Row &byName(const std::array<Row, N> &rows,
+                            std::string_view name)
+{
+    auto idx = indexOf(rows, name);
+    if (!idx) {
+        throw std::out_of_range("unknown table entry");
+    }
+    return rows[*idx];
+}
+
+// all contacts sit above a stack layer, all stack layer references exist
+template <std::size_t NL, std::size_t NC>
+constexpr bool isConsistentStack(const std::array<StackLayer, NL> &stack,
+                                 const std::array<Contact, NC> &contacts)
+{
+    for (const auto &sl : stack) {
+        if (!sl.reference.empty() && !contains(stack, sl.reference)) {
+            return false;
+        }
+    }
+    for (const auto &c : contacts) {
+        auto idx = indexOf(stack, c.stack_layer);
+        if (!idx) {
+            return false;
+        }
+        switch (stack[*idx].kind) {
+            case StackLayerKind::NWell:
+            case StackLayerKind::Diffusion:
+            case StackLayerKind::Metal:
+                break;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+}
+
+#endif
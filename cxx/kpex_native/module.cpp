@@ -0,0 +1,294 @@
+/*
+ * --------------------------------------------------------------------------------
+ * SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+ * Johannes Kepler University, Institute for Integrated Circuits.
+ *
+ * This file is part of KPEX 
+ * (see https://github.com/iic-jku/klayout-pex).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * --------------------------------------------------------------------------------
+ */
+//
+// _kpex_native: optional native extension of klayout_pex (see klayout_pex/native/__init__.py)
+//
+// Native code exchanges messages with Python as serialized buffers (see python_buffer.h),
+// and builds geometry payloads directly from KLayout objects, without per-vertex Python work.
+//
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <google/protobuf/message.h>
+
+#include <exception>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "kpex/geometry/shapes.pb.h"
+#include "message_arena.h"
+#include "message_stats.h"
+#include "message_types.h"
+#include "polygon_string.h"
+#include "python_buffer.h"
+
+namespace {
+
+using kpex::native::PythonBuffer;
+
+// RAII for new references
+class PyRef {
+public:
+    explicit PyRef(PyObject *object) : m_object(object) {}
+    ~PyRef() { Py_XDECREF(m_object); }
+
+    PyRef(const PyRef &) = delete;
+    PyRef &operator=(const PyRef &) = delete;
+
+    PyObject *get() const { return m_object; }
+    explicit operator bool() const { return m_object != nullptr; }
+
+private:
+    PyObject *m_object;
+};
+
+// reused for all payloads, the GIL serializes the calls
+kpex::pb::MessageArena &payloadArena() {
+    static kpex::pb::MessageArena arena;
+    return arena;
+}
+
+class ArenaResetGuard {
+public:
+    ~ArenaResetGuard() { payloadArena().reset(); }
+};
+
+//-------------------------------------------------------------------------
+
+PyObject *protobufVersion(PyObject *, PyObject *) {
+    const int v = GOOGLE_PROTOBUF_VERSION;
+    return PyUnicode_FromFormat("%d.%d.%d", v / 1000000, (v / 1000) % 1000, v % 1000);
+}
+
+PyObject *messageStats(PyObject *, PyObject *args, PyObject *kwargs) {
+    static const char *keywords[] = {"type_name", "data", "max_depth", nullptr};
+    const char *typeName = nullptr;
+    PyObject *data = nullptr;
+    unsigned int maxDepth = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "sO|I", const_cast<char **>(keywords),
+                                     &typeName, &data, &maxDepth)) {
+        return nullptr;
+    }
+
+    PythonBuffer buffer(data);
+    if (!buffer.valid()) {
+        return nullptr;
+    }
+
+    try {
+        const google::protobuf::Descriptor *type = kpex::pb::findMessageType(typeName);
+        const google::protobuf::Message *prototype =
+            google::protobuf::MessageFactory::generated_factory()->GetPrototype(type);
+
+        ArenaResetGuard guard;
+        google::protobuf::Message *message = prototype->New(payloadArena().arena());
+        if (!buffer.parse(message)) {
+            return nullptr;
+        }
+
+        kpex::pb::MessageStatistics stats;
+        stats.add(*message);
+        std::ostringstream os;
+        stats.print(os, maxDepth);
+        const std::string text = os.str();
+        return PyUnicode_FromStringAndSize(text.data(), static_cast<Py_ssize_t>(text.size()));
+    } catch (const std::exception &e) {
+        PyErr_SetString(PyExc_ValueError, e.what());
+        return nullptr;
+    }
+}
+
+// returns false with a Python exception set
+bool encodePolygon(PyObject *polygon, kpex::geometry::Shape *shape) {
+    shape->set_kind(kpex::geometry::Shape::SHAPE_KIND_POLYGON);
+    kpex::geometry::Polygon *polygon_pb = shape->mutable_polygon();
+
+    PyRef net(PyObject_CallMethod(polygon, "property", "s", "net"));
+    if (!net) {
+        return false;
+    }
+    const int hasNet = PyObject_IsTrue(net.get());
+    if (hasNet < 0) {
+        return false;
+    }
+    if (hasNet) {
+        Py_ssize_t size = 0;
+        const char *utf8 = PyUnicode_Check(net.get()) ? PyUnicode_AsUTF8AndSize(net.get(), &size) : nullptr;
+        if (!utf8) {
+            if (!PyErr_Occurred()) {
+                PyErr_Format(PyExc_TypeError, "net property must be a str, got %R", net.get());
+            }
+            return false;
+        }
+        polygon_pb->set_net(utf8, static_cast<size_t>(size));
+    }
+
+    PyRef str(PyObject_CallMethod(polygon, "to_s", nullptr));
+    if (!str) {
+        return false;
+    }
+    Py_ssize_t size = 0;
+    const char *utf8 = PyUnicode_Check(str.get()) ? PyUnicode_AsUTF8AndSize(str.get(), &size) : nullptr;
+    if (!utf8) {
+        if (!PyErr_Occurred()) {
+            PyErr_SetString(PyExc_TypeError, "to_s() must return a str");
+        }
+        return false;
+    }
+    if (!kpex::native::parseHullPoints(std::string_view(utf8, static_cast<size_t>(size)), polygon_pb)) {
+        PyErr_Format(PyExc_ValueError, "unexpected polygon string form: %R", str.get());
+        return false;
+    }
+    if (polygon_pb->hull_points_size() == 0 && polygon_pb->net().empty()) {
+        shape->clear_polygon();  // same as in Python, where the empty polygon is never touched
+    }
+    return true;
+}
+
+PyObject *encodeRegion(PyObject *, PyObject *polygons) {
+    PyRef iterator(PyObject_GetIter(polygons));
+    if (!iterator) {
+        return nullptr;
+    }
+
+    ArenaResetGuard guard;
+    auto *region = payloadArena().create<kpex::geometry::Region>();
+
+    while (PyObject *item = PyIter_Next(iterator.get())) {
+        PyRef polygon(item);
+        if (!encodePolygon(polygon.get(), region->add_shapes())) {
+            return nullptr;
+        }
+    }
+    if (PyErr_Occurred()) {
+        return nullptr;
+    }
+
+    return kpex::native::serializeToBytes(*region);
+}
+
+PyObject *encodeSinglePolygon(PyObject *, PyObject *polygon) {
+    ArenaResetGuard guard;
+    auto *shape = payloadArena().create<kpex::geometry::Shape>();
+    if (!encodePolygon(polygon, shape)) {
+        return nullptr;
+    }
+    return kpex::native::serializeToBytes(*shape);
+}
+
+PyObject *decodeRegion(PyObject *, PyObject *data) {
+    PythonBuffer buffer(data);
+    if (!buffer.valid()) {
+        return nullptr;
+    }
+
+    ArenaResetGuard guard;
+    auto *region = payloadArena().create<kpex::geometry::Region>();
+    if (!buffer.parse(region)) {
+        return nullptr;
+    }
+
+    PyRef shapes(PyList_New(region->shapes_size()));
+    if (!shapes) {
+        return nullptr;
+    }
+
+    std::string str;
+    for (int i = 0; i < region->shapes_size(); ++i) {
+        const kpex::geometry::Shape &shape = region->shapes(i);
+        const std::string *net = nullptr;
+        str.clear();
+        switch (shape.kind()) {
+            case kpex::geometry::Shape::SHAPE_KIND_BOX:
+                kpex::native::appendBoxString(shape.box(), &str);
+                net = &shape.box().net();
+                break;
+            case kpex::geometry::Shape::SHAPE_KIND_POLYGON:
+                kpex::native::appendPolygonString(shape.polygon(), &str);
+                net = &shape.polygon().net();
+                break;
+            default:
+                PyErr_Format(PyExc_NotImplementedError, "shape kind %d", static_cast<int>(shape.kind()));
+                return nullptr;
+        }
+        PyObject *item = Py_BuildValue("(is#s#)",
+                                       static_cast<int>(shape.kind()),
+                                       str.data(), static_cast<Py_ssize_t>(str.size()),
+                                       net->data(), static_cast<Py_ssize_t>(net->size()));
+        if (!item) {
+            return nullptr;
+        }
+        PyList_SET_ITEM(shapes.get(), i, item);  // steals the reference
+    }
+
+    Py_INCREF(shapes.get());
+    return shapes.get();
+}
+
+//-------------------------------------------------------------------------
+
+PyMethodDef methods[] = {
+    {"protobuf_version", protobufVersion, METH_NOARGS,
+     "protobuf_version() -> str\n\n"
+     "Version of the protobuf C++ runtime the extension is built with."},
+    {"message_stats", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(messageStats)),
+     METH_VARARGS | METH_KEYWORDS,
+     "message_stats(type_name, data, max_depth=0) -> str\n\n"
+     "Parses the serialized kpex message (any buffer) natively,\n"
+     "and returns its serialized bytes per field (see kpex_pbtool stats)."},
+    {"encode_region", encodeRegion, METH_O,
+     "encode_region(polygons) -> bytes\n\n"
+     "Serializes the polygons (e.g. a klayout.db.Region) as kpex.geometry.Region,\n"
+     "with the same layout as ShapesConverter.klayout_region_to_pb."},
+    {"encode_polygon", encodeSinglePolygon, METH_O,
+     "encode_polygon(polygon) -> bytes\n\n"
+     "Serializes the polygon as kpex.geometry.Shape,\n"
+     "with the same layout as ShapesConverter.klayout_polygon_to_pb."},
+    {"decode_region", decodeRegion, METH_O,
+     "decode_region(data) -> list[tuple[int, str, str]]\n\n"
+     "Parses a serialized kpex.geometry.Region (any buffer),\n"
+     "returns (Shape.Kind, string form for KLayout's Box.from_s / Polygon.from_s, net) per shape."},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+PyModuleDef moduleDef = {
+    PyModuleDef_HEAD_INIT,
+    "_kpex_native",                                 // m_name
+    "Optional native extension of klayout_pex",     // m_doc
+    -1,                                             // m_size
+    methods,                                        // m_methods
+    nullptr,                                        // m_slots
+    nullptr,                                        // m_traverse
+    nullptr,                                        // m_clear
+    nullptr                                         // m_free
+};
+
+}
+
+PyMODINIT_FUNC PyInit__kpex_native() {
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+    return PyModule_Create(&moduleDef);
+}
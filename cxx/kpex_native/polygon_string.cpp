@@ -0,0 +1,125 @@
+/*
+ * --------------------------------------------------------------------------------
+ * SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+ * Johannes Kepler University, Institute for Integrated Circuits.
+ *
+ * This file is part of KPEX 
+ * (see https://github.com/iic-jku/klayout-pex).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * --------------------------------------------------------------------------------
+ */
+#include "polygon_string.h"
+
+#include <charconv>
+#include <cstdint>
+
+namespace kpex::native {
+
+namespace {
+
+bool parseCoordinate(const char *&p, const char *end, int64_t *value) {
+    while (p < end && *p == ' ') {
+        ++p;
+    }
+    auto [next, ec] = std::from_chars(p, end, *value);
+    if (ec != std::errc()) {
+        return false;
+    }
+    p = next;
+    while (p < end && *p == ' ') {
+        ++p;
+    }
+    return true;
+}
+
+void appendCoordinate(int64_t value, std::string *s) {
+    char buffer[24];
+    auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    s->append(buffer, end);
+}
+
+void appendPoint(const kpex::geometry::Point &point, std::string *s) {
+    appendCoordinate(point.x(), s);
+    s->push_back(',');
+    appendCoordinate(point.y(), s);
+}
+
+}
+
+bool parseHullPoints(std::string_view s, kpex::geometry::Polygon *polygon) {
+    const char *p = s.data();
+    const char *end = p + s.size();
+
+    while (p < end && *p == ' ') {
+        ++p;
+    }
+    if (p == end || *p != '(') {
+        return false;
+    }
+    ++p;
+
+    if (p < end && *p == ')') {
+        return true;  // empty polygon
+    }
+
+    while (true) {
+        int64_t x = 0;
+        int64_t y = 0;
+        if (!parseCoordinate(p, end, &x) || p == end || *p != ',') {
+            return false;
+        }
+        ++p;
+        if (!parseCoordinate(p, end, &y) || p == end) {
+            return false;
+        }
+
+        auto *pt = polygon->add_hull_points();
+        pt->set_x(x);
+        pt->set_y(y);
+
+        switch (*p) {
+            case ';':
+                ++p;
+                break;
+            case '/':  // holes are not part of the protobuf message
+            case ')':
+                return true;
+            default:
+                return false;
+        }
+    }
+}
+
+void appendPolygonString(const kpex::geometry::Polygon &polygon, std::string *s) {
+    s->push_back('(');
+    for (int i = 0; i < polygon.hull_points_size(); ++i) {
+        if (i > 0) {
+            s->push_back(';');
+        }
+        appendPoint(polygon.hull_points(i), s);
+    }
+    s->push_back(')');
+}
+
+void appendBoxString(const kpex::geometry::Box &box, std::string *s) {
+    s->push_back('(');
+    appendPoint(box.lower_left(), s);
+    s->push_back(';');
+    appendPoint(box.upper_right(), s);
+    s->push_back(')');
+}
+
+}
@@ -0,0 +1,53 @@
+/*
+ * --------------------------------------------------------------------------------
+ * SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+ * Johannes Kepler University, Institute for Integrated Circuits.
+ *
+ * This file is part of KPEX 
+ * (see https://github.com/iic-jku/klayout-pex).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * --------------------------------------------------------------------------------
+ */
+#ifndef __POLYGON_STRING_H__
+#define __POLYGON_STRING_H__
+
+#include <string>
+#include <string_view>
+
+#include "kpex/geometry/shapes.pb.h"
+
+namespace kpex::native {
+
+//
+// KLayout's string form of a polygon (as returned by Polygon#to_s, in DBU),
+// e.g. "(0,0;0,100;250,100;250,0)", holes follow after '/',
+// properties (e.g. " props={net=>VDD}") may follow after the closing parenthesis.
+//
+// Appends the hull points to polygon->hull_points (in the same order as Polygon#each_point_hull),
+// returns false if the string is malformed.
+//
+bool parseHullPoints(std::string_view s, kpex::geometry::Polygon *polygon);
+
+// the reverse, appends the string form of the hull points to s,
+// as accepted by KLayout's Polygon.from_s
+void appendPolygonString(const kpex::geometry::Polygon &polygon, std::string *s);
+
+// appends "(left,bottom;right,top)", as accepted by KLayout's Box.from_s
+void appendBoxString(const kpex::geometry::Box &box, std::string *s);
+
+}
+
+#endif
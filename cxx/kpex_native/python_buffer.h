@@ -0,0 +1,106 @@
+/*
+ * --------------------------------------------------------------------------------
+ * SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+ * Johannes Kepler University, Institute for Integrated Circuits.
+ *
+ * This file is part of KPEX 
+ * (see https://github.com/iic-jku/klayout-pex).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * --------------------------------------------------------------------------------
+ */
+#ifndef __PYTHON_BUFFER_H__
+#define __PYTHON_BUFFER_H__
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <google/protobuf/message_lite.h>
+
+#include <climits>
+#include <string>
+
+namespace kpex::native {
+
+//
+// Hand-over of serialized messages between the Python protobuf runtime (upb) and kpex-protobuf.
+//
+// The two runtimes can't share message objects, but they can share the serialized buffer:
+//   - Python -> C++: msg.SerializeToString() is parsed directly from the bytes object
+//     (or any other object supporting the buffer protocol, e.g. a memoryview of an mmap),
+//     without copying it into a std::string first
+//   - C++ -> Python: the message is serialized directly into the storage of a new bytes object,
+//     which Python parses with msg.ParseFromString() / msg.MergeFromString()
+//
+
+// RAII view of an object supporting the buffer protocol
+class PythonBuffer {
+public:
+    // NOTE: on failure, valid() is false and a Python exception is set
+    explicit PythonBuffer(PyObject *object) {
+        m_valid = PyObject_GetBuffer(object, &m_view, PyBUF_SIMPLE) == 0;
+    }
+
+    ~PythonBuffer() {
+        if (m_valid) {
+            PyBuffer_Release(&m_view);
+        }
+    }
+
+    PythonBuffer(const PythonBuffer &) = delete;
+    PythonBuffer &operator=(const PythonBuffer &) = delete;
+
+    bool valid() const { return m_valid; }
+    const void *data() const { return m_view.buf; }
+    Py_ssize_t size() const { return m_view.len; }
+
+    // NOTE: on failure, a Python exception is set
+    bool parse(google::protobuf::MessageLite *message) const {
+        if (m_view.len > INT_MAX) {
+            PyErr_SetString(PyExc_ValueError, "serialized message exceeds 2 GiB");
+            return false;
+        }
+        if (!message->ParseFromArray(m_view.buf, static_cast<int>(m_view.len))) {
+            PyErr_Format(PyExc_ValueError, "failed to parse %s", message->GetTypeName().c_str());
+            return false;
+        }
+        return true;
+    }
+
+private:
+    Py_buffer m_view {};
+    bool m_valid = false;
+};
+
+// returns a new reference to a bytes object, or nullptr with a Python exception set
+inline PyObject *serializeToBytes(const google::protobuf::MessageLite &message) {
+    const size_t size = message.ByteSizeLong();
+    PyObject *bytes = PyBytes_FromStringAndSize(nullptr, static_cast<Py_ssize_t>(size));
+    if (!bytes) {
+        return nullptr;
+    }
+    auto *begin = reinterpret_cast<uint8_t *>(PyBytes_AS_STRING(bytes));
+    uint8_t *end = message.SerializeWithCachedSizesToArray(begin);
+    if (static_cast<size_t>(end - begin) != size) {
+        Py_DECREF(bytes);
+        PyErr_Format(PyExc_RuntimeError, "failed to serialize %s", message.GetTypeName().c_str());
+        return nullptr;
+    }
+    return bytes;
+}
+
+}
+
+#endif
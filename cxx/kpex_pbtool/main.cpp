@@ -0,0 +1,200 @@
+/*
+ * --------------------------------------------------------------------------------
+ * SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+ * Johannes Kepler University, Institute for Integrated Circuits.
+ *
+ * This file is part of KPEX 
+ * (see https://github.com/iic-jku/klayout-pex).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * --------------------------------------------------------------------------------
+ */
+//
+// kpex_pbtool: converts and inspects kpex protobuf messages
+//
+//   kpex_pbtool types
+//   kpex_pbtool convert <message-type> <input> <output> [--from <format>] [--to <format>] [--compact]
+//   kpex_pbtool stats <message-type> <input> [--from <format>] [--depth <n>]
+//
+// Formats are text, binary, json and delimited (length-delimited binary stream,
+// e.g. one message per tile), by default deduced from the file suffix.
+// Streams are processed message by message, each message is built in a reused arena.
+//
+
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/message.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "message_arena.h"
+#include "message_io.h"
+#include "message_stats.h"
+#include "message_types.h"
+
+namespace {
+
+using google::protobuf::Descriptor;
+using kpex::pb::Format;
+using kpex::pb::findMessageType;
+using kpex::pb::knownMessageTypes;
+
+Format formatOf(const std::optional<std::string> &formatName, const std::string &path) {
+    if (formatName) {
+        auto format = kpex::pb::parseFormat(*formatName);
+        if (!format) {
+            throw std::runtime_error("Unknown format '" + *formatName + "' "
+                                     "(allowed are text, binary, json, delimited)");
+        }
+        return *format;
+    }
+    auto format = kpex::pb::formatOfPath(path);
+    if (!format) {
+        throw std::runtime_error("Can't deduce the format of '" + path + "' from its suffix, "
+                                 "please pass --from / --to");
+    }
+    return *format;
+}
+
+struct Arguments {
+    std::vector<std::string> positional;
+    std::optional<std::string> from;
+    std::optional<std::string> to;
+    bool compact = false;
+    uint32_t depth = 0;
+};
+
+Arguments parseArguments(int argc, char **argv) {
+    Arguments args;
+    for (int i = 2; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("Missing value for " + arg);
+            }
+            return argv[++i];
+        };
+        if (arg == "--from") {
+            args.from = value();
+        } else if (arg == "--to") {
+            args.to = value();
+        } else if (arg == "--compact") {
+            args.compact = true;
+        } else if (arg == "--depth") {
+            args.depth = static_cast<uint32_t>(std::stoul(value()));
+        } else {
+            args.positional.push_back(arg);
+        }
+    }
+    return args;
+}
+
+// calls f for each message of the input, built in a reused arena
+template <typename F>
+uint64_t forEachMessage(const Descriptor *type, kpex::pb::MessageReader &reader, F f) {
+    const google::protobuf::Message *prototype =
+        google::protobuf::MessageFactory::generated_factory()->GetPrototype(type);
+    kpex::pb::MessageArena arena;
+    uint64_t count = 0;
+    while (true) {
+        google::protobuf::Message *message = prototype->New(arena.arena());
+        if (!reader.next(message)) {
+            break;
+        }
+        f(*message);
+        ++count;
+        arena.reset();
+    }
+    return count;
+}
+
+int printUsage(const char *program) {
+    std::cerr << "Usage: " << program << " types" << std::endl
+              << "       " << program << " convert <message-type> <input> <output> "
+                 "[--from <format>] [--to <format>] [--compact]" << std::endl
+              << "       " << program << " stats <message-type> <input> [--from <format>] [--depth <n>]" << std::endl
+              << std::endl
+              << "Formats: text, binary, json, delimited (default: deduced from the file suffix, "
+                 ".txtpb, .pb, .json, .pbd), '-' is stdin / stdout" << std::endl;
+    return 1;
+}
+
+}
+
+int main(int argc, char **argv) {
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    if (argc < 2) {
+        return printUsage(argv[0]);
+    }
+
+    const std::string command = argv[1];
+
+    try {
+        const Arguments args = parseArguments(argc, argv);
+
+        if (command == "types") {
+            for (const Descriptor *d : knownMessageTypes()) {
+                std::cout << d->full_name() << std::endl;
+            }
+        } else if (command == "convert") {
+            if (args.positional.size() != 3) {
+                return printUsage(argv[0]);
+            }
+            const Descriptor *type = findMessageType(args.positional[0]);
+            const std::string &inputPath = args.positional[1];
+            const std::string &outputPath = args.positional[2];
+
+            kpex::pb::MessageReader reader(inputPath, formatOf(args.from, inputPath));
+            kpex::pb::MessageWriter::Options options;
+            options.prettyJson = !args.compact;
+            kpex::pb::MessageWriter writer(outputPath, formatOf(args.to, outputPath), options);
+            const uint64_t count = forEachMessage(type, reader, [&](const google::protobuf::Message &m) {
+                writer.write(m);
+            });
+            writer.close();
+
+            std::cerr << "Converted " << count << " message(s) of type " << type->full_name() << ", "
+                      << reader.byteCount() << " bytes read, "
+                      << writer.byteCount() << " bytes written" << std::endl;
+        } else if (command == "stats") {
+            if (args.positional.size() != 2) {
+                return printUsage(argv[0]);
+            }
+            const Descriptor *type = findMessageType(args.positional[0]);
+            const std::string &inputPath = args.positional[1];
+
+            kpex::pb::MessageReader reader(inputPath, formatOf(args.from, inputPath));
+            kpex::pb::MessageStatistics stats;
+            forEachMessage(type, reader, [&](const google::protobuf::Message &m) {
+                stats.add(m);
+            });
+            stats.print(std::cout, args.depth);
+        } else {
+            return printUsage(argv[0]);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 3;
+    }
+
+    google::protobuf::ShutdownProtobufLibrary();
+
+    return 0;
+}
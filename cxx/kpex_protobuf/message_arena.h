@@ -0,0 +1,143 @@
+/*
+ * --------------------------------------------------------------------------------
+ * SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+ * Johannes Kepler University, Institute for Integrated Circuits.
+ *
+ * This file is part of KPEX 
+ * (see https://github.com/iic-jku/klayout-pex).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * --------------------------------------------------------------------------------
+ */
+#ifndef __MESSAGE_ARENA_H__
+#define __MESSAGE_ARENA_H__
+
+#include <google/protobuf/arena.h>
+#include <google/protobuf/message_lite.h>
+#include <google/protobuf/util/delimited_message_util.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace kpex::pb {
+
+//
+// Reusable arena for building large messages
+// (e.g. kpex.request.RExtractionRequest or kpex.result.PEXResult).
+//
+// A message created by create() allocates all its nested messages, strings and
+// repeated fields (add_*(), mutable_*()) in the blocks of the arena,
+// instead of one heap allocation each. Destruction is a single reset(),
+// which releases everything at once.
+//
+// The first block is owned by the MessageArena and survives reset(),
+// so building one message per cell / tile / net in a loop reuses the same memory:
+//
+//     kpex::pb::MessageArena arena;
+//     std::string buffer;
+//     for (...) {
+//         auto *request = arena.create<kpex::request::RExtractionRequest>();
+//         ...
+//         kpex::pb::serialize(*request, &buffer);
+//         arena.reset();
+//     }
+//
+// NOTE: messages created by the arena must not be deleted, and are invalid after reset()
+//
+class MessageArena {
+public:
+    struct Options {
+        size_t initialBlockSize = 1 << 20;  // owned by the MessageArena, reused after reset()
+        size_t maxBlockSize = 8 << 20;      // upper limit of the block size growth
+    };
+
+    MessageArena()
+        : MessageArena(Options())
+    {}
+
+    explicit MessageArena(const Options &options)
+        : m_initialBlock(new char[options.initialBlockSize]),
+          m_arena(arenaOptions(options, m_initialBlock.get()))
+    {}
+
+    MessageArena(const MessageArena &) = delete;
+    MessageArena &operator=(const MessageArena &) = delete;
+
+    template <typename M>
+    M *create() {
+#if GOOGLE_PROTOBUF_VERSION < 5026000
+        // NOTE: before 26.x, Create does not pass the arena to the message,
+        //       so nested messages would still be heap allocated
+        return google::protobuf::Arena::CreateMessage<M>(&m_arena);
+#else
+        return google::protobuf::Arena::Create<M>(&m_arena);
+#endif
+    }
+
+    // releases all messages created since the last reset,
+    // returns the number of bytes that were allocated for them
+    uint64_t reset() {
+        return m_arena.Reset();
+    }
+
+    uint64_t spaceUsed() const {
+        return m_arena.SpaceUsed();
+    }
+
+    uint64_t spaceAllocated() const {
+        return m_arena.SpaceAllocated();
+    }
+
+    google::protobuf::Arena *arena() {
+        return &m_arena;
+    }
+
+private:
+    static google::protobuf::ArenaOptions arenaOptions(const Options &options, char *initialBlock) {
+        google::protobuf::ArenaOptions o;
+        o.start_block_size = options.initialBlockSize;
+        o.max_block_size = options.maxBlockSize;
+        o.initial_block = initialBlock;
+        o.initial_block_size = options.initialBlockSize;
+        return o;
+    }
+
+    // NOTE: declared before m_arena, which uses it
+    std::unique_ptr<char[]> m_initialBlock;
+    google::protobuf::Arena m_arena;
+};
+
+// Serializes into buffer, reusing its capacity from the previous message
+inline bool serialize(const google::protobuf::MessageLite &message,
+                      std::string *buffer)
+{
+    buffer->clear();
+    return message.AppendToString(buffer);
+}
+
+// Appends one length-delimited message to the stream,
+// same framing as klayout_pex/util/delimited_protobuf.py
+inline bool writeDelimited(const google::protobuf::MessageLite &message,
+                           std::ostream *output)
+{
+    return google::protobuf::util::SerializeDelimitedToOstream(message, output);
+}
+
+}
+
+#endif
@@ -0,0 +1,315 @@
+/*
+ * --------------------------------------------------------------------------------
+ * SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+ * Johannes Kepler University, Institute for Integrated Circuits.
+ *
+ * This file is part of KPEX 
+ * (see https://github.com/iic-jku/klayout-pex).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * --------------------------------------------------------------------------------
+ */
+#include "message_io.h"
+
+#include <google/protobuf/text_format.h>
+#include <google/protobuf/util/delimited_message_util.h>
+#include <google/protobuf/util/json_util.h>
+#include <google/protobuf/util/type_resolver_util.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace kpex::pb {
+
+namespace {
+
+const std::string kTypeUrlPrefix = "type.googleapis.com";
+
+void fail(const std::string &path, const std::string &message) {
+    throw std::runtime_error("'" + path + "': " + message);
+}
+
+google::protobuf::util::TypeResolver *typeResolver() {
+    static std::unique_ptr<google::protobuf::util::TypeResolver> resolver(
+        google::protobuf::util::NewTypeResolverForDescriptorPool(
+            kTypeUrlPrefix, google::protobuf::DescriptorPool::generated_pool()));
+    return resolver.get();
+}
+
+std::string typeUrl(const google::protobuf::Descriptor *descriptor) {
+    return kTypeUrlPrefix + "/" + std::string(descriptor->full_name());
+}
+
+void writeRaw(google::protobuf::io::ZeroCopyOutputStream *output,
+              std::string_view data,
+              const std::string &path)
+{
+    while (!data.empty()) {
+        void *buffer = nullptr;
+        int size = 0;
+        if (!output->Next(&buffer, &size)) {
+            fail(path, "write failed");
+        }
+        const size_t n = std::min(static_cast<size_t>(size), data.size());
+        std::memcpy(buffer, data.data(), n);
+        if (n < static_cast<size_t>(size)) {
+            output->BackUp(size - static_cast<int>(n));
+        }
+        data.remove_prefix(n);
+    }
+}
+
+bool endsWith(std::string_view s, std::string_view suffix) {
+    return s.size() >= suffix.size() && s.substr(s.size() - suffix.size()) == suffix;
+}
+
+}
+
+//-------------------------------------------------------------------------
+
+const char *describeFormat(Format format) {
+    switch (format) {
+        case Format::Text:      return "Protobuf Textual";
+        case Format::Binary:    return "Protobuf Binary";
+        case Format::JSON:      return "JSON";
+        case Format::Delimited: return "Length-Delimited Protobuf Binary Stream";
+    }
+    return "?";
+}
+
+std::optional<Format> parseFormat(std::string_view name) {
+    if (name == "text") return Format::Text;
+    if (name == "binary") return Format::Binary;
+    if (name == "json") return Format::JSON;
+    if (name == "delimited") return Format::Delimited;
+    return std::nullopt;
+}
+
+std::optional<Format> formatOfPath(std::string_view path) {
+    if (endsWith(path, ".json")) return Format::JSON;
+    if (endsWith(path, ".pbd")) return Format::Delimited;
+    if (endsWith(path, ".txtpb") || endsWith(path, ".textproto") || endsWith(path, ".pb.txt")) return Format::Text;
+    if (endsWith(path, ".pb") || endsWith(path, ".binpb")) return Format::Binary;
+    return std::nullopt;
+}
+
+//-------------------------------------------------------------------------
+
+MessageReader::MessageReader(const std::string &path, Format format)
+    : m_path(path),
+      m_format(format)
+{
+    if (path == "-") {
+        m_stream = &std::cin;
+    } else {
+        m_file = std::make_unique<std::ifstream>(path, std::ios::in | std::ios::binary);
+        if (!*m_file) {
+            fail(path, "can't open for reading");
+        }
+        m_stream = m_file.get();
+    }
+    m_input = std::make_unique<google::protobuf::io::IstreamInputStream>(m_stream);
+}
+
+MessageReader::~MessageReader() = default;
+
+bool MessageReader::next(google::protobuf::Message *message) {
+    if (m_format != Format::Delimited && m_messageCount > 0) {
+        return false;
+    }
+
+    switch (m_format) {
+        case Format::Text:
+            if (!google::protobuf::TextFormat::Parse(m_input.get(), message)) {
+                fail(m_path, "failed to parse text format");
+            }
+            break;
+
+        case Format::Binary:
+            if (!message->ParseFromZeroCopyStream(m_input.get())) {
+                fail(m_path, "failed to parse binary format");
+            }
+            break;
+
+        case Format::JSON: {
+            // NOTE: the JSON text is transcoded chunk by chunk, only the binary message is buffered
+            std::string binary;
+            {
+                google::protobuf::io::StringOutputStream output(&binary);
+                google::protobuf::util::JsonParseOptions options;
+                auto status = google::protobuf::util::JsonToBinaryStream(typeResolver(),
+                                                                        typeUrl(message->GetDescriptor()),
+                                                                        m_input.get(), &output, options);
+                if (!status.ok()) {
+                    fail(m_path, "failed to parse JSON: " + status.ToString());
+                }
+            }
+            if (!message->ParseFromString(binary)) {
+                fail(m_path, "failed to parse transcoded JSON");
+            }
+            break;
+        }
+
+        case Format::Delimited: {
+            bool cleanEOF = false;
+            if (!google::protobuf::util::ParseDelimitedFromZeroCopyStream(message, m_input.get(), &cleanEOF)) {
+                if (cleanEOF) {
+                    return false;
+                }
+                fail(m_path, "truncated or malformed message #" + std::to_string(m_messageCount + 1)
+                             + " in delimited stream");
+            }
+            break;
+        }
+    }
+
+    ++m_messageCount;
+    return true;
+}
+
+int64_t MessageReader::byteCount() const {
+    return m_input->ByteCount();
+}
+
+//-------------------------------------------------------------------------
+
+MessageWriter::MessageWriter(const std::string &path, Format format)
+    : MessageWriter(path, format, Options())
+{}
+
+MessageWriter::MessageWriter(const std::string &path, Format format, const Options &options)
+    : m_path(path),
+      m_format(format),
+      m_options(options)
+{
+    if (path == "-") {
+        m_stream = &std::cout;
+    } else {
+        m_file = std::make_unique<std::ofstream>(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!*m_file) {
+            fail(path, "can't open for writing");
+        }
+        m_stream = m_file.get();
+    }
+    m_output = std::make_unique<google::protobuf::io::OstreamOutputStream>(m_stream);
+}
+
+MessageWriter::~MessageWriter() {
+    try {
+        close();
+    } catch (...) {
+        // NOTE: call close() explicitly to see the error
+    }
+}
+
+void MessageWriter::write(const google::protobuf::Message &message) {
+    if (!m_output) {
+        fail(m_path, "already closed");
+    }
+    if (m_format == Format::Binary && m_messageCount > 0) {
+        fail(m_path, "binary format holds a single message, use the delimited format for several messages");
+    }
+
+    const google::protobuf::Descriptor *descriptor = message.GetDescriptor();
+
+    switch (m_format) {
+        case Format::Text:
+            if (m_messageCount == 0 && m_options.textHeader) {
+                writeRaw(m_output.get(),
+                         "# proto-file: " + std::string(descriptor->file()->name()) + "\n"
+                         "# proto-message: " + std::string(descriptor->full_name()) + "\n\n",
+                         m_path);
+            } else if (m_messageCount > 0) {
+                writeRaw(m_output.get(), "\n# message #" + std::to_string(m_messageCount + 1) + "\n\n", m_path);
+            }
+            if (!google::protobuf::TextFormat::Print(message, m_output.get())) {
+                fail(m_path, "failed to write text format");
+            }
+            break;
+
+        case Format::Binary:
+            if (!message.SerializeToZeroCopyStream(m_output.get())) {
+                fail(m_path, "failed to write binary format");
+            }
+            break;
+
+        case Format::JSON: {
+            if (m_messageCount > 0) {
+                writeRaw(m_output.get(), "\n", m_path);
+            }
+            // NOTE: the JSON text is written chunk by chunk, only the binary message is buffered
+            std::string binary;
+            if (!message.SerializeToString(&binary)) {
+                fail(m_path, "failed to serialize message");
+            }
+            google::protobuf::io::ArrayInputStream input(binary.data(), static_cast<int>(binary.size()));
+            google::protobuf::util::JsonPrintOptions options;
+            options.add_whitespace = m_options.prettyJson;
+            options.preserve_proto_field_names = true;
+            auto status = google::protobuf::util::BinaryToJsonStream(typeResolver(), typeUrl(descriptor),
+                                                                     &input, m_output.get(), options);
+            if (!status.ok()) {
+                fail(m_path, "failed to write JSON: " + status.ToString());
+            }
+            break;
+        }
+
+        case Format::Delimited:
+            if (!google::protobuf::util::SerializeDelimitedToZeroCopyStream(message, m_output.get())) {
+                fail(m_path, "failed to write delimited message");
+            }
+            break;
+    }
+
+    ++m_messageCount;
+}
+
+void MessageWriter::close() {
+    if (!m_output) {
+        return;
+    }
+    m_byteCount = m_output->ByteCount();
+    m_output.reset();  // flushes into m_stream
+    m_stream->flush();
+    const bool ok = static_cast<bool>(*m_stream);
+    if (m_file) {
+        m_file->close();
+    }
+    if (!ok || (m_file && m_file->fail())) {
+        fail(m_path, "write failed");
+    }
+}
+
+int64_t MessageWriter::byteCount() const {
+    return m_output ? m_output->ByteCount() : m_byteCount;
+}
+
+//-------------------------------------------------------------------------
+
+void readMessage(const std::string &path, Format format, google::protobuf::Message *message) {
+    MessageReader reader(path, format);
+    if (!reader.next(message)) {
+        fail(path, "no message");
+    }
+}
+
+void writeMessage(const google::protobuf::Message &message, const std::string &path, Format format) {
+    MessageWriter writer(path, format);
+    writer.write(message);
+    writer.close();
+}
+
+}
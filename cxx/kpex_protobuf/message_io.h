@@ -0,0 +1,138 @@
+/*
+ * --------------------------------------------------------------------------------
+ * SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+ * Johannes Kepler University, Institute for Integrated Circuits.
+ *
+ * This file is part of KPEX 
+ * (see https://github.com/iic-jku/klayout-pex).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * --------------------------------------------------------------------------------
+ */
+#ifndef __MESSAGE_IO_H__
+#define __MESSAGE_IO_H__
+
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <google/protobuf/message.h>
+#include <google/protobuf/util/type_resolver.h>
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace kpex::pb {
+
+//
+// Reading / writing of any kpex protobuf message through zero-copy file streams.
+//
+// Memory is bounded by the size of a single message:
+//   - files are read / written through IstreamInputStream / OstreamOutputStream
+//   - binary and text are parsed / printed directly from / to the file stream
+//   - JSON is transcoded from / to the binary wire format by the stream based
+//     JsonToBinaryStream / BinaryToJsonStream, the JSON text is never held in memory
+//   - delimited streams (<varint size><message>..., same framing as
+//     klayout_pex/util/delimited_protobuf.py) are processed message by message
+//
+// All functions throw std::runtime_error on I/O or parse errors.
+//
+
+enum class Format {
+    Text,
+    Binary,
+    JSON,
+    Delimited
+};
+
+const char *describeFormat(Format format);
+
+// accepts "text", "binary", "json", "delimited"
+std::optional<Format> parseFormat(std::string_view name);
+
+// by file name suffix, e.g. ".pb.json" is JSON, ".pbd" is Delimited
+std::optional<Format> formatOfPath(std::string_view path);
+
+class MessageReader {
+public:
+    // NOTE: path "-" reads from stdin
+    MessageReader(const std::string &path, Format format);
+    ~MessageReader();
+
+    MessageReader(const MessageReader &) = delete;
+    MessageReader &operator=(const MessageReader &) = delete;
+
+    // Parses the next message into message (which must be empty),
+    // returns false at the end of the input.
+    // Text, binary and JSON inputs hold exactly one message.
+    bool next(google::protobuf::Message *message);
+
+    // bytes consumed from the input so far
+    int64_t byteCount() const;
+
+private:
+    std::string m_path;
+    Format m_format;
+    std::unique_ptr<std::ifstream> m_file;  // not used for stdin
+    std::istream *m_stream = nullptr;
+    std::unique_ptr<google::protobuf::io::IstreamInputStream> m_input;
+    size_t m_messageCount = 0;
+};
+
+class MessageWriter {
+public:
+    struct Options {
+        bool prettyJson = true;      // JSON: add whitespace and line breaks
+        bool textHeader = true;      // Text: leading proto-file / proto-message comments
+    };
+
+    // NOTE: path "-" writes to stdout
+    MessageWriter(const std::string &path, Format format);
+    MessageWriter(const std::string &path, Format format, const Options &options);
+    ~MessageWriter();
+
+    MessageWriter(const MessageWriter &) = delete;
+    MessageWriter &operator=(const MessageWriter &) = delete;
+
+    // Binary output holds exactly one message,
+    // several text / JSON messages are written one after the other
+    void write(const google::protobuf::Message &message);
+
+    // flushes and closes the output, throws if any write failed
+    void close();
+
+    // bytes written to the output so far
+    int64_t byteCount() const;
+
+private:
+    std::string m_path;
+    Format m_format;
+    Options m_options;
+    std::unique_ptr<std::ofstream> m_file;  // not used for stdout
+    std::ostream *m_stream = nullptr;
+    std::unique_ptr<google::protobuf::io::OstreamOutputStream> m_output;
+    int64_t m_byteCount = 0;  // of the closed output
+    size_t m_messageCount = 0;
+};
+
+// convenience for files holding a single message
+void readMessage(const std::string &path, Format format, google::protobuf::Message *message);
+void writeMessage(const google::protobuf::Message &message, const std::string &path, Format format);
+
+}
+
+#endif
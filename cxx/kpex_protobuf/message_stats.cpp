@@ -0,0 +1,132 @@
+/*
+ * --------------------------------------------------------------------------------
+ * SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+ * Johannes Kepler University, Institute for Integrated Circuits.
+ *
+ * This file is part of KPEX 
+ * (see https://github.com/iic-jku/klayout-pex).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * --------------------------------------------------------------------------------
+ */
+#include "message_stats.h"
+
+#include <google/protobuf/wire_format.h>
+
+#include <algorithm>
+#include <iomanip>
+
+namespace kpex::pb {
+
+MessageStatistics::MessageStatistics()
+    : m_nodes(1)
+{}
+
+void MessageStatistics::add(const google::protobuf::Message &message) {
+    if (m_messageName.empty()) {
+        m_messageName = std::string(message.GetDescriptor()->full_name());
+    }
+    const uint64_t size = message.ByteSizeLong();
+    ++m_messageCount;
+    m_byteCount += size;
+    m_nodes[0].bytes += size;
+    m_nodes[0].values += 1;
+    addFields(message, 0);
+}
+
+size_t MessageStatistics::child(size_t nodeIndex, const google::protobuf::FieldDescriptor *field) {
+    auto it = m_nodes[nodeIndex].childByNumber.find(field->number());
+    if (it != m_nodes[nodeIndex].childByNumber.end()) {
+        return it->second;
+    }
+    const size_t idx = m_nodes.size();
+    m_nodes[nodeIndex].childByNumber[field->number()] = idx;
+    // NOTE: m_nodes may reallocate, don't keep references across push_back
+    Node node;
+    node.name = std::string(field->name());
+    m_nodes.push_back(std::move(node));
+    return idx;
+}
+
+void MessageStatistics::addFields(const google::protobuf::Message &message, size_t nodeIndex) {
+    const google::protobuf::Reflection *reflection = message.GetReflection();
+    std::vector<const google::protobuf::FieldDescriptor *> fields;
+    reflection->ListFields(message, &fields);
+
+    for (const auto *field : fields) {
+        const size_t idx = child(nodeIndex, field);
+        m_nodes[idx].bytes += google::protobuf::internal::WireFormat::FieldByteSize(field, message);
+
+        if (field->is_repeated()) {
+            const int n = reflection->FieldSize(message, field);
+            m_nodes[idx].values += n;
+            if (field->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+                for (int i = 0; i < n; ++i) {
+                    addFields(reflection->GetRepeatedMessage(message, field, i), idx);
+                }
+            }
+        } else {
+            m_nodes[idx].values += 1;
+            if (field->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+                addFields(reflection->GetMessage(message, field), idx);
+            }
+        }
+    }
+}
+
+void MessageStatistics::print(std::ostream &os, uint32_t maxDepth) const {
+    os << "Messages: " << m_messageCount
+       << " (" << (m_messageName.empty() ? "?" : m_messageName) << "), "
+       << m_byteCount << " bytes serialized" << std::endl;
+    if (m_messageCount == 0) {
+        return;
+    }
+
+    os << std::setw(14) << "bytes" << std::setw(9) << "%"
+       << std::setw(14) << "values" << "  field" << std::endl;
+    printNode(os, 0, "", 0, maxDepth);
+}
+
+void MessageStatistics::printNode(std::ostream &os,
+                                  size_t nodeIndex,
+                                  const std::string &path,
+                                  uint32_t depth,
+                                  uint32_t maxDepth) const
+{
+    if (maxDepth > 0 && depth >= maxDepth) {
+        return;
+    }
+
+    std::vector<size_t> children;
+    for (const auto &[number, idx] : m_nodes[nodeIndex].childByNumber) {
+        children.push_back(idx);
+    }
+    std::sort(children.begin(), children.end(), [this](size_t a, size_t b) {
+        return m_nodes[a].bytes > m_nodes[b].bytes;
+    });
+
+    for (size_t idx : children) {
+        const Node &node = m_nodes[idx];
+        const std::string childPath = path.empty() ? node.name : path + "." + node.name;
+        const double percent = m_byteCount > 0 ? 100.0 * static_cast<double>(node.bytes) / m_byteCount : 0.0;
+        os << std::setw(14) << node.bytes
+           << std::setw(8) << std::fixed << std::setprecision(1) << percent << "%"
+           << std::setw(14) << node.values
+           << "  " << childPath << std::endl;
+        printNode(os, idx, childPath, depth + 1, maxDepth);
+    }
+}
+
+}
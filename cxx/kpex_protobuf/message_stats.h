@@ -0,0 +1,79 @@
+/*
+ * --------------------------------------------------------------------------------
+ * SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+ * Johannes Kepler University, Institute for Integrated Circuits.
+ *
+ * This file is part of KPEX 
+ * (see https://github.com/iic-jku/klayout-pex).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * --------------------------------------------------------------------------------
+ */
+#ifndef __MESSAGE_STATS_H__
+#define __MESSAGE_STATS_H__
+
+#include <google/protobuf/message.h>
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace kpex::pb {
+
+//
+// Size statistics of a sequence of messages (e.g. a delimited stream),
+// per field path (e.g. net_extraction_requests.region_by_layer.region.shapes),
+// to find out which fields dominate the serialized size.
+//
+// The bytes of a field include its tags and length prefixes,
+// and (for message fields) all nested fields.
+//
+class MessageStatistics {
+public:
+    MessageStatistics();
+
+    void add(const google::protobuf::Message &message);
+
+    // prints the field tree, children sorted by bytes,
+    // maxDepth limits the nesting (0: unlimited)
+    void print(std::ostream &os, uint32_t maxDepth = 0) const;
+
+    uint64_t messageCount() const { return m_messageCount; }
+    uint64_t byteCount() const { return m_byteCount; }
+
+private:
+    struct Node {
+        std::string name;
+        uint64_t bytes = 0;
+        uint64_t values = 0;                  // count of (repeated) values
+        std::map<int, size_t> childByNumber;  // field number -> index into m_nodes
+    };
+
+    void addFields(const google::protobuf::Message &message, size_t nodeIndex);
+    size_t child(size_t nodeIndex, const google::protobuf::FieldDescriptor *field);
+    void printNode(std::ostream &os, size_t nodeIndex, const std::string &path,
+                   uint32_t depth, uint32_t maxDepth) const;
+
+    std::string m_messageName;
+    uint64_t m_messageCount = 0;
+    uint64_t m_byteCount = 0;
+    std::vector<Node> m_nodes;  // [0] is the root
+};
+
+}
+
+#endif
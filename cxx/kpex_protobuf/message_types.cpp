@@ -0,0 +1,80 @@
+/*
+ * --------------------------------------------------------------------------------
+ * SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+ * Johannes Kepler University, Institute for Integrated Circuits.
+ *
+ * This file is part of KPEX 
+ * (see https://github.com/iic-jku/klayout-pex).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * --------------------------------------------------------------------------------
+ */
+#include "message_types.h"
+
+#include <stdexcept>
+
+#include "kpex/c/geometric_moments.pb.h"
+#include "kpex/geometry/shapes.pb.h"
+#include "kpex/klayout/r_extractor_tech.pb.h"
+#include "kpex/r/r_network.pb.h"
+#include "kpex/request/pex_request.pb.h"
+#include "kpex/result/pex_result.pb.h"
+#include "kpex/tech/tech.pb.h"
+
+namespace kpex::pb {
+
+std::vector<const google::protobuf::Descriptor *> knownMessageTypes() {
+    return {
+        kpex::tech::Technology::descriptor(),
+        kpex::request::PEXRequest::descriptor(),
+        kpex::request::RExtractionRequest::descriptor(),
+        kpex::request::RNetExtractionRequest::descriptor(),
+        kpex::result::PEXResult::descriptor(),
+        kpex::result::CellExtractionResult::descriptor(),
+        kpex::result::RExtractionResult::descriptor(),
+        kpex::result::CExtractionResult::descriptor(),
+        kpex::r::RNetwork::descriptor(),
+        kpex::r::PackedRNetwork::descriptor(),
+        kpex::c::GeometricMoments::descriptor(),
+        kpex::klayout::RExtractorTech::descriptor(),
+        kpex::geometry::Region::descriptor(),
+    };
+}
+
+const google::protobuf::Descriptor *findMessageType(const std::string &name) {
+    using google::protobuf::Descriptor;
+
+    // NOTE: make sure the generated descriptors are registered before looking up by name
+    const std::vector<const Descriptor *> known = knownMessageTypes();
+
+    if (const Descriptor *d = google::protobuf::DescriptorPool::generated_pool()->FindMessageTypeByName(name)) {
+        return d;
+    }
+    const Descriptor *found = nullptr;
+    for (const Descriptor *d : known) {
+        if (d->name() == name) {
+            if (found) {
+                throw std::runtime_error("Ambiguous message type '" + name + "', use the full name");
+            }
+            found = d;
+        }
+    }
+    if (!found) {
+        throw std::runtime_error("Unknown message type '" + name + "'");
+    }
+    return found;
+}
+
+}
@@ -0,0 +1,213 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from __future__ import annotations
+from dataclasses import dataclass
+from functools import cached_property
+from typing import *
+
+from klayout_pex.cross_sections.field_solver import CrossSection, Rect
+from klayout_pex.tech_info import TechInfo
+from klayout_pex_protobuf.kpex.tech.process_stack_pb2 import ProcessStackInfo
+
+#
+# Canonical cross-sections of the process stack, for the field solver:
+#
+#   two parallel wires of the same width on one routing layer, in the stack dielectrics,
+#   above the substrate or a plane of a lower routing layer,
+#   optionally below a plane of an upper routing layer
+#
+#                     ───────────── plane above (optional)
+#
+#            ┌───────┐   spacing   ┌───────┐
+#            │ wire1 │◄───────────►│ wire2 │
+#            └───────┘             └───────┘
+#              width
+#   ─────────────────────────────────────── plane below (substrate or routing layer)
+#
+# (x = 0 is in the middle of the gap, z is the absolute height of the process stack)
+#
+
+
+@dataclass
+class RoutingLayer:
+    name: str                                 # canonical layer name (as used by the 2.5D engine)
+    process_layer: ProcessStackInfo.LayerInfo
+
+    @property
+    def z_bottom(self) -> float:
+        return self.process_layer.metal_layer.z
+
+    @property
+    def z_top(self) -> float:
+        return self.process_layer.metal_layer.z + self.process_layer.metal_layer.thickness
+
+
+@dataclass
+class TwoWireCrossSection:
+    cross_section: CrossSection
+    wire1: int   # conductor indices
+    wire2: int
+
+
+@dataclass
+class CrossSectionBuilder:
+    tech_info: TechInfo
+
+    @cached_property
+    def routing_layers(self) -> List[RoutingLayer]:
+        """
+        Metal layers with sidewall capacitance, bottom up.
+        NOTE: if several process layers share a canonical layer (e.g. met3_ncap / met3_cap),
+              the first one is used
+        """
+        layers: List[RoutingLayer] = []
+        seen: Set[str] = set()
+        for pl in self.tech_info.process_metal_layers:
+            gds_pair = self.tech_info.gds_pair(pl.name)
+            if gds_pair is None:
+                continue
+            name = self.tech_info.canonical_layer_name_by_gds_pair.get(gds_pair, None)
+            if name is None or name in seen or name not in self.tech_info.sidewall_cap_by_layer_name:
+                continue
+            seen.add(name)
+            layers.append(RoutingLayer(name=name, process_layer=pl))
+        return layers
+
+    @cached_property
+    def routing_layer_by_name(self) -> Dict[str, RoutingLayer]:
+        return {rl.name: rl for rl in self.routing_layers}
+
+    @cached_property
+    def dielectric_bands(self) -> List[Tuple[float, float, float]]:
+        """
+        (z_bottom, z_top, k) of the field oxide and the simple dielectrics, in stack order
+        """
+        if self.tech_info.resolved_process_stack is None:
+            raise ValueError("Technology file has no resolved process stack, regenerate it with gen_tech_pb")
+
+        LT = ProcessStackInfo.LayerType
+        bands = []
+        for iv in self.tech_info.resolved_process_stack.intervals:
+            match iv.layer_type:
+                case LT.LAYER_TYPE_FIELD_OXIDE:
+                    k = self.tech_info.field_oxide_layer.field_oxide_layer.dielectric_k
+                case LT.LAYER_TYPE_SIMPLE_DIELECTRIC:
+                    k = self.tech_info.dielectric_by_name.get(iv.name, None)
+                    if k is None:
+                        continue  # excluded by the dielectric filter
+                case _:
+                    continue
+            if iv.z_top > iv.z_bottom:
+                bands.append((iv.z_bottom, iv.z_top, k))
+        if not bands:
+            raise ValueError("Process stack has no dielectrics")
+        return bands
+
+    @cached_property
+    def top_dielectric_k(self) -> float:
+        return max(self.dielectric_bands, key=lambda b: b[1])[2]
+
+    def paint_shells(self,
+                     cross_section: CrossSection,
+                     layer: RoutingLayer,
+                     x1: float,
+                     x2: float,
+                     z_min: float):
+        """
+        Sidewall / conformal dielectrics around a wire of the layer from x1 to x2,
+        outermost first (the inner ones win)
+        """
+        shells = self.tech_info.sidewall_dielectric_shells(layer.process_layer.name)
+        offsets = []
+        offset = 0.0
+        for shell in shells:
+            offset += shell.width_outside
+            offsets.append(offset)
+        for shell, offset in reversed(list(zip(shells, offsets))):
+            z_top = layer.z_bottom + shell.height
+            if z_top <= z_min:
+                continue
+            cross_section.add_dielectric(Rect(x1 - offset, max(layer.z_bottom, z_min), x2 + offset, z_top),
+                                         shell.dielectric_k)
+
+    def two_wires(self,
+                  layer_name: str,
+                  width: float,
+                  spacing: float,
+                  below_layer_name: str = '',
+                  above_layer_name: str = '') -> TwoWireCrossSection:
+        """
+        :param below_layer_name: routing layer of the plane below, empty for the substrate
+        :param above_layer_name: routing layer of the plane above, empty for none
+        """
+        layer = self.routing_layer_by_name[layer_name]
+        below = self.routing_layer_by_name[below_layer_name] if below_layer_name else None
+        above = self.routing_layer_by_name[above_layer_name] if above_layer_name else None
+
+        if below is not None and below.z_top >= layer.z_bottom:
+            raise ValueError(f"Layer {below_layer_name} is not below {layer_name}")
+        if above is not None and above.z_bottom <= layer.z_top:
+            raise ValueError(f"Layer {above_layer_name} is not above {layer_name}")
+
+        z_min = 0.0 if below is None else below.z_top
+        thickness = layer.z_top - layer.z_bottom
+        if above is None:
+            z_max = layer.z_top + max(2.0 * (2.0 * width + spacing), 4.0 * thickness, 2.0)
+        else:
+            z_max = above.z_bottom
+
+        # NOTE: the lateral borders are far enough, so the field is (almost) vertical there
+        x_max = 0.5 * spacing + width + max(3.0 * (layer.z_top - z_min), 2.0 * (width + spacing), 2.0)
+
+        cs = CrossSection(domain=Rect(-x_max, z_min, x_max, z_max),
+                          background_k=self.top_dielectric_k)
+
+        for z_bottom, z_top, k in self.dielectric_bands:
+            if z_top > z_min and z_bottom < z_max:
+                cs.add_dielectric(Rect(-x_max, max(z_bottom, z_min), x_max, min(z_top, z_max)), k)
+
+        if below is not None:
+            # NOTE: the plane is wide, so its shells are layers on top of it
+            self.paint_shells(cs, below, -x_max, x_max, z_min)
+
+        LT = ProcessStackInfo.LayerType
+        for shell in self.tech_info.sidewall_dielectric_shells(layer.process_layer.name):
+            if shell.layer_type == LT.LAYER_TYPE_CONFORMAL_DIELECTRIC and shell.thickness_where_no_metal > 0.0:
+                cs.add_dielectric(Rect(-x_max, layer.z_bottom, x_max, layer.z_bottom + shell.thickness_where_no_metal),
+                                  shell.dielectric_k)
+
+        x1 = 0.5 * spacing
+        self.paint_shells(cs, layer, -x1 - width, -x1, z_min)
+        self.paint_shells(cs, layer, x1, x1 + width, z_min)
+
+        wire1 = cs.add_conductor(Rect(-x1 - width, layer.z_bottom, -x1, layer.z_top))
+        wire2 = cs.add_conductor(Rect(x1, layer.z_bottom, x1 + width, layer.z_top))
+
+        # NOTE: the planes are grounded, the same as any other conductor not excited
+        cs.add_conductor(Rect(-x_max, z_min, x_max, z_min))
+        if above is not None:
+            cs.add_conductor(Rect(-x_max, z_max, x_max, z_max))
+
+        return TwoWireCrossSection(cross_section=cs, wire1=wire1, wire2=wire2)
@@ -0,0 +1,184 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+import argparse
+import os
+import os.path
+import shlex
+import sys
+import time
+from typing import *
+
+import google.protobuf.json_format
+from rich_argparse import RichHelpFormatter
+
+from klayout_pex.cross_sections.table_generator import CrossSectionTableGenerator
+from klayout_pex.log import (
+    LogLevel,
+    set_log_level,
+    info,
+    subproc,
+    error,
+    rule
+)
+from klayout_pex.tech_info import TechInfo
+from klayout_pex.util.argparse_helpers import render_enum_help
+from klayout_pex.version import __version__
+
+
+# ------------------------------------------------------------------------------------
+
+PROGRAM_NAME = "kpex_cross_sections"
+
+
+class ArgumentValidationError(Exception):
+    pass
+
+
+def float_list(s: str) -> Tuple[float, ...]:
+    return tuple(float(v) for v in s.split(','))
+
+
+class CrossSectionsCLI:
+    def parse_args(self, arg_list: List[str] = None) -> argparse.Namespace:
+        main_parser = argparse.ArgumentParser(description=f"{PROGRAM_NAME}: "
+                                                          f"Pre-solves the sidewall coupling of canonical "
+                                                          f"cross-sections with a 2D field solver, "
+                                                          f"and adds the tables to a technology file "
+                                                          f"(used by kpex/2.5D with --cross_section_tables)",
+                                              add_help=False,
+                                              formatter_class=RichHelpFormatter)
+
+        group_special = main_parser.add_argument_group("Special options")
+        group_special.add_argument("--help", "-h", action='help', help="show this help message and exit")
+        group_special.add_argument("--version", "-v", action='version', version=f'{PROGRAM_NAME} {__version__}')
+        group_special.add_argument("--log_level", dest='log_level',
+                                   default=LogLevel.DEFAULT, type=LogLevel, choices=list(LogLevel),
+                                   help=render_enum_help(topic='log_level', enum_cls=LogLevel))
+
+        main_parser.add_argument("--tech", "-t", dest="tech_pbjson_path", required=True,
+                                 help="Technology Protocol Buffer path (*.pb.json)")
+        main_parser.add_argument("--out", "-o", dest="output_tech_pbjson_path", required=True,
+                                 help="Output technology path (*.pb.json), "
+                                      "existing cross-section tables are replaced")
+        main_parser.add_argument("--layers", dest="layers", default=None,
+                                 help="Comma separated list of layers (default: all routing layers)")
+        main_parser.add_argument("--width_factors", dest="width_factors", type=float_list,
+                                 default=CrossSectionTableGenerator.width_factors,
+                                 help="Comma separated wire widths, relative to the layer thickness "
+                                      "(default is %(default)s)")
+        main_parser.add_argument("--spacing_count", dest="spacing_count", type=int,
+                                 default=CrossSectionTableGenerator.spacing_count,
+                                 help="Number of spacings per table, up to the side halo "
+                                      "(default is %(default)s)")
+        main_parser.add_argument("--resolution", dest="resolution", type=float,
+                                 default=CrossSectionTableGenerator.resolution,
+                                 help="Field solver cells per smallest feature "
+                                      "(default is %(default)s)")
+
+        if arg_list is None:
+            arg_list = sys.argv[1:]
+        args = main_parser.parse_args(arg_list)
+
+        self.validate_args(main_parser, args)
+
+        return args
+
+    @staticmethod
+    def validate_args(main_parser: argparse.ArgumentParser,
+                      args: argparse.Namespace):
+        found_errors = False
+
+        if not os.path.isfile(args.tech_pbjson_path):
+            error(f"Can't read technology file at path {args.tech_pbjson_path}")
+            found_errors = True
+
+        if args.spacing_count < 2:
+            error(f"At least 2 spacings are required")
+            found_errors = True
+
+        if len(args.width_factors) < 1 or any(f <= 0.0 for f in args.width_factors):
+            error(f"Width factors must be positive")
+            found_errors = True
+
+        if found_errors:
+            raise ArgumentValidationError("Argument validation failed")
+
+    def generate(self, args: argparse.Namespace):
+        tech_info = TechInfo.from_json(args.tech_pbjson_path,
+                                       dielectric_filter=None)
+
+        generator = CrossSectionTableGenerator(tech_info=tech_info,
+                                               width_factors=tuple(sorted(args.width_factors)),
+                                               spacing_count=args.spacing_count,
+                                               resolution=args.resolution)
+
+        layer_names: Optional[List[str]] = None
+        if args.layers is not None:
+            layer_names = [ln.strip() for ln in args.layers.split(',')]
+            available = [rl.name for rl in generator.builder.routing_layers]
+            unknown = [ln for ln in layer_names if ln not in available]
+            if unknown:
+                error(f"Unknown layer(s) {unknown}, available are: {available}")
+                sys.exit(1)
+
+        rule('Solve cross-sections')
+        start = time.perf_counter()
+        tables = generator.generate(layer_names=layer_names)
+        info(f"Solved in {time.perf_counter() - start:.1f} s")
+
+        tech = tech_info.tech
+        capacitance = tech.process_parasitics.capacitance
+        del capacitance.cross_sections[:]
+        capacitance.cross_sections.extend(tables)
+
+        with open(args.output_tech_pbjson_path, 'w') as f:
+            f.write(google.protobuf.json_format.MessageToJson(tech, preserving_proto_field_name=True))
+        subproc(f"Wrote technology with cross-section tables to: {args.output_tech_pbjson_path}")
+
+    def setup_logging(self, args: argparse.Namespace):
+        set_log_level(args.log_level)
+
+    def main(self, argv: List[str]):
+        if '-v' not in argv and \
+           '--version' not in argv and \
+           '-h' not in argv and \
+           '--help' not in argv:
+            rule('Command line arguments')
+            subproc(' '.join(map(shlex.quote, sys.argv)))
+
+        args = self.parse_args(argv[1:])
+
+        self.setup_logging(args)
+
+        try:
+            self.generate(args)
+        except ValueError as e:
+            error(f"{e}")
+            sys.exit(1)
+
+
+if __name__ == "__main__":
+    cli = CrossSectionsCLI()
+    cli.main(sys.argv)
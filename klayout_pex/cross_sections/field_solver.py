@@ -0,0 +1,270 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from __future__ import annotations
+from dataclasses import dataclass, field
+from functools import cached_property
+import math
+from typing import *
+
+import numpy as np
+
+#
+# 2D electrostatic field solver for cross-sections (all lengths in µm, capacitances in aF/µm).
+#
+# The Laplace equation div(ε·grad(V)) = 0 is discretized by finite volumes
+# on a non-uniform tensor grid, which is refined towards all geometry edges:
+#   - potentials live on the grid nodes
+#   - the dielectric constant is constant per grid cell (evaluated at the cell center)
+#   - the conductance between two neighbouring nodes is ε0 · (k-weighted half cells) / distance
+#   - nodes within (or on the border of) a conductor are fixed to its potential (Dirichlet)
+#   - the domain borders are not conductive (Neumann), unless covered by a conductor
+#
+# The system of the free nodes is solved with a (matrix free) Jacobi preconditioned CG,
+# the charge of a conductor is the net flux out of its nodes.
+#
+
+EPSILON_0 = 8.8541878128  # aF/µm
+
+
+@dataclass(frozen=True)
+class Rect:
+    x1: float
+    z1: float
+    x2: float
+    z2: float
+
+    def contains(self, x: np.ndarray, z: np.ndarray) -> np.ndarray:
+        return (x >= self.x1) & (x <= self.x2) & (z >= self.z1) & (z <= self.z2)
+
+
+@dataclass
+class CrossSection:
+    """
+    Geometry of a cross-section:
+        - dielectrics are painted in order onto the background, later ones win
+        - each conductor consists of one or more rectangles
+    """
+    domain: Rect
+    background_k: float = 1.0
+    dielectrics: List[Tuple[Rect, float]] = field(default_factory=list)
+    conductors: List[List[Rect]] = field(default_factory=list)
+
+    def add_dielectric(self, rect: Rect, k: float):
+        self.dielectrics.append((rect, k))
+
+    def add_conductor(self, *rects: Rect) -> int:
+        self.conductors.append(list(rects))
+        return len(self.conductors) - 1
+
+    def x_breakpoints(self) -> List[float]:
+        rects = [r for r, _ in self.dielectrics] + [r for c in self.conductors for r in c]
+        return [x for r in rects for x in (r.x1, r.x2)]
+
+    def z_breakpoints(self) -> List[float]:
+        rects = [r for r, _ in self.dielectrics] + [r for c in self.conductors for r in c]
+        return [z for r in rects for z in (r.z1, r.z2)]
+
+
+def graded_axis(lo: float,
+                hi: float,
+                breakpoints: Iterable[float],
+                h_min: float,
+                h_max: float,
+                growth: float = 1.3) -> np.ndarray:
+    """
+    Grid coordinates from lo to hi, containing all breakpoints within,
+    the cells start with h_min at each breakpoint and grow by the growth factor (up to h_max)
+    """
+    points = sorted({lo, hi} | {b for b in breakpoints if lo < b < hi})
+    coords = [points[0]]
+    for a, b in zip(points, points[1:]):
+        length = b - a
+        sizes: List[float] = []
+        h = h_min
+        total = 0.0
+        while total + 2.0 * h < length:
+            sizes.append(h)
+            total += 2.0 * h
+            h = min(h * growth, h_max)
+        rest = length - total
+        # NOTE: the cells growing from both ends meet in the middle,
+        #       a small remainder is shared by the two middle cells
+        if sizes and rest < 0.5 * sizes[-1]:
+            sizes[-1] += 0.5 * rest
+            steps = sizes + sizes[::-1]
+        else:
+            steps = sizes + [rest] + sizes[::-1]
+        c = a
+        for s in steps[:-1]:
+            c += s
+            coords.append(c)
+        coords.append(b)
+    return np.asarray(coords, dtype=np.float64)
+
+
+@dataclass
+class FieldSolver:
+    cross_section: CrossSection
+    h_min: float                 # smallest cell size (µm), at the geometry edges
+    h_max: float                 # largest cell size (µm)
+    growth: float = 1.3
+    tolerance: float = 1e-9      # relative residual of the CG
+    max_iterations: int = 50000
+
+    @cached_property
+    def x(self) -> np.ndarray:
+        d = self.cross_section.domain
+        return graded_axis(d.x1, d.x2, self.cross_section.x_breakpoints(), self.h_min, self.h_max, self.growth)
+
+    @cached_property
+    def z(self) -> np.ndarray:
+        d = self.cross_section.domain
+        return graded_axis(d.z1, d.z2, self.cross_section.z_breakpoints(), self.h_min, self.h_max, self.growth)
+
+    @property
+    def node_count(self) -> int:
+        return len(self.x) * len(self.z)
+
+    @cached_property
+    def cell_k(self) -> np.ndarray:
+        xc = 0.5 * (self.x[1:] + self.x[:-1])
+        zc = 0.5 * (self.z[1:] + self.z[:-1])
+        xx, zz = np.meshgrid(xc, zc, indexing='ij')
+        k = np.full(xx.shape, self.cross_section.background_k, dtype=np.float64)
+        for rect, dielectric_k in self.cross_section.dielectrics:
+            k[rect.contains(xx, zz)] = dielectric_k
+        return k
+
+    @cached_property
+    def conductances(self) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        :return: (gx, gz) between horizontal / vertical node neighbours, shapes (nx-1, nz) and (nx, nz-1)
+        """
+        dx = np.diff(self.x)
+        dz = np.diff(self.z)
+        k = self.cell_k
+
+        wx = np.zeros((len(self.x) - 1, len(self.z)))
+        wx[:, :-1] += 0.5 * k * dz[None, :]
+        wx[:, 1:] += 0.5 * k * dz[None, :]
+        gx = EPSILON_0 * wx / dx[:, None]
+
+        wz = np.zeros((len(self.x), len(self.z) - 1))
+        wz[:-1, :] += 0.5 * k * dx[:, None]
+        wz[1:, :] += 0.5 * k * dx[:, None]
+        gz = EPSILON_0 * wz / dz[None, :]
+        return gx, gz
+
+    @cached_property
+    def conductor_masks(self) -> List[np.ndarray]:
+        xx, zz = np.meshgrid(self.x, self.z, indexing='ij')
+        masks = []
+        for rects in self.cross_section.conductors:
+            m = np.zeros(xx.shape, dtype=bool)
+            for r in rects:
+                m |= r.contains(xx, zz)
+            if not m.any():
+                raise ValueError(f"Conductor {len(masks)} covers no grid node")
+            masks.append(m)
+        return masks
+
+    @cached_property
+    def free_mask(self) -> np.ndarray:
+        fixed = np.zeros((len(self.x), len(self.z)), dtype=bool)
+        for m in self.conductor_masks:
+            fixed |= m
+        return ~fixed
+
+    def apply(self, u: np.ndarray) -> np.ndarray:
+        """
+        :return: net flux out of each node (i.e. the charge) for the node potentials u
+        """
+        gx, gz = self.conductances
+        fx = gx * (u[1:, :] - u[:-1, :])
+        fz = gz * (u[:, 1:] - u[:, :-1])
+        r = np.zeros_like(u)
+        r[:-1, :] -= fx
+        r[1:, :] += fx
+        r[:, :-1] -= fz
+        r[:, 1:] += fz
+        return r
+
+    @cached_property
+    def diagonal(self) -> np.ndarray:
+        gx, gz = self.conductances
+        d = np.zeros((len(self.x), len(self.z)))
+        d[:-1, :] += gx
+        d[1:, :] += gx
+        d[:, :-1] += gz
+        d[:, 1:] += gz
+        return d
+
+    def potentials(self, conductor_potentials: Sequence[float]) -> np.ndarray:
+        free = self.free_mask
+        u_fixed = np.zeros(free.shape)
+        for m, v in zip(self.conductor_masks, conductor_potentials):
+            u_fixed[m] = v
+
+        b = -self.apply(u_fixed) * free
+        inv_diag = np.where(free, 1.0 / np.maximum(self.diagonal, 1e-300), 0.0)
+
+        x = np.zeros(free.shape)
+        r = b.copy()
+        z = inv_diag * r
+        p = z.copy()
+        rz = float(np.vdot(r, z))
+        b_norm = math.sqrt(float(np.vdot(b, b)))
+        if b_norm == 0.0:
+            return u_fixed
+        for _ in range(self.max_iterations):
+            ap = self.apply(p) * free
+            alpha = rz / float(np.vdot(p, ap))
+            x += alpha * p
+            r -= alpha * ap
+            if math.sqrt(float(np.vdot(r, r))) <= self.tolerance * b_norm:
+                break
+            z = inv_diag * r
+            rz_next = float(np.vdot(r, z))
+            p = z + (rz_next / rz) * p
+            rz = rz_next
+        else:
+            raise RuntimeError(f"Field solver did not converge within {self.max_iterations} iterations")
+        return x + u_fixed
+
+    def charges(self, excited_conductor: int) -> np.ndarray:
+        """
+        Charges (aF/µm) of all conductors, for 1 V at the excited conductor and 0 V at all others,
+        i.e. a column of the Maxwell capacitance matrix
+        """
+        potentials = [0.0] * len(self.cross_section.conductors)
+        potentials[excited_conductor] = 1.0
+        q = self.apply(self.potentials(potentials))
+        return np.asarray([float(q[m].sum()) for m in self.conductor_masks])
+
+    def coupling(self, conductor1: int, conductor2: int) -> float:
+        """
+        Coupling capacitance (aF/µm) between two conductors
+        """
+        return -float(self.charges(conductor1)[conductor2])
@@ -0,0 +1,140 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from __future__ import annotations
+from dataclasses import dataclass
+from functools import cached_property
+import time
+from typing import *
+
+import numpy as np
+
+from klayout_pex.cross_sections.cross_section_builder import CrossSectionBuilder, RoutingLayer
+from klayout_pex.cross_sections.field_solver import FieldSolver
+from klayout_pex.log import (
+    info,
+    subproc,
+)
+from klayout_pex.tech_info import TechInfo
+from klayout_pex_protobuf.kpex.tech.process_parasitics_pb2 import CapacitanceInfo
+
+#
+# Offline generation of the sidewall coupling tables (CapacitanceInfo.CrossSectionTable),
+# one table per routing layer and environment, each sample is one field solver run:
+#
+#   - widths are multiples of the layer thickness (width_factors)
+#   - spacings are a geometric sequence from a fraction of the thickness up to the side halo
+#   - environments are the substrate or the next routing layer below,
+#     and no plane or the next routing layer above
+#
+
+
+@dataclass
+class CrossSectionTableGenerator:
+    tech_info: TechInfo
+    width_factors: Tuple[float, ...] = (0.5, 1.0, 2.0, 4.0)
+    spacing_count: int = 8
+    min_spacing_factor: float = 0.25
+    resolution: float = 12.0       # cells per smallest feature (at the geometry edges)
+    growth: float = 1.3
+
+    @cached_property
+    def builder(self) -> CrossSectionBuilder:
+        return CrossSectionBuilder(tech_info=self.tech_info)
+
+    def environments(self, layer_name: str) -> List[Tuple[str, str]]:
+        """
+        (below_layer_name, above_layer_name), empty names are the substrate / no plane
+        """
+        layers = [rl.name for rl in self.builder.routing_layers]
+        idx = layers.index(layer_name)
+        below = [''] + ([layers[idx - 1]] if idx >= 1 else [])
+        above = [''] + ([layers[idx + 1]] if idx + 1 < len(layers) else [])
+        return [(b, a) for b in below for a in above]
+
+    def widths(self, layer: RoutingLayer) -> List[float]:
+        thickness = layer.z_top - layer.z_bottom
+        return [round(f * thickness, 4) for f in self.width_factors]
+
+    def spacings(self, layer: RoutingLayer) -> List[float]:
+        thickness = layer.z_top - layer.z_bottom
+        side_halo = self.tech_info.tech.process_parasitics.side_halo
+        s_min = self.min_spacing_factor * thickness
+        return [round(s, 4) for s in np.geomspace(s_min, max(side_halo, 2.0 * s_min), self.spacing_count)]
+
+    @property
+    def solver_description(self) -> str:
+        return f"kpex 2D finite volume, {self.resolution:g} cells per min(width, spacing, thickness), " \
+               f"growth {self.growth:g}"
+
+    def coupling(self,
+                 layer_name: str,
+                 width: float,
+                 spacing: float,
+                 below_layer_name: str,
+                 above_layer_name: str) -> float:
+        """
+        :return: coupling capacitance of the two wires in aF/µm
+        """
+        tw = self.builder.two_wires(layer_name=layer_name, width=width, spacing=spacing,
+                                    below_layer_name=below_layer_name, above_layer_name=above_layer_name)
+        layer = self.builder.routing_layer_by_name[layer_name]
+        thickness = layer.z_top - layer.z_bottom
+        solver = FieldSolver(cross_section=tw.cross_section,
+                             h_min=min(width, spacing, thickness) / self.resolution,
+                             h_max=max(2.0 * thickness, 0.5 * (width + spacing)),
+                             growth=self.growth)
+        return solver.coupling(tw.wire1, tw.wire2)
+
+    def table(self,
+              layer_name: str,
+              below_layer_name: str,
+              above_layer_name: str) -> CapacitanceInfo.CrossSectionTable:
+        layer = self.builder.routing_layer_by_name[layer_name]
+        t = CapacitanceInfo.CrossSectionTable(layer_name=layer_name,
+                                              below_layer_name=below_layer_name,
+                                              above_layer_name=above_layer_name,
+                                              solver=self.solver_description)
+        t.widths.extend(self.widths(layer))
+        t.spacings.extend(self.spacings(layer))
+        for w in t.widths:
+            for s in t.spacings:
+                t.coupling.append(self.coupling(layer_name=layer_name, width=w, spacing=s,
+                                                below_layer_name=below_layer_name,
+                                                above_layer_name=above_layer_name))
+        return t
+
+    def generate(self, layer_names: Optional[List[str]] = None) -> List[CapacitanceInfo.CrossSectionTable]:
+        tables = []
+        for rl in self.builder.routing_layers:
+            if layer_names is not None and rl.name not in layer_names:
+                continue
+            for below, above in self.environments(rl.name):
+                start = time.perf_counter()
+                t = self.table(layer_name=rl.name, below_layer_name=below, above_layer_name=above)
+                subproc(f"{rl.name} (below: {below or 'substrate'}, above: {above or 'none'}): "
+                        f"{len(t.coupling)} samples in {time.perf_counter() - start:.1f} s")
+                tables.append(t)
+        info(f"Generated {len(tables)} cross-section table(s)")
+        return tables
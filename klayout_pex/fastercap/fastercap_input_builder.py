@@ -36,6 +36,7 @@ import math
 import klayout.db as kdb
 
 from ..klayout.lvsdb_extractor import KLayoutExtractionContext, GDSPair
+from ..klayout.via_arrays import ViaArrayHomogenizer
 from .fastercap_model_generator import FasterCapModelBuilder, FasterCapModelGenerator
 from ..log import (
     console,
@@ -55,12 +56,17 @@ class FasterCapInputBuilder:
                  tech_info: TechInfo,
                  k_void: float = 3.5,
                  delaunay_amax: float = 0.0,
-                 delaunay_b: float = 1.0):
+                 delaunay_b: float = 1.0,
+                 via_arrays: bool = False):
+        """
+        :param via_arrays: replace regular via / contact cut arrays by one block each
+        """
         self.pex_context = pex_context
         self.tech_info = tech_info
         self.k_void = k_void
         self.delaunay_amax = delaunay_amax
         self.delaunay_b = delaunay_b
+        self.via_arrays = via_arrays
 
     @cached_property
     def dbu(self) -> float:
@@ -95,6 +101,14 @@ class FasterCapInputBuilder:
             debug(f"Nothing extracted for layer {layer_name}")
         return shapes
 
+    def contact_shapes_of_net(self,
+                              contact: process_stack_pb2.ProcessStackInfo.Contact,
+                              net: kdb.Net) -> Optional[kdb.Region]:
+        shapes = self.shapes_of_net(layer_name=contact.name, net=net)
+        if shapes and self.via_arrays:
+            shapes = ViaArrayHomogenizer(dbu=self.dbu).for_capacitance(shapes, contact)
+        return shapes
+
     def top_cell_bbox(self) -> kdb.Box:
         return self.pex_context.top_cell_bbox()
 
@@ -156,7 +170,7 @@ class FasterCapInputBuilder:
 
                 if metal_layer.HasField('contact_above'):
                     contact = metal_layer.contact_above
-                    shapes = self.shapes_of_net(layer_name=contact.name, net=net)
+                    shapes = self.contact_shapes_of_net(contact=contact, net=net)
                     if shapes and not shapes.is_empty():
                         info(f"Conductor {net_name}, via {contact.name}, "
                              f"z={metal_z_top}, height={contact.thickness}")
@@ -179,15 +193,16 @@ class FasterCapInputBuilder:
                 shapes = self.shapes_of_net(layer_name=diffusion_layer_name, net=net)
                 if shapes and not shapes.is_empty():
                     diffusion_regions.append(shapes)
+                    diff_z_bottom, diff_z_top = self.tech_info.diffusion_z_interval_by_name[diffusion_layer_name]
                     info(f"Diffusion {net_name}, layer {diffusion_layer_name}, "
-                         f"z={0}, height={0.1}")
+                         f"z={diff_z_bottom}, height={diff_z_top - diff_z_bottom}")
                     model_builder.add_conductor(net_name=net_name,
                                                 layer=shapes,
-                                                z=0,  # TODO
-                                                height=0.1)  # TODO: diffusion_layer.z
+                                                z=diff_z_bottom,
+                                                height=diff_z_top - diff_z_bottom)
 
                 contact = diffusion_layer.contact_above
-                shapes = self.shapes_of_net(layer_name=contact.name, net=net)
+                shapes = self.contact_shapes_of_net(contact=contact, net=net)
                 if shapes and not shapes.is_empty():
                     info(f"Diffusion {net_name}, contact {contact.name}, "
                          f"z={0}, height={contact.thickness}")
@@ -257,53 +272,40 @@ class FasterCapInputBuilder:
             if extracted_shapes:
                 sidewall_height = 0
                 sidewall_region = extracted_shapes
-                sidewallee = metal_layer_name
 
-                while True:
-                    sidewall = self.tech_info.sidewall_dielectric_layer(sidewallee)
-                    if not sidewall:
-                        break
-                    match sidewall.layer_type:
+                # NOTE: shells are innermost first, their height is accumulated (relative to the metal bottom)
+                for shell in self.tech_info.sidewall_dielectric_shells(metal_layer_name):
+                    d = math.floor(shell.width_outside / self.dbu)
+                    sidewall_region = sidewall_region.sized(d)
+                    sidewall_height = shell.height
+                    match shell.layer_type:
                         case process_stack_pb2.ProcessStackInfo.LAYER_TYPE_SIDEWALL_DIELECTRIC:
-                            d = math.floor(sidewall.sidewall_dielectric_layer.width_outside_sidewall / self.dbu)
-                            sidewall_region = sidewall_region.sized(d)
-                            h_delta = sidewall.sidewall_dielectric_layer.height_above_metal or metal_layer.thickness
-                            # if h_delta == 0:
-                            #     h_delta = metal_layer.thickness
-                            sidewall_height += h_delta
-                            info(f"Sidewall dielectric {sidewall.name}: z={metal_layer.z}, height={sidewall_height}")
-                            model_builder.add_dielectric(material_name=sidewall.name,
+                            info(f"Sidewall dielectric {shell.name}: z={metal_layer.z}, height={sidewall_height}")
+                            model_builder.add_dielectric(material_name=shell.name,
                                                          layer=sidewall_region,
                                                          z=metal_layer.z,
                                                          height=sidewall_height)
 
                         case process_stack_pb2.ProcessStackInfo.LAYER_TYPE_CONFORMAL_DIELECTRIC:
-                            conf_diel = sidewall.conformal_dielectric_layer
-                            d = math.floor(conf_diel.thickness_sidewall / self.dbu)
-                            sidewall_region = sidewall_region.sized(d)
-                            h_delta = metal_layer.thickness + conf_diel.thickness_over_metal
-                            sidewall_height += h_delta
-                            info(f"Conformal dielectric (sidewall) {sidewall.name}: "
+                            info(f"Conformal dielectric (sidewall) {shell.name}: "
                                  f"z={metal_layer.z}, height={sidewall_height}")
-                            model_builder.add_dielectric(material_name=sidewall.name,
+                            model_builder.add_dielectric(material_name=shell.name,
                                                          layer=sidewall_region,
                                                          z=metal_layer.z,
                                                          height=sidewall_height)
-                            if conf_diel.thickness_where_no_metal > 0.0:
+                            if shell.thickness_where_no_metal > 0.0:
                                 no_metal_block = enlarged_top_cell_bbox.dup()
                                 no_metal_region = kdb.Region()
                                 no_metal_region.insert(no_metal_block)
                                 no_metal_region -= sidewall_region
-                                no_metal_height = conf_diel.thickness_where_no_metal
-                                info(f"Conformal dielectric (where no metal) {sidewall.name}: "
+                                no_metal_height = shell.thickness_where_no_metal
+                                info(f"Conformal dielectric (where no metal) {shell.name}: "
                                      f"z={metal_layer.z}, height={no_metal_height}")
-                                model_builder.add_dielectric(material_name=sidewall.name,
+                                model_builder.add_dielectric(material_name=shell.name,
                                                              layer=no_metal_region,
                                                              z=metal_layer.z,
                                                              height=no_metal_height)
 
-                    sidewallee = sidewall.name
-
             #
             # add simple dielectric
             #
@@ -0,0 +1,160 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from __future__ import annotations
+
+from dataclasses import dataclass, field
+from functools import cached_property
+from typing import *
+
+import klayout.db as kdb
+
+from ..log import (
+    debug,
+)
+from ..rcx25.c.box_kernels import BoxTuple, rectilinear_boxes
+
+GDSPair = Tuple[int, int]
+NetName = str
+
+
+def flatten_regions(regions: List[kdb.Region]) -> kdb.Region:
+    """
+    Combines several (possibly hierarchical) regions into one flat region,
+    keeping the 'net' property of each shape
+    """
+    # NOTE: currently a bug, for now use polygon-per-polygon workaround
+    # shapes = kdb.Region()
+    # for sl in lyr.source_layers:
+    #     shapes += sl.region
+    shapes = kdb.Region()
+    shapes.enable_properties()
+    for region in regions:
+        iter, transform = region.begin_shapes_rec()
+        while not iter.at_end():
+            p = kdb.PolygonWithProperties(iter.shape().polygon, {'net': iter.shape().property('net')})
+            shapes.insert(transform *     # NOTE: this is a global/initial iterator-wide transformation
+                          iter.trans() *  # NOTE: this is local during the iteration (due to sub hierarchy)
+                          p)
+            iter.next()
+    return shapes
+
+
+@dataclass
+class LayerGeometry:
+    """
+    Derived geometry of one layer, each aspect is computed lazily on first use.
+
+    NOTE: the regions handed out are shared between all users of the cache,
+          callers must not modify them in place (use the non-destructive kdb.Region methods)
+    """
+    region: kdb.Region
+
+    @cached_property
+    def merged(self) -> kdb.Region:
+        # NOTE: shapes with different 'net' properties are not merged with each other
+        return self.region.merged()
+
+    @cached_property
+    def polygons(self) -> List[kdb.PolygonWithProperties]:
+        return list(self.region.each())
+
+    @cached_property
+    def bboxes(self) -> List[kdb.Box]:
+        return [p.bbox() for p in self.polygons]
+
+    @cached_property
+    def rectangles(self) -> List[Optional[List[BoxTuple]]]:
+        """
+        :return: per polygon (same order as `polygons`) the rectangle decomposition,
+                 or None if the polygon is not rectilinear
+        """
+        return [rectilinear_boxes(p) for p in self.polygons]
+
+    @cached_property
+    def is_rectilinear(self) -> bool:
+        return all(boxes is not None for boxes in self.rectangles)
+
+    @cached_property
+    def edges(self) -> kdb.Edges:
+        return self.merged.edges()
+
+    @cached_property
+    def shapes_by_net(self) -> Dict[NetName, kdb.Region]:
+        shapes: Dict[NetName, kdb.Region] = {}
+        iter, transform = self.region.begin_shapes_rec()
+        while not iter.at_end():
+            shape = iter.shape()
+            net_name = shape.property('net')
+            r = shapes.get(net_name, None)
+            if r is None:
+                r = kdb.Region()
+                r.enable_properties()
+                shapes[net_name] = r
+            r.insert(transform *     # NOTE: this is a global/initial iterator-wide transformation
+                     iter.trans() *  # NOTE: this is local during the iteration (due to sub hierarchy)
+                     shape.polygon)
+            iter.next()
+        return shapes
+
+
+@dataclass
+class GeometryCache:
+    """
+    Per layer geometry cache, shared by all engines of one kpex run
+    (overlap / sidewall passes, R extraction, FasterCap input builder).
+
+    An entry is derived once from the source regions of its layer,
+    and kept until invalidate() is called, i.e. whoever replaces or modifies
+    the source regions must invalidate the cache (see KLayoutExtractionContext).
+    """
+    source_regions_of_layer: Callable[[GDSPair], Optional[List[kdb.Region]]]
+    entries: Dict[GDSPair, LayerGeometry] = field(default_factory=dict)
+
+    def layer(self, gds_pair: GDSPair) -> Optional[LayerGeometry]:
+        entry = self.entries.get(gds_pair, None)
+        if entry is not None:
+            return entry
+
+        regions = self.source_regions_of_layer(gds_pair)
+        if not regions:
+            return None
+
+        match len(regions):
+            case 1:
+                region = regions[0]
+            case _:
+                region = flatten_regions(regions)
+
+        entry = LayerGeometry(region=region)
+        self.entries[gds_pair] = entry
+        return entry
+
+    def invalidate(self, gds_pair: Optional[GDSPair] = None):
+        if gds_pair is None:
+            debug("Invalidating the cached geometry of all layers")
+            self.entries.clear()
+        else:
+            debug(f"Invalidating the cached geometry of layer {gds_pair}")
+            self.entries.pop(gds_pair, None)
@@ -42,7 +42,8 @@ from ..log import (
     rule
 )
 
-from .shapes_pb2_converter import ShapesConverter
+from .geometry_cache import GeometryCache, LayerGeometry
+from .shapes_pb2_converter import shapes_converter
 
 from ..tech_info import TechInfo
 import klayout_pex_protobuf.kpex.geometry.shapes_pb2 as shapes_pb2
@@ -84,6 +85,13 @@ class KLayoutExtractionContext:
     extracted_layers: Dict[GDSPair, KLayoutMergedExtractedLayerInfo]
     unnamed_layers: List[KLayoutExtractedLayerInfo]
 
+    def __setattr__(self, name: str, value: Any):
+        super().__setattr__(name, value)
+        # NOTE: the cached geometry is derived from the extracted layers,
+        #       rebuilding them invalidates it (if the cache was created already)
+        if name == 'extracted_layers' and 'geometry_cache' in self.__dict__:
+            self.geometry_cache.invalidate()
+
     @classmethod
     def prepare_extraction(cls,
                            lvsdb: kdb.LayoutToNetlist,
@@ -262,65 +270,41 @@ class KLayoutExtractionContext:
         else:
             return b2
 
-    def shapes_of_net(self, gds_pair: GDSPair, net: kdb.Net | str) -> Optional[kdb.Region]:
+    def source_regions_of_layer(self, gds_pair: GDSPair) -> Optional[List[kdb.Region]]:
         lyr = self.extracted_layers.get(gds_pair, None)
         if not lyr:
             return None
+        if len(lyr.source_layers) == 0:
+            raise AssertionError('Internal error: Empty list of source_layers')
+        return [sl.region for sl in lyr.source_layers]
+
+    @cached_property
+    def geometry_cache(self) -> GeometryCache:
+        return GeometryCache(source_regions_of_layer=self.source_regions_of_layer)
+
+    def geometry_of_layer(self, gds_pair: GDSPair) -> Optional[LayerGeometry]:
+        return self.geometry_cache.layer(gds_pair)
 
-        shapes = kdb.Region()
-        shapes.enable_properties()
+    def shapes_of_net(self, gds_pair: GDSPair, net: kdb.Net | str) -> Optional[kdb.Region]:
+        geometry = self.geometry_of_layer(gds_pair)
+        if not geometry:
+            return None
 
         requested_net_name = net.name if isinstance(net, kdb.Net) else net
 
-        def add_shapes_from_region(source_region: kdb.Region):
-            iter, transform = source_region.begin_shapes_rec()
-            while not iter.at_end():
-                shape = iter.shape()
-                net_name = shape.property('net')
-                if net_name == requested_net_name:
-                    shapes.insert(transform *     # NOTE: this is a global/initial iterator-wide transformation
-                                  iter.trans() *  # NOTE: this is local during the iteration (due to sub hierarchy)
-                                  shape.polygon)
-                iter.next()
-
-        match len(lyr.source_layers):
-            case 0:
-                raise AssertionError('Internal error: Empty list of source_layers')
-            case _:
-                for sl in lyr.source_layers:
-                    add_shapes_from_region(sl.region)
-
-        return shapes
+        # NOTE: return a copy, the cached region is shared
+        shapes = geometry.shapes_by_net.get(requested_net_name, None)
+        if shapes is None:
+            shapes = kdb.Region()
+            shapes.enable_properties()
+            return shapes
+        return shapes.dup()
 
     def shapes_of_layer(self, gds_pair: GDSPair) -> Optional[kdb.Region]:
-        lyr = self.extracted_layers.get(gds_pair, None)
-        if not lyr:
+        geometry = self.geometry_of_layer(gds_pair)
+        if not geometry:
             return None
-
-        shapes: kdb.Region
-
-        match len(lyr.source_layers):
-            case 0:
-                raise AssertionError('Internal error: Empty list of source_layers')
-            case 1:
-                shapes = lyr.source_layers[0].region
-            case _:
-                # NOTE: currently a bug, for now use polygon-per-polygon workaround
-                # shapes = kdb.Region()
-                # for sl in lyr.source_layers:
-                #     shapes += sl.region
-                shapes = kdb.Region()
-                shapes.enable_properties()
-                for sl in lyr.source_layers:
-                    iter, transform = sl.region.begin_shapes_rec()
-                    while not iter.at_end():
-                        p = kdb.PolygonWithProperties(iter.shape().polygon, {'net': iter.shape().property('net')})
-                        shapes.insert(transform *     # NOTE: this is a global/initial iterator-wide transformation
-                                      iter.trans() *  # NOTE: this is local during the iteration (due to sub hierarchy)
-                                      p)
-                        iter.next()
-
-        return shapes
+        return geometry.region
 
     def pins_of_layer(self, gds_pair: GDSPair) -> kdb.Region:
         pin_gds_pair = self.tech.layer_info_by_gds_pair[gds_pair].pin_gds_pair
@@ -354,7 +338,7 @@ class KLayoutExtractionContext:
     def devices_by_name(self) -> Dict[str, device_pb2.Device]:
         dd = {}
 
-        shapes_converter = ShapesConverter(dbu=self.dbu)
+        converter = shapes_converter(dbu=self.dbu)
 
         for d_kly in self.top_circuit.each_device():
             # https://www.klayout.de/doc-qt5/code/class_Device.html
@@ -413,7 +397,7 @@ class KLayoutExtractionContext:
                         region_by_layer.layer.id = lyr_idx
                         region_by_layer.layer.canonical_layer_name = self.tech.canonical_layer_name_by_gds_pair[lyr_info.layer, lyr_info.datatype]
 
-                        shapes_converter.klayout_region_to_pb(shapes, region_by_layer.region)
+                        converter.klayout_region_to_pb(shapes, region_by_layer.region)
 
             dd[d.device_name] = d
 
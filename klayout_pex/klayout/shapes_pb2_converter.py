@@ -24,6 +24,7 @@
 
 import klayout.db as kdb
 import klayout_pex_protobuf.kpex.geometry.shapes_pb2 as shapes_pb2
+import klayout_pex.native as native
 
 
 class ShapesConverter:
@@ -116,3 +117,32 @@ class ShapesConverter:
                              region_pb: shapes_pb2.Region):
         for sh_kly in region_kly:
             self.klayout_polygon_to_pb(sh_kly, region_pb.shapes.add())
+
+
+class NativeShapesConverter(ShapesConverter):
+    """
+    Same message layout as ShapesConverter, but regions and polygons are converted
+    by the native extension (see klayout_pex.native), without Python work per vertex
+    """
+
+    def klayout_polygon_to_pb(self,
+                              polygon_kly: kdb.Polygon,
+                              shape_pb: shapes_pb2.Shape):
+        native.polygon_to_pb(polygon_kly, shape_pb)
+
+    def klayout_region(self, region: shapes_pb2.Region) -> kdb.Region:
+        return native.region_from_pb(region)
+
+    def klayout_region_to_pb(self,
+                             region_kly: kdb.Region,
+                             region_pb: shapes_pb2.Region):
+        native.region_to_pb(region_kly, region_pb)
+
+
+def shapes_converter(dbu: float) -> ShapesConverter:
+    """
+    :return: the native converter if the extension is built, otherwise the Python one
+    """
+    if native.native_available():
+        return NativeShapesConverter(dbu=dbu)
+    return ShapesConverter(dbu=dbu)
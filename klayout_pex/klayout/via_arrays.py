@@ -0,0 +1,263 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+#
+# Via-array homogenisation
+#
+# Cut arrays (many small via / contact cuts between the same two conductors) are replaced
+# by a single equivalent shape, to keep the FasterCap panel count and the R mesh small:
+#
+#   - capacitance: a regular array is replaced by one block covering its envelope.
+#                  The outer envelope is unchanged, only the gaps between the cuts (≤ spacing)
+#                  are filled. As the cuts are enclosed by the metals below and above,
+#                  the capacitance error is bounded by the sidewall coupling of the filled gaps
+#                  on the envelope, i.e. at most spacing / (width + spacing) of the envelope
+#                  sidewall capacitance of the array.
+#
+#   - resistance: KLayout computes the via resistance as (resistance per cut * width²) / area,
+#                 so an array (or a drawn via larger than one cut) is replaced by a centered
+#                 block with the area of N cuts, where N follows the contact rules
+#                 (width, spacing, border), just like the cut generation of the mask data.
+#                 The parallel resistance R_cut / N is exact (up to DBU rounding),
+#                 the spreading resistance within the array footprint is neglected,
+#                 which is bounded by one square of the bottom and the top conductor each.
+#
+
+from __future__ import annotations
+from collections import defaultdict
+from dataclasses import dataclass
+import math
+from typing import *
+
+import klayout.db as kdb
+
+from ..log import (
+    debug,
+)
+from ..rcx25.c.box_kernels import BoxTuple
+
+import klayout_pex_protobuf.kpex.tech.process_stack_pb2 as process_stack_pb2
+
+Contact = process_stack_pb2.ProcessStackInfo.Contact
+
+
+def cuts_per_extent(extent_um: float, contact: Contact) -> int:
+    """
+    :return: number of cuts along one side of a drawn via of the given extent
+    """
+    pitch = contact.width + contact.spacing
+    if contact.width <= 0.0 or pitch <= 0.0:
+        return 1
+    n = math.floor((extent_um - 2.0 * contact.border + contact.spacing) / pitch + 1e-9)
+    return max(1, n)
+
+
+def cut_count(box: BoxTuple, contact: Contact, dbu: float) -> int:
+    """
+    :return: number of cuts of a drawn via box according to the contact rules
+    """
+    left, bottom, right, top = box
+    return cuts_per_extent((right - left) * dbu, contact) * cuts_per_extent((top - bottom) * dbu, contact)
+
+
+def envelope(boxes: Iterable[BoxTuple]) -> BoxTuple:
+    lefts, bottoms, rights, tops = zip(*boxes)
+    return min(lefts), min(bottoms), max(rights), max(tops)
+
+
+def cluster_boxes(boxes: List[BoxTuple], max_gap: int) -> List[List[int]]:
+    """
+    Groups boxes, where neighbors are at most max_gap apart (in x and y)
+
+    :return: box indices per cluster
+    """
+    parent = list(range(len(boxes)))
+
+    def find(i: int) -> int:
+        while parent[i] != i:
+            parent[i] = parent[parent[i]]
+            i = parent[i]
+        return i
+
+    if not boxes:
+        return []
+
+    # NOTE: grid hashing, neighbors can only be in the adjacent grid cells
+    cell_size = max(max(r - l, t - b) for l, b, r, t in boxes) + max_gap
+    grid: Dict[Tuple[int, int], List[int]] = defaultdict(list)
+    for i, (l, b, r, t) in enumerate(boxes):
+        grid[(l // cell_size, b // cell_size)].append(i)
+
+    for (cx, cy), indices in grid.items():
+        for dx in (-1, 0, 1):
+            for dy in (-1, 0, 1):
+                for j in grid.get((cx + dx, cy + dy), ()):
+                    for i in indices:
+                        if j <= i:
+                            continue
+                        li, bi, ri, ti = boxes[i]
+                        lj, bj, rj, tj = boxes[j]
+                        gap_x = max(lj - ri, li - rj, 0)
+                        gap_y = max(bj - ti, bi - tj, 0)
+                        if gap_x <= max_gap and gap_y <= max_gap:
+                            parent[find(i)] = find(j)
+
+    clusters: Dict[int, List[int]] = defaultdict(list)
+    for i in range(len(boxes)):
+        clusters[find(i)].append(i)
+    return list(clusters.values())
+
+
+def is_regular_array(boxes: List[BoxTuple]) -> bool:
+    """
+    :return: True if the boxes have identical size and form a complete grid with uniform pitch
+    """
+    sizes = {(r - l, t - b) for l, b, r, t in boxes}
+    if len(sizes) != 1:
+        return False
+    lefts = sorted({l for l, b, r, t in boxes})
+    bottoms = sorted({b for l, b, r, t in boxes})
+    if len(lefts) * len(bottoms) != len(boxes) or len({(l, b) for l, b, r, t in boxes}) != len(boxes):
+        return False
+    for coords in (lefts, bottoms):
+        if len({c2 - c1 for c1, c2 in zip(coords, coords[1:])}) > 1:
+            return False
+    return True
+
+
+def equivalent_box(box: BoxTuple, area_dbu2: float) -> BoxTuple:
+    """
+    :return: box with the same center and aspect ratio, scaled to the given area (at most the box itself)
+    """
+    left, bottom, right, top = box
+    width = right - left
+    height = top - bottom
+    f = min(1.0, math.sqrt(area_dbu2 / (width * height)))
+    w2 = max(1, round(width * f))
+    h2 = max(1, round(height * f))
+    cx = (left + right) // 2
+    cy = (bottom + top) // 2
+    return cx - w2 // 2, cy - h2 // 2, cx - w2 // 2 + w2, cy - h2 // 2 + h2
+
+
+@dataclass
+class ViaArray:
+    box_indices: List[int]
+    envelope: BoxTuple
+    cut_count: int  # according to the contact rules
+
+
+def find_via_arrays(boxes: List[BoxTuple],
+                    contact: Contact,
+                    dbu: float,
+                    min_cuts: int) -> List[ViaArray]:
+    """
+    :return: the regular arrays of at least min_cuts drawn cuts
+    """
+    pitch = round((contact.width + contact.spacing) / dbu)
+    arrays: List[ViaArray] = []
+    for indices in cluster_boxes(boxes, max_gap=pitch):
+        if len(indices) < min_cuts:
+            continue
+        cluster = [boxes[i] for i in indices]
+        if not is_regular_array(cluster):
+            continue
+        arrays.append(ViaArray(box_indices=indices,
+                               envelope=envelope(cluster),
+                               cut_count=sum(cut_count(b, contact, dbu) for b in cluster)))
+    return arrays
+
+
+class ViaArrayHomogenizer:
+    def __init__(self,
+                 dbu: float,
+                 min_cuts: int = 4):
+        """
+        :param dbu: database unit in µm
+        :param min_cuts: minimum number of drawn cuts of an array to be homogenized
+        """
+        self.dbu = dbu
+        self.min_cuts = min_cuts
+
+    @staticmethod
+    def split_boxes(region: kdb.Region) -> Tuple[List[BoxTuple], List[kdb.Polygon]]:
+        boxes: List[BoxTuple] = []
+        others: List[kdb.Polygon] = []
+        for p in region.each():
+            if p.is_box():
+                b = p.bbox()
+                boxes.append((b.left, b.bottom, b.right, b.top))
+            else:
+                others.append(p)
+        return boxes, others
+
+    @staticmethod
+    def to_region(boxes: Iterable[BoxTuple], others: List[kdb.Polygon]) -> kdb.Region:
+        # NOTE: the regions are per net, so the boxes are inserted without their 'net' property
+        region = kdb.Region()
+        region.enable_properties()
+        for l, b, r, t in boxes:
+            region.insert(kdb.Box(l, b, r, t))
+        for p in others:
+            region.insert(p)
+        return region
+
+    def for_capacitance(self, region: kdb.Region, contact: Contact) -> kdb.Region:
+        """
+        :return: region, where each regular cut array is replaced by its envelope
+        """
+        boxes, others = self.split_boxes(region)
+        arrays = find_via_arrays(boxes, contact, self.dbu, self.min_cuts)
+        if not arrays:
+            return region
+
+        replaced = {i for a in arrays for i in a.box_indices}
+        result = [b for i, b in enumerate(boxes) if i not in replaced]
+        result.extend(a.envelope for a in arrays)
+        debug(f"Via {contact.name}: homogenized {len(replaced)} cuts into {len(arrays)} block(s) (capacitance)")
+        return self.to_region(result, others)
+
+    def for_resistance(self, region: kdb.Region, contact: Contact) -> kdb.Region:
+        """
+        :return: region, where each regular cut array and each drawn via larger than one cut
+                 is replaced by a block with the area of its number of cuts
+        """
+        if contact.width <= 0.0:
+            return region
+
+        boxes, others = self.split_boxes(region)
+        arrays = find_via_arrays(boxes, contact, self.dbu, self.min_cuts)
+        cut_area = (contact.width / self.dbu) ** 2
+
+        replaced = {i for a in arrays for i in a.box_indices}
+        result = [equivalent_box(a.envelope, a.cut_count * cut_area) for a in arrays]
+        for i, b in enumerate(boxes):
+            if i in replaced:
+                continue
+            # NOTE: drawn vias larger than one cut are arrays according to the contact rules
+            result.append(equivalent_box(b, cut_count(b, contact, self.dbu) * cut_area))
+
+        if arrays:
+            debug(f"Via {contact.name}: homogenized {len(replaced)} cuts into {len(arrays)} block(s) (resistance)")
+        return self.to_region(result, others)
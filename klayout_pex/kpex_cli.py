@@ -80,6 +80,11 @@ from .magic.magic_runner import (
 from .magic.magic_log_analyzer import MagicLogAnalyzer
 from .pdk_config import PDK, PDKConfig
 from .rcx25.extractor import RCX25Extractor, ExtractionResults
+from .rcx25.r.packed_r_network import RNetworkFormat
+from .rcx25.sensitivities import SensitivityExtractor
+from .rcx25.c.overlap_sweep import OverlapEngine
+from .rcx25.result_mode import ResultMode
+from .rcx25.report_level import ReportLevel
 from .rcx25.netlist_expander import RCX25NetlistExpander
 from .rcx25.pex_mode import PEXMode
 from .tech_info import TechInfo
@@ -184,6 +189,12 @@ class KpexCLI:
         group_pex_options.add_argument("--2.5D", dest="run_2_5D",
                                       action='store_true', default=False,
                                       help="Run 2.5D analytical engine (default is %(default)s)")
+        group_pex_options.add_argument("--via_arrays", dest="via_arrays",
+                                      type=true_or_false, default=False,
+                                      help="Homogenize via / contact cut arrays: one block per array "
+                                           "for FasterCap, one block with the area of the cuts (following "
+                                           "the contact rules) for the 2.5D R extraction "
+                                           "(default is %(default)s)")
 
         group_fastercap = main_parser.add_argument_group("FasterCap options")
         group_fastercap.add_argument("--k_void", "-k", dest="k_void",
@@ -279,6 +290,70 @@ class KpexCLI:
         group_25d.add_argument("--scale", dest="scale_ratio_to_fit_halo",
                                 type=true_or_false, default=True,
                                 help=f"Scale fringe ratios, so that halo distance is 100%% (default is %(default)s)")
+        group_25d.add_argument("--r_format", dest='r_network_format',
+                               default=RNetworkFormat.DEFAULT, type=RNetworkFormat, choices=list(RNetworkFormat),
+                               help=render_enum_help(topic='r_format', enum_cls=RNetworkFormat))
+        group_25d.add_argument("--results", dest='result_mode',
+                               default=ResultMode.DEFAULT, type=ResultMode, choices=list(ResultMode),
+                               help=render_enum_help(topic='results', enum_cls=ResultMode))
+        group_25d.add_argument("--report", dest='report_level',
+                               default=ReportLevel.DEFAULT, type=ReportLevel, choices=list(ReportLevel),
+                               help=render_enum_help(topic='report', enum_cls=ReportLevel))
+        group_25d.add_argument("--report_sampling", dest="report_sampling_rate",
+                               type=int, default=100,
+                               help="For --report sampled, keep every n-th item per category "
+                                    "(default is %(default)s)")
+        group_25d.add_argument("--prune_layers", dest="prune_layers",
+                               type=true_or_false, default=True,
+                               help="Only pass layers with capacitance specs (and their shields) "
+                                    "to the neighborhood queries (default is %(default)s)")
+        group_25d.add_argument("--halo_tolerance", dest="halo_tolerance",
+                               type=float, default=None,
+                               help="Shrink the fringe halo per layer, so that the fringe fraction beyond it "
+                                    "stays below this tolerance, e.g. 0.01 (default is the full side halo). "
+                                    "Fringe is then extracted in a separate, smaller edge neighborhood pass, "
+                                    "sidewall coupling is still extracted up to the full side halo")
+        group_25d.add_argument("--batch_kernels", dest="batch_kernels",
+                               type=true_or_false, default=False,
+                               help="Evaluate sidewall and fringe capacitances in vectorized batches per layer, "
+                                    "individual contributions are not reported (default is %(default)s)")
+        group_25d.add_argument("--overlap_engine", dest='overlap_engine',
+                               default=OverlapEngine.DEFAULT, type=OverlapEngine, choices=list(OverlapEngine),
+                               help=render_enum_help(topic='overlap_engine', enum_cls=OverlapEngine))
+        group_25d.add_argument("--substrate_fast_path", dest="substrate_fast_path",
+                               type=true_or_false, default=False,
+                               help="Compute substrate area and fringe caps in a dedicated pass, "
+                                    "instead of passing the substrate through the neighborhood queries "
+                                    "(default is %(default)s)")
+        group_25d.add_argument("--box_kernels", dest="box_kernels",
+                               type=true_or_false, default=False,
+                               help="Evaluate sidewall and fringe of rectilinear polygons exactly per rectangle, "
+                                    "instead of using their bounding box (default is %(default)s)")
+        group_25d.add_argument("--fringe_tables", dest="fringe_tables",
+                               type=true_or_false, default=False,
+                               help="Interpolate the fringe fractions of --batch_kernels and the cut-off "
+                                    "of --halo_tolerance from the tables precomputed by gen_tech_pb, "
+                                    "instead of evaluating the atan formula (default is %(default)s)")
+        group_25d.add_argument("--cross_section_tables", dest="cross_section_tables",
+                               type=true_or_false, default=False,
+                               help="Interpolate the sidewall coupling from the field solver tables "
+                                    "of the technology (see kpex_cross_sections), "
+                                    "instead of the sidewall formula (default is %(default)s)")
+        group_25d.add_argument("--interval_shielding", dest="interval_shielding",
+                               type=true_or_false, default=False,
+                               help="Compute fringe shielding with 1D intervals along the edge, "
+                                    "where all nearby shapes are boxes (default is %(default)s)")
+        group_25d.add_argument("--record_moments", dest="record_moments",
+                               type=true_or_false, default=False,
+                               help="Store the geometric moments (overlap areas, sidewall lengths per distance, "
+                                    "fringe spans) in the result file, so that the capacitances can be "
+                                    "re-evaluated for other tech coefficients using kpex_moments, "
+                                    "without re-running the extraction (default is %(default)s)")
+        group_25d.add_argument("--sensitivities", dest="sensitivities",
+                               type=true_or_false, default=False,
+                               help="Compute the first order sensitivities of each net pair capacitance and "
+                                    "resistance with respect to each capacitance / resistance coefficient "
+                                    "of the technology, written next to the netlist CSV (default is %(default)s)")
 
         if arg_list is None:
             arg_list = sys.argv[1:]
@@ -318,6 +393,10 @@ class KpexCLI:
             error(f"Can't locate LVS script path at {args.lvs_script_path}")
             found_errors = True
 
+        if args.halo_tolerance is not None and not (0.0 < args.halo_tolerance < 1.0):
+            error(f"--halo_tolerance must be within (0, 1), got {args.halo_tolerance}")
+            found_errors = True
+
         rule('Input Layout')
 
         # check engines VS input possiblities
@@ -463,6 +542,19 @@ class KpexCLI:
             error("Failed to parse --diel arg", e)
             found_errors = True
 
+        if args.fringe_tables and not (args.batch_kernels or args.halo_tolerance is not None):
+            error("--fringe_tables requires --batch_kernels or --halo_tolerance, "
+                  "the per edge fringe formula does not use the tables")
+            found_errors = True
+
+        # NOTE: the recorded moments are re-evaluated with the formulas,
+        #       which would not match the nominal capacitances computed from the tables
+        if (args.record_moments or args.sensitivities) and (args.fringe_tables or args.cross_section_tables):
+            error("--fringe_tables / --cross_section_tables can't be combined with "
+                  "--record_moments or --sensitivities, "
+                  "as the geometric moments are re-evaluated using the formulas")
+            found_errors = True
+
         if args.cache_dir_path is None:
             args.cache_dir_path = os.path.join(args.output_dir_base_path, '.kpex_cache')
 
@@ -485,7 +577,8 @@ class KpexCLI:
                                                         tech_info=tech_info,
                                                         k_void=args.k_void,
                                                         delaunay_amax=args.delaunay_amax,
-                                                        delaunay_b=args.delaunay_b)
+                                                        delaunay_b=args.delaunay_b,
+                                                        via_arrays=args.via_arrays)
         gen: FasterCapModelGenerator = fastercap_input_builder.build()
 
         rule('FasterCap Input File Generation')
@@ -695,7 +788,9 @@ class KpexCLI:
                              tech_info: TechInfo,
                              report_path: str,
                              netlist_csv_path: Optional[str],
-                             expanded_netlist_path: Optional[str]):
+                             expanded_netlist_path: Optional[str],
+                             result_path: Optional[str] = None,
+                             sensitivities_csv_path: Optional[str] = None):
         # TODO: make this separatly configurable
         #       for now we use 0
         args.rcx25d_delaunay_amax = 0
@@ -707,20 +802,64 @@ class KpexCLI:
                                    delaunay_b=args.rcx25d_delaunay_b,
                                    scale_ratio_to_fit_halo=args.scale_ratio_to_fit_halo,
                                    tech_info=tech_info,
-                                   report_path=report_path)
+                                   report_path=report_path,
+                                   r_network_format=args.r_network_format,
+                                   result_mode=args.result_mode,
+                                   report_level=args.report_level,
+                                   report_sampling_rate=args.report_sampling_rate,
+                                   prune_layers=args.prune_layers,
+                                   halo_tolerance=args.halo_tolerance,
+                                   batch_kernels=args.batch_kernels,
+                                   interval_shielding=args.interval_shielding,
+                                   overlap_engine=args.overlap_engine,
+                                   substrate_fast_path=args.substrate_fast_path,
+                                   box_kernels=args.box_kernels,
+                                   fringe_tables=args.fringe_tables,
+                                   cross_section_tables=args.cross_section_tables,
+                                   record_moments=args.record_moments or args.sensitivities,
+                                   via_arrays=args.via_arrays)
         extraction_results = extractor.extract()
 
-        if netlist_csv_path is not None:
-            # TODO: merge this with klayout_pex/klayout/netlist_csv.py
+        if result_path is not None:
+            extraction_results.write(result_path)
+            subproc(f"Wrote extraction results to: {result_path}")
+
+        self.write_2_5d_netlists(args=args,
+                                 pex_context=pex_context,
+                                 extraction_results=extraction_results,
+                                 netlist_csv_path=netlist_csv_path,
+                                 expanded_netlist_path=expanded_netlist_path)
+
+        if args.sensitivities and sensitivities_csv_path is not None:
+            rule('kpex/2.5D sensitivities')
+            sensitivity_extractor = SensitivityExtractor(tech_info=tech_info)
+            sensitivities = sensitivity_extractor.extract(extraction_results)
+            sensitivities.write_csv(sensitivities_csv_path)
+            subproc(f"Wrote sensitivities to: {sensitivities_csv_path}")
+
+        if args.report_level == ReportLevel.OFF:
+            return extraction_results
+
+        # NOTE: there was a KLayout bug that some of the categories were lost,
+        #       so that the marker browser could not load the report file
+        try:
+            report = rdb.ReportDatabase('')
+            report.load(report_path)  # try loading rdb
+        except Exception as e:
+            rule("Repair broken marker DB")
+            warning(f"Detected KLayout bug: RDB can't be loaded due to exception {e}")
+            repair_rdb(report_path)
 
-            with open(netlist_csv_path, 'w', encoding='utf-8') as f:
-                summary = extraction_results.summarize()
+        return extraction_results
 
-                f.write('Device;Net1;Net2;Capacitance [fF];Resistance [Ω]\n')
-                for idx, (key, cap_value) in enumerate(sorted(summary.capacitances.items())):
-                    f.write(f"C{idx + 1};{key.net1};{key.net2};{round(cap_value, 3)};\n")
-                for idx, (key, res_value) in enumerate(sorted(summary.resistances.items())):
-                    f.write(f"R{idx + 1};{key.net1};{key.net2};;{round(res_value, 3)}\n")
+    def write_2_5d_netlists(self,
+                            args: argparse.Namespace,
+                            pex_context: KLayoutExtractionContext,
+                            extraction_results: ExtractionResults,
+                            netlist_csv_path: Optional[str],
+                            expanded_netlist_path: Optional[str]):
+        if netlist_csv_path is not None:
+            extraction_results.write_netlist_csv(netlist_csv_path)
 
             rule('kpex/2.5D extracted netlist (CSV format)')
             with open(netlist_csv_path, 'r') as f:
@@ -749,18 +888,6 @@ class KpexCLI:
                 netlist_printer.write(expanded_netlist, args.output_spice_path)
                 info(f"Copied expanded SPICE netlist to: {args.output_spice_path}")
 
-        # NOTE: there was a KLayout bug that some of the categories were lost,
-        #       so that the marker browser could not load the report file
-        try:
-            report = rdb.ReportDatabase('')
-            report.load(report_path)  # try loading rdb
-        except Exception as e:
-            rule("Repair broken marker DB")
-            warning(f"Detected KLayout bug: RDB can't be loaded due to exception {e}")
-            repair_rdb(report_path)
-
-        return extraction_results
-
     def setup_logging(self, args: argparse.Namespace):
         def register_log_file_handler(log_path: str,
                                       formatter: Optional[logging.Formatter]) -> logging.Handler:
@@ -955,6 +1082,10 @@ class KpexCLI:
                                                             f"{args.effective_cell_name}_k25d_pex_netlist.csv"))
             netlist_spice_path = os.path.abspath(os.path.join(args.output_dir_path,
                                                               f"{args.effective_cell_name}_k25d_pex_netlist.spice"))
+            result_path = os.path.abspath(os.path.join(args.output_dir_path,
+                                                       f"{args.effective_cell_name}_k25d_pex_result.pb"))
+            sensitivities_csv_path = os.path.abspath(os.path.join(args.output_dir_path,
+                                                                  f"{args.effective_cell_name}_k25d_pex_sensitivities.csv"))
 
             self._rcx25_extraction_results = self.run_kpex_2_5d_engine(  # NOTE: store for test case
                 args=args,
@@ -962,7 +1093,9 @@ class KpexCLI:
                 tech_info=tech_info,
                 report_path=report_path,
                 netlist_csv_path=netlist_csv_path,
-                expanded_netlist_path=netlist_spice_path
+                expanded_netlist_path=netlist_spice_path,
+                result_path=result_path,
+                sensitivities_csv_path=sensitivities_csv_path
             )
 
             self._rcx25_extracted_csv_path = netlist_csv_path
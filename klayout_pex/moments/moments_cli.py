@@ -0,0 +1,162 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+import argparse
+import os
+import os.path
+import shlex
+import sys
+import time
+from typing import *
+
+from rich_argparse import RichHelpFormatter
+
+from klayout_pex.log import (
+    LogLevel,
+    set_log_level,
+    info,
+    subproc,
+    error,
+    rule
+)
+from klayout_pex.rcx25.c.geometric_moments import evaluate_moments
+from klayout_pex.rcx25.extraction_results import ExtractionResults
+from klayout_pex.tech_info import TechInfo
+from klayout_pex.util.argparse_helpers import render_enum_help
+from klayout_pex.version import __version__
+
+
+# ------------------------------------------------------------------------------------
+
+PROGRAM_NAME = "kpex_moments"
+
+
+class ArgumentValidationError(Exception):
+    pass
+
+
+class MomentsCLI:
+    def parse_args(self, arg_list: List[str] = None) -> argparse.Namespace:
+        main_parser = argparse.ArgumentParser(description=f"{PROGRAM_NAME}: "
+                                                          f"Re-evaluates the capacitances of a kpex/2.5D result "
+                                                          f"(recorded with --record_moments) "
+                                                          f"for other technology coefficients",
+                                              add_help=False,
+                                              formatter_class=RichHelpFormatter)
+
+        group_special = main_parser.add_argument_group("Special options")
+        group_special.add_argument("--help", "-h", action='help', help="show this help message and exit")
+        group_special.add_argument("--version", "-v", action='version', version=f'{PROGRAM_NAME} {__version__}')
+        group_special.add_argument("--log_level", dest='log_level',
+                                   default=LogLevel.DEFAULT, type=LogLevel, choices=list(LogLevel),
+                                   help=render_enum_help(topic='log_level', enum_cls=LogLevel))
+
+        main_parser.add_argument("result_paths", nargs='+',
+                                 type=str, help="Path(s) to the kpex/2.5D result file(s) (*_k25d_pex_result.pb)")
+        main_parser.add_argument("--tech", "-t", dest="tech_pbjson_path", required=True,
+                                 help="Technology Protocol Buffer path (*.pb.json) with the new coefficients")
+        main_parser.add_argument("--csv", dest="output_csv_path", default=None,
+                                 help="Output netlist CSV path")
+        main_parser.add_argument("--result", dest="output_result_path", default=None,
+                                 help="Output result path (same format as the input result files)")
+
+        if arg_list is None:
+            arg_list = sys.argv[1:]
+        args = main_parser.parse_args(arg_list)
+
+        self.validate_args(main_parser, args)
+
+        return args
+
+    @staticmethod
+    def validate_args(main_parser: argparse.ArgumentParser,
+                      args: argparse.Namespace):
+        found_errors = False
+
+        for path in args.result_paths:
+            if not os.path.isfile(path):
+                error(f"Can't read result file at path {path}")
+                found_errors = True
+
+        if not os.path.isfile(args.tech_pbjson_path):
+            error(f"Can't read technology file at path {args.tech_pbjson_path}")
+            found_errors = True
+
+        if args.output_csv_path is None and args.output_result_path is None:
+            error(f"At least one of --csv or --result is required")
+            found_errors = True
+
+        if found_errors:
+            raise ArgumentValidationError("Argument validation failed")
+
+    def evaluate(self, args: argparse.Namespace) -> ExtractionResults:
+        tech_info = TechInfo.from_json(args.tech_pbjson_path,
+                                       dielectric_filter=None)
+
+        rule('Read results')
+        nominal_results = ExtractionResults.read(args.result_paths)
+        info(f"Read {len(nominal_results.cell_extraction_results)} cell result(s) "
+             f"from {len(args.result_paths)} file(s)")
+
+        rule('Evaluate moments')
+        start = time.perf_counter()
+        results = evaluate_moments(nominal_results=nominal_results,
+                                tech_info=tech_info)
+        info(f"Evaluated capacitances in {(time.perf_counter() - start) * 1000.0:.1f} ms")
+
+        if args.output_csv_path is not None:
+            results.write_netlist_csv(args.output_csv_path)
+            subproc(f"Wrote netlist CSV to: {args.output_csv_path}")
+
+        if args.output_result_path is not None:
+            results.write(args.output_result_path)
+            subproc(f"Wrote extraction results to: {args.output_result_path}")
+
+        return results
+
+    def setup_logging(self, args: argparse.Namespace):
+        set_log_level(args.log_level)
+
+    def main(self, argv: List[str]):
+        if '-v' not in argv and \
+           '--version' not in argv and \
+           '-h' not in argv and \
+           '--help' not in argv:
+            rule('Command line arguments')
+            subproc(' '.join(map(shlex.quote, sys.argv)))
+
+        args = self.parse_args(argv[1:])
+
+        self.setup_logging(args)
+
+        try:
+            self.evaluate(args)
+        except ValueError as e:
+            error(f"{e}, re-run kpex with --record_moments")
+            sys.exit(1)
+
+
+if __name__ == "__main__":
+    cli = MomentsCLI()
+    cli.main(sys.argv)
@@ -0,0 +1,108 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from __future__ import annotations
+from typing import *
+
+from google.protobuf.message import Message
+
+import klayout.db as kdb
+import klayout_pex_protobuf.kpex.geometry.shapes_pb2 as shapes_pb2
+
+# Optional native extension (built with cmake -DKPEX_BUILD_PYTHON_EXTENSION=ON,
+# see cxx/kpex_native), the pure Python code paths are used if it is missing.
+#
+# Messages are handed over as serialized buffers: the Python protobuf runtime (upb)
+# and the C++ runtime of the extension can't share message objects,
+# but the extension parses directly from the bytes of SerializeToString(),
+# and serializes directly into the bytes object that is merged on the Python side.
+try:
+    from . import _kpex_native
+except ImportError:
+    _kpex_native = None
+
+
+def native_available() -> bool:
+    return _kpex_native is not None
+
+
+def _require_native():
+    if _kpex_native is None:
+        raise RuntimeError("The native extension klayout_pex.native._kpex_native is not available, "
+                           "build with cmake -DKPEX_BUILD_PYTHON_EXTENSION=ON")
+    return _kpex_native
+
+
+def protobuf_version() -> str:
+    """
+    :return: version of the protobuf C++ runtime of the native extension
+    """
+    return _require_native().protobuf_version()
+
+
+def message_stats(message: Message, max_depth: int = 0) -> str:
+    """
+    :return: serialized bytes per field of the message, as printed by kpex_pbtool stats
+    """
+    return _require_native().message_stats(message.DESCRIPTOR.full_name,
+                                           message.SerializeToString(),
+                                           max_depth)
+
+
+def region_to_pb(region_kly: kdb.Region | Iterable[kdb.Polygon],
+                 region_pb: shapes_pb2.Region):
+    """
+    Native fast path of ShapesConverter.klayout_region_to_pb,
+    appends the polygons with the same message layout,
+    but without creating Python objects per vertex.
+    """
+    region_pb.MergeFromString(_require_native().encode_region(region_kly))
+
+
+def polygon_to_pb(polygon_kly: kdb.Polygon,
+                  shape_pb: shapes_pb2.Shape):
+    """
+    Native fast path of ShapesConverter.klayout_polygon_to_pb
+    """
+    shape_pb.MergeFromString(_require_native().encode_polygon(polygon_kly))
+
+
+def region_from_pb(region_pb: shapes_pb2.Region) -> kdb.Region:
+    """
+    Native fast path of ShapesConverter.klayout_region,
+    the coordinates are handed over to KLayout in bulk (one string form per shape),
+    without accessing the protobuf message per vertex.
+    """
+    region_kly = kdb.Region()
+    for kind, s, net in _require_native().decode_region(region_pb.SerializeToString()):
+        if kind == shapes_pb2.Shape.Kind.SHAPE_KIND_BOX:
+            shape_kly = kdb.Box.from_s(s)
+            if net:
+                shape_kly = kdb.BoxWithProperties(shape_kly, {'net': net})
+        else:
+            shape_kly = kdb.Polygon.from_s(s)
+            if net:
+                shape_kly = kdb.PolygonWithProperties(shape_kly, {'net': net})
+        region_kly.insert(shape_kly)
+    return region_kly
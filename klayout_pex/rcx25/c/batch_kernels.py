@@ -0,0 +1,255 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from __future__ import annotations
+from array import array
+from typing import *
+import math
+
+import numpy as np
+
+from klayout_pex.rcx25.c.cap_formulas import FRINGE_CAP_THRESHOLD
+from klayout_pex.rcx25.c.fringe_halo import fringe_alpha
+from klayout_pex.rcx25.c.fringe_tables import FringeFractionTable, FringeFractionTables, FringeFractionTableStack
+from klayout_pex.rcx25.extraction_results import (
+    CellExtractionResults,
+    SideOverlapCap,
+    SideOverlapKey,
+    SidewallCap,
+    SidewallKey,
+)
+from klayout_pex.rcx25.types import LayerName
+from klayout_pex_protobuf.kpex.tech.process_parasitics_pb2 import CapacitanceInfo
+
+#
+# Batched evaluation of the sidewall and fringe formulas:
+#   the edge neighborhood visitors only record the geometry of each contribution
+#   (contiguous arrays of lengths / distances plus indices into small spec and key tables),
+#   after a pass the formulas are evaluated for all records at once
+#   and scatter-added into one total per key.
+#
+# NOTE: the individual contributions are not kept,
+#       i.e. the results contain one summed entry per key and pass,
+#       and the report does not list the individual items
+#
+
+
+class _KeyTable:
+    def __init__(self):
+        self.keys: List[Any] = []
+        self.index_by_key: Dict[Any, int] = {}
+
+    def index(self, key: Any) -> int:
+        idx = self.index_by_key.get(key, None)
+        if idx is None:
+            idx = len(self.keys)
+            self.keys.append(key)
+            self.index_by_key[key] = idx
+        return idx
+
+    def __len__(self) -> int:
+        return len(self.keys)
+
+
+class SidewallBatch:
+    def __init__(self):
+        self.layers = _KeyTable()
+        self.layer_capacitance = array('d')
+        self.layer_offset = array('d')
+        self.sidewall_keys = _KeyTable()
+
+        self.layer_indices = array('q')
+        self.key_indices = array('q')
+        self.length_um = array('d')
+        self.distance_um = array('d')
+        self.coupling = array('d')  # NaN: evaluated by the sidewall formula
+
+    def __len__(self) -> int:
+        return len(self.key_indices)
+
+    def add(self,
+            layer_name: LayerName,
+            sidewall_cap_spec: CapacitanceInfo.SidewallCapacitance,
+            key: SidewallKey,
+            length_um: float,
+            distance_um: float,
+            coupling: Optional[float] = None):
+        """
+        :param coupling: if given (in aF/µm, see cross_section_tables), used instead of the sidewall formula
+        """
+        layer_idx = self.layers.index(layer_name)
+        if layer_idx == len(self.layer_capacitance):
+            self.layer_capacitance.append(sidewall_cap_spec.capacitance)
+            self.layer_offset.append(sidewall_cap_spec.offset)
+        self.layer_indices.append(layer_idx)
+        self.key_indices.append(self.sidewall_keys.index(key))
+        self.length_um.append(length_um)
+        self.distance_um.append(distance_um)
+        self.coupling.append(math.nan if coupling is None else coupling)
+
+    def evaluate(self) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        :return: per key: (cap sums in fF, contribution counts)
+        """
+        layers = np.frombuffer(self.layer_indices, dtype=np.int64)
+        keys = np.frombuffer(self.key_indices, dtype=np.int64)
+        capacitance = np.frombuffer(self.layer_capacitance, dtype=np.float64)[layers]
+        offset = np.frombuffer(self.layer_offset, dtype=np.float64)[layers]
+        length_um = np.frombuffer(self.length_um, dtype=np.float64)
+        distance_um = np.frombuffer(self.distance_um, dtype=np.float64)
+        coupling = np.frombuffer(self.coupling, dtype=np.float64)
+
+        # NOTE: dividing by 2 (like MAGIC this not bidirectional), see emit_sidewall
+        cap_femto = length_um * capacitance / (distance_um + offset) / 2.0 / 1000.0
+        tabulated = ~np.isnan(coupling)
+        if tabulated.any():
+            cap_femto[tabulated] = length_um[tabulated] * coupling[tabulated] / 2.0 / 1000.0
+
+        n = len(self.sidewall_keys)
+        return np.bincount(keys, weights=cap_femto, minlength=n), np.bincount(keys, minlength=n)
+
+    def flush(self, results: CellExtractionResults):
+        if len(self) == 0:
+            return
+        sums, counts = self.evaluate()
+        for idx, key in enumerate(self.sidewall_keys.keys):
+            if counts[idx] == 0:
+                continue
+            results.add_sidewall_cap(SidewallCap(key=key,
+                                                 cap_value=float(sums[idx]),
+                                                 distance=0.0,
+                                                 length=0.0,
+                                                 tech_spec=None))
+
+
+class FringeBatch:
+    def __init__(self,
+                 side_halo: float,
+                 scale_ratio_to_fit_halo: bool,
+                 fringe_tables: Optional[FringeFractionTables] = None):
+        self.side_halo = side_halo
+        self.scale_ratio_to_fit_halo = scale_ratio_to_fit_halo
+        self.fringe_tables = fringe_tables
+
+        self.layer_pairs = _KeyTable()
+        self.pair_alpha = array('d')
+        self.pair_tables: List[Optional[FringeFractionTable]] = []
+        self.pair_sideoverlap_capacitance = array('d')
+        self.sideoverlap_keys = _KeyTable()
+
+        self.pair_indices = array('q')
+        self.key_indices = array('q')
+        self.length_um = array('d')
+        self.near_um = array('d')
+        self.far_um = array('d')
+
+    def __len__(self) -> int:
+        return len(self.key_indices)
+
+    def add(self,
+            inside_layer_name: LayerName,
+            outside_layer_name: LayerName,
+            overlap_cap_spec: CapacitanceInfo.OverlapCapacitance,
+            sideoverlap_cap_spec: CapacitanceInfo.SideOverlapCapacitance,
+            key: SideOverlapKey,
+            length_um: float,
+            distance_near_um: float,
+            distance_far_um: float):
+        pair_idx = self.layer_pairs.index((inside_layer_name, outside_layer_name))
+        if pair_idx == len(self.pair_alpha):
+            self.pair_alpha.append(fringe_alpha(overlap_cap_spec))
+            self.pair_tables.append(None if self.fringe_tables is None
+                                    else self.fringe_tables.table(overlap_cap_spec))
+            self.pair_sideoverlap_capacitance.append(sideoverlap_cap_spec.capacitance)
+        self.pair_indices.append(pair_idx)
+        self.key_indices.append(self.sideoverlap_keys.index(key))
+        self.length_um.append(length_um)
+        self.near_um.append(distance_near_um)
+        self.far_um.append(distance_far_um)
+
+    def evaluate(self) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        :return: per key: (cap sums in fF, contribution counts above the threshold)
+        """
+        pairs = np.frombuffer(self.pair_indices, dtype=np.int64)
+        keys = np.frombuffer(self.key_indices, dtype=np.int64)
+        alpha_c = np.frombuffer(self.pair_alpha, dtype=np.float64)[pairs]
+        sideoverlap_capacitance = np.frombuffer(self.pair_sideoverlap_capacitance, dtype=np.float64)[pairs]
+        length_um = np.frombuffer(self.length_um, dtype=np.float64)
+        near_um = np.frombuffer(self.near_um, dtype=np.float64)
+        far_um = np.frombuffer(self.far_um, dtype=np.float64)
+
+        # see SidewallAndFringeExtractor.fringe_cap
+        if any(t is not None for t in self.pair_tables):
+            stack = FringeFractionTableStack(tables=self.pair_tables, alpha_c=self.pair_alpha)
+            cnear = stack.fractions_of(pairs, near_um)
+            cfar = stack.fractions_of(pairs, far_um)
+            all_pairs = np.arange(len(self.pair_tables))
+            full_halo_ratio = stack.fractions_of(all_pairs, np.full(len(all_pairs), self.side_halo))[pairs]
+        else:
+            cnear = (2.0 / math.pi) * np.arctan(alpha_c * near_um)
+            cfar = (2.0 / math.pi) * np.arctan(alpha_c * far_um)
+            full_halo_ratio = (2.0 / math.pi) * np.arctan(alpha_c * self.side_halo)
+
+        if self.scale_ratio_to_fit_halo:
+            full_halo_ratio = np.where(full_halo_ratio < 1.0, full_halo_ratio, 1.0)
+            cnear /= full_halo_ratio
+            cfar /= full_halo_ratio
+
+        cap_femto = (cfar - cnear) * length_um * sideoverlap_capacitance / 1000.0
+
+        above_threshold = cap_femto > FRINGE_CAP_THRESHOLD
+        keys = keys[above_threshold]
+        cap_femto = cap_femto[above_threshold]
+
+        n = len(self.sideoverlap_keys)
+        return np.bincount(keys, weights=cap_femto, minlength=n), np.bincount(keys, minlength=n)
+
+    def flush(self, results: CellExtractionResults):
+        if len(self) == 0:
+            return
+        sums, counts = self.evaluate()
+        for idx, key in enumerate(self.sideoverlap_keys.keys):
+            if counts[idx] == 0:
+                continue
+            results.add_sideoverlap_cap(SideOverlapCap(key=key, cap_value=float(sums[idx])))
+
+
+class CapBatch:
+    """
+    Records of one edge neighborhood pass
+    """
+
+    def __init__(self,
+                 side_halo: float,
+                 scale_ratio_to_fit_halo: bool,
+                 fringe_tables: Optional[FringeFractionTables] = None):
+        self.sidewall = SidewallBatch()
+        self.fringe = FringeBatch(side_halo=side_halo,
+                                  scale_ratio_to_fit_halo=scale_ratio_to_fit_halo,
+                                  fringe_tables=fringe_tables)
+
+    def flush(self, results: CellExtractionResults):
+        self.sidewall.flush(results)
+        self.fringe.flush(results)
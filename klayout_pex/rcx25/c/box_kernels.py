@@ -0,0 +1,145 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from __future__ import annotations
+from typing import *
+
+import klayout.db as kdb
+
+#
+# Box kernels on integer coordinates (dbu), in the rotated frame of the edge neighborhood
+# (the edge lies on the x-axis, the outside is at y > 0).
+#
+# Rectilinear polygons are decomposed into rectangles,
+# so that sidewall and fringe can be evaluated exactly per rectangle,
+# instead of approximating the polygon by its bounding box.
+#
+
+BoxTuple = Tuple[int, int, int, int]  # left, bottom, right, top
+
+
+def merge_strips(strips: List[BoxTuple]) -> List[BoxTuple]:
+    """
+    Merges vertically adjacent strips with the same x range into maximal rectangles
+    """
+    merged: List[BoxTuple] = []
+    for left, bottom, right, top in sorted(strips, key=lambda b: (b[0], b[2], b[1])):
+        if merged:
+            m_left, m_bottom, m_right, m_top = merged[-1]
+            if m_left == left and m_right == right and m_top == bottom:
+                merged[-1] = (m_left, m_bottom, m_right, top)
+                continue
+        merged.append((left, bottom, right, top))
+    return merged
+
+
+def rectilinear_boxes(polygon: kdb.Polygon) -> Optional[List[BoxTuple]]:
+    """
+    :return: the rectangle decomposition, or None if the polygon is not rectilinear
+    """
+    if polygon.is_box():
+        b = polygon.bbox()
+        return [(b.left, b.bottom, b.right, b.top)]
+    if not polygon.is_rectilinear():
+        return None
+    strips = []
+    for t in polygon.decompose_trapezoids():
+        b = t.bbox()
+        strips.append((b.left, b.bottom, b.right, b.top))
+    return merge_strips(strips)
+
+
+def fringe_spans(boxes: List[BoxTuple],
+                 x_start: int,
+                 x_end: int) -> List[Tuple[int, int, int]]:
+    """
+    :return: per rectangle within [x_start, x_end]: (length along the edge, near distance, far distance)
+    """
+    spans = []
+    for left, bottom, right, top in boxes:
+        length = min(right, x_end) - max(left, x_start)
+        near = max(bottom, 0)
+        far = max(top, 0)
+        if length <= 0 or far <= near:
+            continue
+        spans.append((length, near, far))
+    return spans
+
+
+def lower_envelope(boxes: List[BoxTuple],
+                   x_start: int,
+                   x_end: int) -> List[Tuple[int, int, int]]:
+    """
+    :return: segments (x1, x2, nearest distance) of [x_start, x_end] covered by the rectangles,
+             adjacent segments with the same distance are joined
+    """
+    xs = {x_start, x_end}
+    for left, bottom, right, top in boxes:
+        if x_start < left < x_end:
+            xs.add(left)
+        if x_start < right < x_end:
+            xs.add(right)
+    xs = sorted(xs)
+
+    segments: List[Tuple[int, int, int]] = []
+    for x1, x2 in zip(xs[:-1], xs[1:]):
+        nearest: Optional[int] = None
+        for left, bottom, right, top in boxes:
+            if left <= x1 and x2 <= right:
+                if nearest is None or bottom < nearest:
+                    nearest = bottom
+        if nearest is None:
+            continue
+        if segments and segments[-1][1] == x1 and segments[-1][2] == nearest:
+            segments[-1] = (segments[-1][0], x2, nearest)
+        else:
+            segments.append((x1, x2, nearest))
+    return segments
+
+
+def covered_area(boxes: List[BoxTuple],
+                 x_start: int,
+                 x_end: int,
+                 y_start: int,
+                 y_end: int) -> int:
+    """
+    :return: area of the union of the boxes within [x_start, x_end] × [y_start, y_end]
+    """
+    clipped = [(max(left, x_start), max(bottom, y_start), min(right, x_end), min(top, y_end))
+               for left, bottom, right, top in boxes]
+    clipped = [b for b in clipped if b[0] < b[2] and b[1] < b[3]]
+
+    xs = sorted({x for b in clipped for x in (b[0], b[2])})
+
+    area = 0
+    for x1, x2 in zip(xs[:-1], xs[1:]):
+        spans = sorted((bottom, top) for left, bottom, right, top in clipped if left <= x1 and x2 <= right)
+        covered = 0
+        y = y_start
+        for bottom, top in spans:
+            if top > y:
+                covered += top - max(bottom, y)
+                y = top
+        area += (x2 - x1) * covered
+    return area
@@ -0,0 +1,82 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from __future__ import annotations
+import math
+from typing import *
+
+from klayout_pex_protobuf.kpex.tech.process_parasitics_pb2 import CapacitanceInfo
+
+#
+# Scalar capacitance formulas of the 2.5D engine (all distances / lengths in µm, results in fF),
+# shared by the edge neighborhood visitor and the re-evaluation of recorded geometric moments
+#
+
+FRINGE_CAP_THRESHOLD = 0.0001  # fF, fringe contributions below are dropped
+
+
+def overlap_cap_femto(area_um2: float,
+                      overlap_cap_spec: CapacitanceInfo.OverlapCapacitance) -> float:
+    return area_um2 * overlap_cap_spec.capacitance / 1000.0
+
+
+def sidewall_cap_femto(length_um: float,
+                       distance_um: float,
+                       sidewall_cap_spec: CapacitanceInfo.SidewallCapacitance) -> float:
+    # C = Csidewall * l / s
+    # NOTE: dividing by 2 (like MAGIC this not bidirectional),
+    #       but we count 2 sidewall contributions (one for each side of the cap)
+    return ((length_um * sidewall_cap_spec.capacitance)
+            / (distance_um + sidewall_cap_spec.offset)
+            / 2.0  # non-bidirectional (half)
+            / 1000.0)  # aF -> fF
+
+
+def fringe_cap_femto(length_um: float,
+                     distance_near_um: float,
+                     distance_far_um: float,
+                     alpha_c: float,
+                     sideoverlap_cap_spec: CapacitanceInfo.SideOverlapCapacitance,
+                     halo_um: Optional[float]) -> float:
+    """
+    :param halo_um: if given, the fraction is scaled, so that the full halo sees the complete fringe
+    """
+    # see Magic ExtCouple.c L1164
+    cnear = (2.0 / math.pi) * math.atan(alpha_c * distance_near_um)
+    cfar = (2.0 / math.pi) * math.atan(alpha_c * distance_far_um)
+
+    if halo_um is not None:
+        full_halo_ratio = (2.0 / math.pi) * math.atan(alpha_c * halo_um)
+        # NOTE: for a large enough halo, full_halo would be 1,
+        #       but it is smaller, so we compensate
+        if full_halo_ratio < 1.0:
+            cnear /= full_halo_ratio
+            cfar /= full_halo_ratio
+
+    # "cfrac" is the fractional portion of the fringe cap seen
+    # by tile tp along its length.  This is independent of the
+    # portion of the boundary length that tile tp occupies.
+    cfrac = cfar - cnear
+
+    return cfrac * length_um * sideoverlap_cap_spec.capacitance / 1000.0
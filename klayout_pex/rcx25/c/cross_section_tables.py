@@ -0,0 +1,136 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from __future__ import annotations
+from bisect import bisect_right
+from dataclasses import dataclass
+from functools import cached_property
+import math
+from typing import *
+
+from klayout_pex.log import (
+    warning,
+)
+from klayout_pex.tech_info import TechInfo
+from klayout_pex_protobuf.kpex.tech.process_parasitics_pb2 import CapacitanceInfo
+
+#
+# Sidewall coupling by interpolation of the tables pre-solved by kpex_cross_sections
+# (see CapacitanceInfo.CrossSectionTable), instead of the sidewall formula C·l/(s + offset).
+#
+# The coupling decays roughly like a power of the spacing, so it is interpolated
+# log-log in the spacing (and extrapolated beyond the sampled spacings),
+# and linearly in the width (clamped to the sampled widths).
+#
+
+COUPLING_FLOOR = 1e-9  # aF/µm, the tables may contain (numerically) zero coupling for large spacings
+
+# min. fraction of the gap area covered by the layer below / above, to be treated as the plane of the tables
+CROSS_SECTION_COVERAGE = 0.9
+
+
+def coupling_cap_femto(length_um: float,
+                       coupling: float) -> float:
+    # NOTE: dividing by 2 like sidewall_cap_femto,
+    #       as we count 2 sidewall contributions (one for each side of the cap)
+    return length_um * coupling / 2.0 / 1000.0  # aF -> fF
+
+
+@dataclass
+class CrossSectionTable:
+    table: CapacitanceInfo.CrossSectionTable
+
+    @cached_property
+    def widths(self) -> List[float]:
+        return list(self.table.widths)
+
+    @cached_property
+    def log_spacings(self) -> List[float]:
+        return [math.log(s) for s in self.table.spacings]
+
+    @cached_property
+    def log_coupling(self) -> List[List[float]]:
+        n = len(self.table.spacings)
+        return [[math.log(max(c, COUPLING_FLOOR)) for c in self.table.coupling[i * n:(i + 1) * n]]
+                for i in range(len(self.widths))]
+
+    def log_coupling_at(self, row: int, log_spacing: float) -> float:
+        ls = self.log_spacings
+        lc = self.log_coupling[row]
+        if len(ls) == 1:
+            return lc[0]
+        i = min(max(bisect_right(ls, log_spacing) - 1, 0), len(ls) - 2)
+        t = (log_spacing - ls[i]) / (ls[i + 1] - ls[i])
+        return lc[i] + t * (lc[i + 1] - lc[i])
+
+    def coupling(self, width_um: float, spacing_um: float) -> float:
+        """
+        :return: coupling capacitance of two wires in aF/µm
+        """
+        log_spacing = math.log(max(spacing_um, 1e-6))
+        w = self.widths
+        if len(w) == 1 or width_um <= w[0]:
+            return math.exp(self.log_coupling_at(0, log_spacing))
+        if width_um >= w[-1]:
+            return math.exp(self.log_coupling_at(len(w) - 1, log_spacing))
+        i = bisect_right(w, width_um) - 1
+        t = (width_um - w[i]) / (w[i + 1] - w[i])
+        c0 = self.log_coupling_at(i, log_spacing)
+        c1 = self.log_coupling_at(i + 1, log_spacing)
+        return math.exp(c0 + t * (c1 - c0))
+
+    def sidewall_cap_femto(self,
+                           length_um: float,
+                           width_um: float,
+                           distance_um: float) -> float:
+        return coupling_cap_femto(length_um=length_um,
+                                  coupling=self.coupling(width_um=width_um, spacing_um=distance_um))
+
+
+@dataclass
+class CrossSectionTables:
+    """
+    Cross-section tables of a technology
+    """
+
+    tech_info: TechInfo
+
+    @cached_property
+    def table_by_layer_names(self) -> Dict[Tuple[str, str, str], CrossSectionTable]:
+        tables = self.tech_info.cross_section_table_by_layer_names
+        if not tables:
+            warning("Technology file has no cross-section tables (generate them with kpex_cross_sections), "
+                    "falling back to the sidewall formula")
+        return {layer_names: CrossSectionTable(table=t) for layer_names, t in tables.items()}
+
+    def table(self,
+              layer_name: str,
+              below_layer_name: str,
+              above_layer_name: str) -> Optional[CrossSectionTable]:
+        """
+        :param below_layer_name: nearest layer below the gap, empty for the substrate
+        :param above_layer_name: nearest layer above the gap, empty for none
+        :return: the table solved for exactly this environment, or None (i.e. use the sidewall formula)
+        """
+        return self.table_by_layer_names.get((layer_name, below_layer_name, above_layer_name), None)
@@ -0,0 +1,162 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from __future__ import annotations
+from dataclasses import dataclass
+from functools import cached_property
+import math
+from typing import *
+
+import numpy as np
+
+from klayout_pex.tech_info import TechInfo
+from klayout_pex.rcx25.c.fringe_tables import FringeFractionTables
+from klayout_pex.rcx25.c.layer_relevance import LayerRelevance
+from klayout_pex.rcx25.types import LayerName
+from klayout_pex_protobuf.kpex.tech.process_parasitics_pb2 import CapacitanceInfo
+
+
+# NOTE: overlap scaling is 1/50  (see MAGIC ExtTech)
+FRINGE_ALPHA_SCALE_FACTOR = 0.02 * 0.01 * 0.5 * 200.0
+
+
+def fringe_alpha(overlap_cap_spec: CapacitanceInfo.OverlapCapacitance) -> float:
+    return overlap_cap_spec.capacitance * FRINGE_ALPHA_SCALE_FACTOR
+
+
+def fringe_fraction_beyond(alpha_c: float, distance_um: float) -> float:
+    """
+    Fraction of the fringe capacitance that lies beyond distance_um,
+    for the fringe model (2/π)·atan(alpha_c·d) (see Magic ExtCouple.c)
+    """
+    return 1.0 - (2.0 / math.pi) * math.atan(alpha_c * distance_um)
+
+
+def fringe_halo_distance(alpha_c: float, tolerance: float) -> float:
+    """
+    Smallest distance beyond which the remaining fringe fraction is below tolerance,
+    i.e. the inverse of fringe_fraction_beyond
+    """
+    if tolerance <= 0.0 or alpha_c <= 0.0:
+        return math.inf
+    if tolerance >= 1.0:
+        return 0.0
+    return math.tan((1.0 - tolerance) * math.pi / 2.0) / alpha_c
+
+
+# NOTE: a separate fringe pass must save at least this fraction of the estimated query cost
+SEPARATE_FRINGE_PASS_MIN_SAVING = 0.1
+
+
+def separate_fringe_pass(side_halo_um: float,
+                         fringe_halo_um: float,
+                         inside_shape_count: int,
+                         child_shape_count: int) -> bool:
+    """
+    Whether to extract fringe in a separate edge neighborhood pass with the (smaller) fringe halo.
+
+    The cost of a pass is estimated by halo · shape count of the queried layers:
+    a single pass queries all children up to the side halo,
+    the separate passes query the inside layer (sidewall) up to the side halo
+    and all children (fringe) up to the fringe halo.
+    On dense lower layers, the additional sidewall pass usually costs more than the smaller fringe pass saves.
+    """
+    if fringe_halo_um >= side_halo_um:
+        return False
+    single = side_halo_um * child_shape_count
+    separate = side_halo_um * inside_shape_count + fringe_halo_um * child_shape_count
+    return separate < (1.0 - SEPARATE_FRINGE_PASS_MIN_SAVING) * single
+
+
+@dataclass
+class FringeHalo:
+    halo_um: float
+    truncation_bound: float  # max. remaining fringe fraction (of any layer pair) beyond halo_um
+
+
+@dataclass
+class AdaptiveFringeHalo:
+    """
+    Per inside layer, the smallest fringe halo, so that for all
+    inside/outside layer pairs the fringe fraction beyond the halo is below the tolerance.
+    The halo never exceeds the side halo of the technology.
+    It only limits the edge neighborhood of the fringe pass, sidewall coupling keeps the side halo.
+
+    The fringe fractions are still normalized to the side halo (see scale_ratio_to_fit_halo),
+    so relative to the extraction with the full side halo, the truncated part of each fringe cap is
+    (f(side_halo) - f(halo)) / f(side_halo) ≤ 1 - f(halo), i.e. at most the truncation_bound.
+
+    If fringe_tables are given, the halo is the exact cut-off distance of the tables
+    (see FringeFractionTable.halo_distance_um).
+    """
+
+    all_layer_names: List[LayerName]
+    tech_info: TechInfo
+    tolerance: float
+    fringe_tables: Optional[FringeFractionTables] = None
+
+    @cached_property
+    def layer_relevance(self) -> LayerRelevance:
+        return LayerRelevance(all_layer_names=self.all_layer_names, tech_info=self.tech_info)
+
+    @cached_property
+    def side_halo(self) -> float:
+        return self.tech_info.tech.process_parasitics.side_halo
+
+    def overlap_cap_spec(self,
+                         inside_layer_name: LayerName,
+                         outside_layer_name: LayerName) -> CapacitanceInfo.OverlapCapacitance:
+        # NOTE: same lookup as SidewallAndFringeExtractor.emit_fringe
+        spec = self.tech_info.overlap_cap_by_layer_names.get(inside_layer_name, {}).get(outside_layer_name, None)
+        if not spec:
+            spec = self.tech_info.overlap_cap_by_layer_names[outside_layer_name][inside_layer_name]
+        return spec
+
+    def halo_distance(self, spec: CapacitanceInfo.OverlapCapacitance) -> float:
+        if self.fringe_tables is not None:
+            table = self.fringe_tables.table(spec)
+            if table is not None:
+                return table.halo_distance_um(tolerance=self.tolerance)
+        return fringe_halo_distance(alpha_c=fringe_alpha(spec), tolerance=self.tolerance)
+
+    def fraction_beyond(self, spec: CapacitanceInfo.OverlapCapacitance, distance_um: float) -> float:
+        if self.fringe_tables is not None:
+            table = self.fringe_tables.table(spec)
+            if table is not None:
+                return 1.0 - table.fractions_of(np.array([distance_um / table.table.dbu]))[0]
+        return fringe_fraction_beyond(alpha_c=fringe_alpha(spec), distance_um=distance_um)
+
+    @cached_property
+    def halo_by_layer_index(self) -> Dict[int, FringeHalo]:
+        halos: Dict[int, FringeHalo] = {}
+        for inside_idx, inside_layer_name in enumerate(self.all_layer_names):
+            specs = [self.overlap_cap_spec(inside_layer_name, self.all_layer_names[idx])
+                     for idx in self.layer_relevance.fringe_layer_indices[inside_idx]]
+            if not specs:
+                halos[inside_idx] = FringeHalo(halo_um=self.side_halo, truncation_bound=0.0)
+                continue
+            halo_um = min(self.side_halo, max(self.halo_distance(s) for s in specs))
+            bound = max(self.fraction_beyond(s, distance_um=halo_um) for s in specs)
+            halos[inside_idx] = FringeHalo(halo_um=halo_um, truncation_bound=bound)
+        return halos
@@ -0,0 +1,219 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from __future__ import annotations
+from bisect import bisect_right
+from dataclasses import dataclass
+from functools import cached_property
+import math
+from typing import *
+
+import numpy as np
+
+from klayout_pex.log import (
+    warning,
+)
+from klayout_pex.tech_info import TechInfo
+from klayout_pex_protobuf.kpex.tech.process_parasitics_pb2 import CapacitanceInfo
+
+#
+# Fringe fraction (2/π)·atan(alpha_c·d) by interpolation of the tables precomputed by gen_tech_pb
+# (see CapacitanceInfo.FringeFractionTable), for whole arrays of distances (see batch_kernels),
+# and the inverse lookup for the fringe halo cut-off distance (see fringe_halo).
+#
+# The table is a sequence of segments with samples_per_segment uniform steps each,
+# the step doubles from segment to segment. Segment k starts at span·(2^k - 1),
+# where span = first_step_dbu·samples_per_segment is the length of the first segment,
+# so the sample index of a distance d is computed directly (see sample_positions),
+# without a search over the samples.
+#
+# NOTE: a scalar lookup per distance is slower in Python than math.atan,
+#       so the per edge interval path (fringe_cap) keeps using the formula
+#
+# NOTE: with numpy, the batched lookup is slower than np.arctan as well
+#       (about 60 ms vs. 6-11 ms per 1e6 records, see test_benchmark_stack_against_formula),
+#       as it needs several passes over the records (positions, gathers, masks) instead of one ufunc,
+#       the tables pay off for the inverse lookup of the halo cut-off
+#
+# NOTE: distances beyond the last sample (i.e. beyond the side halo of the technology)
+#       are evaluated by the formula
+#
+
+
+def fringe_fraction(alpha_c: float, distance_um: float) -> float:
+    return (2.0 / math.pi) * math.atan(alpha_c * distance_um)
+
+
+def sample_positions(distance: np.ndarray,
+                     span: np.ndarray | float,
+                     samples_per_segment: np.ndarray | float) -> Tuple[np.ndarray, np.ndarray]:
+    """
+    :param distance: distances, in the same unit as span
+    :param span: length of the first segment
+    :return: (index of the sample left of each distance, relative position between this and the next sample)
+    """
+    # d/span + 1 = mantissa·2^exponent with mantissa in [0.5, 1), i.e. d lies in the segment exponent-1,
+    # (2·mantissa - 1)·samples_per_segment steps after its start
+    mantissa, exponent = np.frexp(distance / span + 1.0)
+    offset = (2.0 * mantissa - 1.0) * samples_per_segment
+    in_segment = np.minimum(np.floor(offset), samples_per_segment - 1)
+    index = ((exponent - 1) * samples_per_segment + in_segment).astype(np.int64)
+    return index, offset - in_segment
+
+
+@dataclass
+class FringeFractionTable:
+    table: CapacitanceInfo.FringeFractionTable
+
+    @cached_property
+    def fractions(self) -> List[float]:
+        return list(self.table.fractions)
+
+    @cached_property
+    def sample_distances_dbu(self) -> np.ndarray:
+        n = self.table.samples_per_segment
+        steps = [self.table.first_step_dbu << (i // n) for i in range(len(self.fractions) - 1)]
+        return np.concatenate(([0], np.cumsum(steps))).astype(np.float64)
+
+    @cached_property
+    def sample_fractions(self) -> np.ndarray:
+        return np.array(self.fractions, dtype=np.float64)
+
+    @cached_property
+    def end_dbu(self) -> float:
+        return float(self.sample_distances_dbu[-1])
+
+    def fractions_of(self, distance_dbu: np.ndarray) -> np.ndarray:
+        """
+        Fringe fractions of the distances (in dbu)
+        """
+        index, t = sample_positions(distance_dbu,
+                                    float(self.table.first_step_dbu * self.table.samples_per_segment),
+                                    float(self.table.samples_per_segment))
+        beyond = index >= len(self.sample_fractions) - 1
+        index = np.minimum(index, len(self.sample_fractions) - 2)
+        f0 = self.sample_fractions[index]
+        f = f0 + t * (self.sample_fractions[index + 1] - f0)
+        if np.any(beyond):
+            f[beyond] = (2.0 / math.pi) * np.arctan(self.table.alpha * distance_dbu[beyond] * self.table.dbu)
+        return f
+
+    def distance_for_fraction(self, fraction: float) -> float:
+        """
+        Inverse of fractions_of, i.e. the distance (in dbu) where the fringe fraction reaches the given value
+        """
+        if fraction <= 0.0:
+            return 0.0
+        if fraction >= 1.0:
+            return math.inf
+        if fraction >= self.fractions[-1]:
+            return math.tan(fraction * math.pi / 2.0) / self.table.alpha / self.table.dbu
+
+        idx = bisect_right(self.fractions, fraction) - 1
+        f0 = self.fractions[idx]
+        f1 = self.fractions[idx + 1]
+        d0 = self.sample_distances_dbu[idx]
+        d1 = self.sample_distances_dbu[idx + 1]
+        if f1 == f0:
+            return float(d0)
+        return float(d0 + (fraction - f0) / (f1 - f0) * (d1 - d0))
+
+    def halo_distance_um(self, tolerance: float) -> float:
+        """
+        Smallest distance beyond which the remaining fringe fraction is below tolerance
+        (see fringe_halo.fringe_halo_distance)
+        """
+        return self.distance_for_fraction(1.0 - tolerance) * self.table.dbu
+
+
+class FringeFractionTableStack:
+    """
+    The tables of several layer pairs concatenated into one array,
+    so that the records of all layer pairs of a batch are interpolated at once (see batch_kernels).
+    Layer pairs without a table (None) are evaluated by the formula.
+    """
+
+    def __init__(self,
+                 tables: Sequence[Optional[FringeFractionTable]],
+                 alpha_c: Sequence[float]):
+        self.has_table = np.array([t is not None for t in tables], dtype=bool)
+        self.alpha_c = np.array([alpha if t is None else t.table.alpha for t, alpha in zip(tables, alpha_c)],
+                                dtype=np.float64)
+        self.span_um = np.array([1.0 if t is None
+                                 else t.table.first_step_dbu * t.table.samples_per_segment * t.table.dbu
+                                 for t in tables], dtype=np.float64)
+        self.samples_per_segment = np.array([1.0 if t is None else t.table.samples_per_segment for t in tables],
+                                            dtype=np.float64)
+        sample_counts = [0 if t is None else len(t.sample_fractions) for t in tables]
+        self.sample_count = np.array(sample_counts, dtype=np.int64)
+        self.offset = np.concatenate(([0], np.cumsum(sample_counts)[:-1])).astype(np.int64)
+        self.fractions = np.concatenate([t.sample_fractions for t in tables if t is not None] or [np.empty(0)])
+
+    def fractions_of(self, pairs: np.ndarray, distance_um: np.ndarray) -> np.ndarray:
+        """
+        Fringe fractions of the distances (in µm), pairs are the indices of the tables
+        """
+        index, t = sample_positions(distance_um, self.span_um[pairs], self.samples_per_segment[pairs])
+        tabulated = self.has_table[pairs] & (index < self.sample_count[pairs] - 1)
+
+        f = np.empty_like(distance_um)
+        i = self.offset[pairs[tabulated]] + index[tabulated]
+        f0 = self.fractions[i]
+        f[tabulated] = f0 + t[tabulated] * (self.fractions[i + 1] - f0)
+
+        by_formula = ~tabulated
+        if np.any(by_formula):
+            f[by_formula] = (2.0 / math.pi) * np.arctan(self.alpha_c[pairs[by_formula]] * distance_um[by_formula])
+        return f
+
+
+@dataclass
+class FringeFractionTables:
+    """
+    Fringe fraction tables of a technology, usable for layouts with the given database unit
+    """
+
+    tech_info: TechInfo
+    dbu: float
+
+    @cached_property
+    def table_by_layer_names(self) -> Dict[Tuple[str, str], FringeFractionTable]:
+        tables = self.tech_info.fringe_fraction_table_by_layer_names
+        if not tables:
+            warning("Technology file has no fringe fraction tables (regenerate it with gen_tech_pb), "
+                    "falling back to the fringe formula")
+            return {}
+
+        usable: Dict[Tuple[str, str], FringeFractionTable] = {}
+        for layer_names, t in tables.items():
+            if not math.isclose(t.dbu, self.dbu, rel_tol=1e-9):
+                warning(f"Fringe fraction tables were generated for a database unit of {t.dbu} µm, "
+                        f"but the layout has {self.dbu} µm, falling back to the fringe formula")
+                return {}
+            usable[layer_names] = FringeFractionTable(table=t)
+        return usable
+
+    def table(self, overlap_cap_spec: CapacitanceInfo.OverlapCapacitance) -> Optional[FringeFractionTable]:
+        return self.table_by_layer_names.get((overlap_cap_spec.top_layer_name,
+                                              overlap_cap_spec.bottom_layer_name), None)
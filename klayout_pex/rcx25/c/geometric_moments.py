@@ -0,0 +1,263 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from __future__ import annotations
+from collections import defaultdict
+from dataclasses import dataclass, field
+from typing import *
+
+from klayout_pex.log import (
+    warning,
+)
+from klayout_pex.tech_info import TechInfo
+
+from klayout_pex.rcx25.c.cap_formulas import (
+    FRINGE_CAP_THRESHOLD,
+    fringe_cap_femto,
+    overlap_cap_femto,
+    sidewall_cap_femto,
+)
+from klayout_pex.rcx25.c.fringe_halo import fringe_alpha
+from klayout_pex.rcx25.extraction_results import *
+
+import klayout_pex_protobuf.kpex.c.geometric_moments_pb2 as geometric_moments_pb2
+
+# (length, near distance, far distance) in µm
+FringeSpan = Tuple[float, float, float]
+
+
+@dataclass
+class GeometricMoments:
+    """
+    Coefficient independent geometric quantities recorded during a 2.5D extraction
+    (areas, lengths and near/far distances per layer pair and net pair).
+
+    The capacitances can be re-evaluated from these for other technology coefficients
+    (e.g. a technology file of another process corner), without another geometry pass.
+    The re-evaluation uses the formulas, so the nominal pass must not use
+    the fringe or cross-section tables (see KpexCLI.validate_args).
+    """
+
+    scale_ratio_to_fit_halo: bool = True
+
+    # overlap area (µm^2)
+    overlap_areas: Dict[OverlapKey, float] = field(default_factory=lambda: defaultdict(float))
+
+    # distance (µm) -> summed length (µm)
+    sidewall_lengths: Dict[SidewallKey, Dict[float, float]] = field(
+        default_factory=lambda: defaultdict(lambda: defaultdict(float))
+    )
+
+    # span -> number of occurrences
+    # NOTE: spans are not summed up by distance, as the threshold applies to each single contribution
+    fringe_spans: Dict[SideOverlapKey, Dict[FringeSpan, int]] = field(
+        default_factory=lambda: defaultdict(lambda: defaultdict(int))
+    )
+
+    # halo (µm) the fringe fractions of each inside layer are normalized to (the side halo)
+    fringe_halo_by_layer: Dict[LayerName, float] = field(default_factory=dict)
+
+    def add_overlap(self, key: OverlapKey, area_um2: float):
+        self.overlap_areas[key] += area_um2
+
+    def add_sidewall(self, key: SidewallKey, length_um: float, distance_um: float):
+        self.sidewall_lengths[key][distance_um] += length_um
+
+    def add_fringe(self,
+                   key: SideOverlapKey,
+                   length_um: float,
+                   distance_near_um: float,
+                   distance_far_um: float,
+                   halo_um: float):
+        self.fringe_spans[key][(length_um, distance_near_um, distance_far_um)] += 1
+        self.fringe_halo_by_layer[key.layer_inside] = halo_um
+
+    def merge(self, other: GeometricMoments):
+        for key, area_um2 in other.overlap_areas.items():
+            self.overlap_areas[key] += area_um2
+        for key, lengths in other.sidewall_lengths.items():
+            for distance_um, length_um in lengths.items():
+                self.sidewall_lengths[key][distance_um] += length_um
+        for key, spans in other.fringe_spans.items():
+            for span, count in spans.items():
+                self.fringe_spans[key][span] += count
+        self.fringe_halo_by_layer.update(other.fringe_halo_by_layer)
+
+    def restricted_to_layers(self, layer_names: Set[LayerName]) -> GeometricMoments:
+        """
+        :return: the moments of all keys, where all involved layers are in layer_names
+        """
+        moments = GeometricMoments(scale_ratio_to_fit_halo=self.scale_ratio_to_fit_halo)
+        for key, area_um2 in self.overlap_areas.items():
+            if key.layer_top in layer_names and key.layer_bot in layer_names:
+                moments.overlap_areas[key] = area_um2
+        for key, lengths in self.sidewall_lengths.items():
+            if key.layer in layer_names:
+                moments.sidewall_lengths[key] = lengths
+        for key, spans in self.fringe_spans.items():
+            if key.layer_inside in layer_names and key.layer_outside in layer_names:
+                moments.fringe_spans[key] = spans
+        moments.fringe_halo_by_layer = self.fringe_halo_by_layer
+        return moments
+
+    def to_pb(self, moments_pb: geometric_moments_pb2.GeometricMoments):
+        moments_pb.scale_ratio_to_fit_halo = self.scale_ratio_to_fit_halo
+
+        for key, area_um2 in sorted(self.overlap_areas.items(), key=lambda kv: repr(kv[0])):
+            ov = moments_pb.overlaps.add()
+            ov.key.layer_top = key.layer_top
+            ov.key.net_top = key.net_top
+            ov.key.layer_bot = key.layer_bot
+            ov.key.net_bot = key.net_bot
+            ov.area = area_um2
+
+        for key, lengths in sorted(self.sidewall_lengths.items(), key=lambda kv: repr(kv[0])):
+            sw = moments_pb.sidewalls.add()
+            sw.key.layer = key.layer
+            sw.key.net1 = key.net1
+            sw.key.net2 = key.net2
+            sw.distances.extend(lengths.keys())
+            sw.lengths.extend(lengths.values())
+
+        for key, spans in sorted(self.fringe_spans.items(), key=lambda kv: repr(kv[0])):
+            fr = moments_pb.fringes.add()
+            fr.key.layer_inside = key.layer_inside
+            fr.key.net_inside = key.net_inside
+            fr.key.layer_outside = key.layer_outside
+            fr.key.net_outside = key.net_outside
+            for (length_um, distance_near_um, distance_far_um), count in spans.items():
+                fr.lengths.append(length_um)
+                fr.distances_near.append(distance_near_um)
+                fr.distances_far.append(distance_far_um)
+                fr.counts.append(count)
+
+        for layer_name, halo_um in sorted(self.fringe_halo_by_layer.items()):
+            h = moments_pb.fringe_halos.add()
+            h.layer_name = layer_name
+            h.halo = halo_um
+
+    @classmethod
+    def from_pb(cls, moments_pb: geometric_moments_pb2.GeometricMoments) -> GeometricMoments:
+        moments = GeometricMoments(scale_ratio_to_fit_halo=moments_pb.scale_ratio_to_fit_halo)
+
+        for ov in moments_pb.overlaps:
+            moments.add_overlap(OverlapKey(layer_top=ov.key.layer_top,
+                                           net_top=ov.key.net_top,
+                                           layer_bot=ov.key.layer_bot,
+                                           net_bot=ov.key.net_bot),
+                                ov.area)
+
+        for sw in moments_pb.sidewalls:
+            key = SidewallKey(layer=sw.key.layer, net1=sw.key.net1, net2=sw.key.net2)
+            for distance_um, length_um in zip(sw.distances, sw.lengths):
+                moments.add_sidewall(key, length_um=length_um, distance_um=distance_um)
+
+        for fr in moments_pb.fringes:
+            key = SideOverlapKey(layer_inside=fr.key.layer_inside,
+                                 net_inside=fr.key.net_inside,
+                                 layer_outside=fr.key.layer_outside,
+                                 net_outside=fr.key.net_outside)
+            spans = moments.fringe_spans[key]
+            for span in zip(fr.lengths, fr.distances_near, fr.distances_far, fr.counts):
+                spans[span[0:3]] += span[3]
+
+        for h in moments_pb.fringe_halos:
+            moments.fringe_halo_by_layer[h.layer_name] = h.halo
+
+        return moments
+
+    def evaluate(self,
+                 tech_info: TechInfo,
+                 results: CellExtractionResults):
+        """
+        Adds the capacitances for the coefficients of tech_info to results
+        """
+        for key, area_um2 in self.overlap_areas.items():
+            overlap_cap_spec = tech_info.overlap_cap_by_layer_names.get(key.layer_top, {}).get(key.layer_bot, None)
+            if not overlap_cap_spec:
+                warning(f"No overlap cap specified for layers top={key.layer_top}, bottom={key.layer_bot}")
+                continue
+            cap_femto = overlap_cap_femto(area_um2=area_um2, overlap_cap_spec=overlap_cap_spec)
+            if cap_femto > 0.0:
+                results.add_overlap_cap(OverlapCap(key=key,
+                                                   cap_value=cap_femto,
+                                                   shielded_area=0.0,
+                                                   unshielded_area=0.0,
+                                                   tech_spec=overlap_cap_spec))
+
+        for key, lengths in self.sidewall_lengths.items():
+            sidewall_cap_spec = tech_info.sidewall_cap_by_layer_name.get(key.layer, None)
+            if not sidewall_cap_spec:
+                warning(f"No sidewall cap specified for layer {key.layer}")
+                continue
+            for distance_um, length_um in lengths.items():
+                cap_femto = sidewall_cap_femto(length_um=length_um,
+                                               distance_um=distance_um,
+                                               sidewall_cap_spec=sidewall_cap_spec)
+                results.add_sidewall_cap(SidewallCap(key=key,
+                                                     cap_value=cap_femto,
+                                                     distance=distance_um,
+                                                     length=length_um,
+                                                     tech_spec=sidewall_cap_spec))
+
+        for key, spans in self.fringe_spans.items():
+            # NOTE: overlap_cap_by_layer_names is top/bot (dict is not symmetric)
+            overlap_cap_spec = tech_info.overlap_cap_by_layer_names.get(key.layer_inside, {}).get(key.layer_outside, None) \
+                               or tech_info.overlap_cap_by_layer_names.get(key.layer_outside, {}).get(key.layer_inside, None)
+            sideoverlap_cap_spec = tech_info.side_overlap_cap_by_layer_names.get(key.layer_inside, {}) \
+                                            .get(key.layer_outside, None)
+            if not overlap_cap_spec or not sideoverlap_cap_spec:
+                warning(f"No fringe cap specified for layers inside={key.layer_inside}, outside={key.layer_outside}")
+                continue
+
+            alpha_c = fringe_alpha(overlap_cap_spec)
+            halo_um = self.fringe_halo_by_layer[key.layer_inside] if self.scale_ratio_to_fit_halo else None
+
+            for (length_um, distance_near_um, distance_far_um), count in spans.items():
+                cap_femto = fringe_cap_femto(length_um=length_um,
+                                             distance_near_um=distance_near_um,
+                                             distance_far_um=distance_far_um,
+                                             alpha_c=alpha_c,
+                                             sideoverlap_cap_spec=sideoverlap_cap_spec,
+                                             halo_um=halo_um)
+                if cap_femto > FRINGE_CAP_THRESHOLD:
+                    results.add_sideoverlap_cap(SideOverlapCap(key=key, cap_value=cap_femto * count))
+
+
+def evaluate_moments(nominal_results: ExtractionResults,
+                     tech_info: TechInfo) -> ExtractionResults:
+    """
+    Re-evaluates the capacitances of nominal_results (which must have recorded moments)
+    for the coefficients of tech_info, the resistor networks are taken over from nominal_results
+    """
+    results = ExtractionResults()
+    for cell_name, nominal in nominal_results.cell_extraction_results.items():
+        if nominal.moments is None:
+            raise ValueError(f"No geometric moments were recorded for cell {cell_name}")
+        cell_results = CellExtractionResults(cell_name=cell_name,
+                                             result_mode=nominal.result_mode)
+        nominal.moments.evaluate(tech_info=tech_info, results=cell_results)
+        cell_results.r_extraction_result.CopyFrom(nominal.r_extraction_result)
+        results.cell_extraction_results[cell_name] = cell_results
+    return results
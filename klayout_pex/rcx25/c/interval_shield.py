@@ -0,0 +1,117 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from __future__ import annotations
+from bisect import bisect_left, bisect_right
+from typing import *
+
+import klayout.db as kdb
+
+
+Interval = Tuple[int, int]
+
+
+class IntervalSet:
+    """
+    Union of half-open intervals [lo, hi), kept sorted and disjoint.
+
+    Within one edge interval of the (rotated) edge neighborhood, shields and outside
+    shapes that span the whole interval are fully described by their distance range
+    from the edge, so fringe shielding reduces to 1D interval arithmetic.
+    """
+
+    def __init__(self):
+        self.los: List[int] = []
+        self.his: List[int] = []
+
+    def __len__(self) -> int:
+        return len(self.los)
+
+    def is_empty(self) -> bool:
+        return not self.los
+
+    def intervals(self) -> List[Interval]:
+        return list(zip(self.los, self.his))
+
+    def add(self, lo: int, hi: int):
+        if hi <= lo:
+            return
+        # all intervals touching or overlapping [lo, hi) get merged
+        first = bisect_left(self.his, lo)
+        last = bisect_right(self.los, hi)
+        if first < last:
+            lo = min(lo, self.los[first])
+            hi = max(hi, self.his[last - 1])
+        self.los[first:last] = [lo]
+        self.his[first:last] = [hi]
+
+    def update(self, other: IntervalSet):
+        for lo, hi in zip(other.los, other.his):
+            self.add(lo, hi)
+
+    def copy(self) -> IntervalSet:
+        c = IntervalSet()
+        c.los = self.los.copy()
+        c.his = self.his.copy()
+        return c
+
+    def subtract_from(self, lo: int, hi: int) -> List[Interval]:
+        """
+        :return: the parts of [lo, hi) not covered by this set, in ascending order
+        """
+        result: List[Interval] = []
+        start = lo
+        for idx in range(bisect_right(self.his, lo), len(self.los)):
+            s_lo, s_hi = self.los[idx], self.his[idx]
+            if s_lo >= hi:
+                break
+            if s_lo > start:
+                result.append((start, s_lo))
+            start = max(start, s_hi)
+            if start >= hi:
+                break
+        if start < hi:
+            result.append((start, hi))
+        return result
+
+
+def common_box_x_range(polygons_by_child: Dict[int, List[kdb.PolygonWithProperties]]) -> Optional[Interval]:
+    """
+    The interval shielding is exact, if all polygons of an edge interval are boxes
+    sharing the same x range (then the region booleans degenerate to 1D).
+
+    :return: the common x range, or None if the polygon booleans are required
+    """
+    x_range: Optional[Interval] = None
+    for polygons in polygons_by_child.values():
+        for p in polygons:
+            if not p.is_box():
+                return None
+            bbox = p.bbox()
+            r = (bbox.left, bbox.right)
+            if x_range is None:
+                x_range = r
+            elif r != x_range:
+                return None
+    return x_range
@@ -0,0 +1,119 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from __future__ import annotations
+from dataclasses import dataclass
+from functools import cached_property
+from typing import *
+
+from klayout_pex.tech_info import TechInfo
+from klayout_pex.rcx25.types import LayerName
+
+
+@dataclass
+class LayerRelevance:
+    """
+    Static (geometry independent) relevance of layer pairs, derived from the parasitics tables.
+
+    For each inside layer, only those layers are passed as neighborhood children
+    that can either contribute a capacitance, or that can influence a contribution
+    (i.e. layers in between that are used as shields, or terminate the overlap search).
+
+    NOTE: the geometric shielding itself (partially covering shapes) still happens
+          dynamically in the visitors, only statically irrelevant pairs are pruned,
+          so the results are identical to a run that passes all layers.
+    """
+
+    all_layer_names: List[LayerName]
+    tech_info: TechInfo
+
+    def has_overlap_spec(self, top_layer_name: LayerName, bot_layer_name: LayerName) -> bool:
+        specs = self.tech_info.overlap_cap_by_layer_names.get(top_layer_name, None)
+        return bool(specs) and bool(specs.get(bot_layer_name, None))
+
+    def has_fringe_spec(self, inside_layer_name: LayerName, outside_layer_name: LayerName) -> bool:
+        if inside_layer_name == outside_layer_name:
+            return False
+        side_overlap_specs = self.tech_info.side_overlap_cap_by_layer_names.get(inside_layer_name, None)
+        if not side_overlap_specs or not side_overlap_specs.get(outside_layer_name, None):
+            return False
+        # NOTE: the fringe model needs the overlap spec as well (in either direction)
+        return self.has_overlap_spec(inside_layer_name, outside_layer_name) or \
+               self.has_overlap_spec(outside_layer_name, inside_layer_name)
+
+    def has_sidewall_spec(self, layer_name: LayerName) -> bool:
+        return layer_name in self.tech_info.sidewall_cap_by_layer_name
+
+    @cached_property
+    def overlap_layer_indices(self) -> Dict[int, List[int]]:
+        """
+        Per inside layer index: the indices of the layers above, that must be visited.
+
+        The overlap visitor looks upwards and stops at the first different-net polygon
+        on a layer without overlap spec, so layers without spec below the topmost
+        layer with spec are kept as well (they terminate the search).
+        """
+        indices: Dict[int, List[int]] = {}
+        for inside_idx, bot_layer_name in enumerate(self.all_layer_names):
+            above = [idx for idx in range(inside_idx + 1, len(self.all_layer_names))
+                     if self.has_overlap_spec(self.all_layer_names[idx], bot_layer_name)]
+            indices[inside_idx] = list(range(inside_idx + 1, max(above) + 1)) if above else []
+        return indices
+
+    @cached_property
+    def fringe_layer_indices(self) -> Dict[int, List[int]]:
+        """
+        Per inside layer index: the indices of the (other) layers, that receive fringe capacitance
+        """
+        indices: Dict[int, List[int]] = {}
+        for inside_idx, inside_layer_name in enumerate(self.all_layer_names):
+            indices[inside_idx] = [idx for idx, outside_layer_name in enumerate(self.all_layer_names)
+                                   if self.has_fringe_spec(inside_layer_name, outside_layer_name)]
+        return indices
+
+    @cached_property
+    def fringe_shield_layer_indices(self) -> Dict[int, List[int]]:
+        """
+        Per inside layer index: the indices of the (other) layers, that must be visited
+        by the fringe pass, i.e. the fringe layers and all layers in between,
+        which act as vertical shields
+        """
+        indices: Dict[int, List[int]] = {}
+        for inside_idx, fringe_indices in self.fringe_layer_indices.items():
+            below = [idx for idx in fringe_indices if idx < inside_idx]
+            above = [idx for idx in fringe_indices if idx > inside_idx]
+            shield_indices = []
+            if below:
+                shield_indices += range(min(below), inside_idx)
+            if above:
+                shield_indices += range(inside_idx + 1, max(above) + 1)
+            indices[inside_idx] = shield_indices
+        return indices
+
+    def needs_edge_pass(self, inside_layer_index: int) -> bool:
+        """
+        An edge neighborhood pass is only required, if the inside layer has sidewall or fringe capacitance
+        """
+        return self.has_sidewall_spec(self.all_layer_names[inside_layer_index]) or \
+               bool(self.fringe_layer_indices[inside_layer_index])
@@ -32,6 +32,7 @@ from klayout_pex.log import (
 from klayout_pex.tech_info import TechInfo
 
 from klayout_pex.rcx25.types import PolygonNeighborhood
+from klayout_pex.rcx25.c.layer_relevance import LayerRelevance
 from klayout_pex.rcx25.extraction_results import *
 from klayout_pex.rcx25.extraction_reporter import ExtractionReporter
 
@@ -43,29 +44,60 @@ class OverlapExtractor:
                  dbu: float,
                  tech_info: TechInfo,
                  results: CellExtractionResults,
-                 report: ExtractionReporter):
+                 report: ExtractionReporter,
+                 layer_relevance: Optional[LayerRelevance] = None,
+                 skip_substrate: bool = False,
+                 bottom_regions_by_name: Optional[Dict[LayerName, kdb.Region]] = None):
         self.all_layer_names = all_layer_names
         self.layer_regions_by_name = layer_regions_by_name
         self.dbu = dbu
         self.tech_info = tech_info
         self.results = results
         self.report = report
+        self.layer_relevance = layer_relevance
+        # NOTE: if set, the substrate area caps are handled by SubstrateExtractor
+        self.skip_substrate = skip_substrate
+        # NOTE: if set, only these polygons are visited as bottom polygons (see SweepOverlapExtractor),
+        #       the layers above are still taken from layer_regions_by_name
+        self.bottom_regions_by_name = bottom_regions_by_name
 
     def extract(self):
+        all_layer_regions = list(self.layer_regions_by_name.values())
+
         for idx, (layer_name, layer_region) in enumerate(self.layer_regions_by_name.items()):
+            if self.skip_substrate and layer_name == self.tech_info.internal_substrate_layer_name:
+                continue
+
+            if self.bottom_regions_by_name is not None:
+                layer_region = self.bottom_regions_by_name.get(layer_name, None)
+                if layer_region is None or layer_region.is_empty():
+                    continue
+
+            child_layer_indices: Optional[List[int]] = None
+            if self.layer_relevance is not None:
+                child_layer_indices = self.layer_relevance.overlap_layer_indices[idx]
+                if not child_layer_indices:
+                    continue
+
             ovl_visitor = self.PEXPolygonNeighborhoodVisitor(
                 layer_names=self.all_layer_names,
                 inside_layer_index=idx,
                 dbu=self.dbu,
                 tech_info=self.tech_info,
                 results=self.results,
-                report=self.report
+                report=self.report,
+                child_layer_indices=child_layer_indices
             )
 
             # See comment above: as we use the layers in the stack order,
             # the input index is also the metal layer index
-            ovl_children = [kdb.CompoundRegionOperationNode.new_secondary(r)
-                            for r in self.layer_regions_by_name.values()]
+            # (unless pruned, then the visitor maps the child index back to the layer index)
+            if child_layer_indices is None:
+                ovl_children = [kdb.CompoundRegionOperationNode.new_secondary(r)
+                                for r in all_layer_regions]
+            else:
+                ovl_children = [kdb.CompoundRegionOperationNode.new_secondary(all_layer_regions[li])
+                                for li in child_layer_indices]
 
             # We don't use a distance - hence only true overlaps will be considered
             ovl_node = kdb.CompoundRegionOperationNode.new_polygon_neighborhood(ovl_children, ovl_visitor)
@@ -79,7 +111,8 @@ class OverlapExtractor:
                      dbu: float,
                      tech_info: TechInfo,
                      results: CellExtractionResults,
-                     report: ExtractionReporter):
+                     report: ExtractionReporter,
+                     child_layer_indices: Optional[List[int]] = None):
             super().__init__()
             self.layer_names = layer_names
             self.inside_layer_index = inside_layer_index
@@ -87,6 +120,7 @@ class OverlapExtractor:
             self.tech_info = tech_info
             self.results = results
             self.report = report
+            self.child_layer_indices = child_layer_indices
 
         def neighbors(self,
                       layout: kdb.Layout,
@@ -95,6 +129,10 @@ class OverlapExtractor:
                       neighborhood: PolygonNeighborhood):
             # We just look "upwards", as we don't want to count areas twice
 
+            if self.child_layer_indices is not None:
+                neighborhood = {self.child_layer_indices[ci]: polygons
+                                for ci, polygons in neighborhood.items()}
+
             shielded_region = kdb.Region()
             bottom_region = kdb.Region(polygon)
             bot_layer_name = self.layer_names[self.inside_layer_index]
@@ -130,6 +168,13 @@ class OverlapExtractor:
 
                     overlap_area_um2 = overlap_area.area() * self.dbu ** 2
                     cap_femto = overlap_area_um2 * overlap_cap_spec.capacitance / 1000.0
+
+                    if self.results.moments is not None and overlap_area_um2 > 0.0:
+                        self.results.moments.add_overlap(OverlapKey(layer_top=top_layer_name,
+                                                                    net_top=net_top,
+                                                                    layer_bot=bot_layer_name,
+                                                                    net_bot=net_bot),
+                                                         overlap_area_um2)
                     # info(f"(Overlap): {top_layer_name}({net_top})-{bot_layer_name}({net_bot}): "
                     #     f"cap: {round(cap_femto, 2)} fF, "
                     #     f"area: {overlap_area_um2} µm^2")
@@ -147,9 +192,10 @@ class OverlapExtractor:
 
                         self.results.add_overlap_cap(cap)
 
-                        self.report.output_overlap(overlap_cap=cap,
-                                                   bottom_polygon=polygon,
-                                                   top_polygon=polygon_above,
-                                                   overlap_area=overlap_area)
+                        if self.report.accept('overlap', cap.key, cap.cap_value):
+                            self.report.output_overlap(overlap_cap=cap,
+                                                       bottom_polygon=polygon,
+                                                       top_polygon=polygon_above,
+                                                       overlap_area=overlap_area)
 
                     shielded_region.insert(polygon_above)
@@ -0,0 +1,453 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from __future__ import annotations
+from bisect import bisect_left
+from collections import defaultdict
+from dataclasses import dataclass, field
+from enum import StrEnum
+from typing import *
+
+import klayout.db as kdb
+
+from klayout_pex.log import (
+    info,
+    warning,
+)
+from klayout_pex.klayout.geometry_cache import LayerGeometry
+from klayout_pex.tech_info import TechInfo
+
+from klayout_pex.rcx25.c.box_kernels import BoxTuple
+from klayout_pex.rcx25.c.layer_relevance import LayerRelevance
+from klayout_pex.rcx25.c.overlap_extractor import OverlapExtractor
+from klayout_pex.rcx25.extraction_results import *
+from klayout_pex.rcx25.extraction_reporter import ExtractionReporter
+
+
+class OverlapEngine(StrEnum):
+    NEIGHBORHOOD = "neighborhood"  # one polygon neighborhood pass per bottom layer (OverlapExtractor)
+    SWEEP = "sweep"                # single plane sweep over the whole stack (SweepOverlapExtractor)
+    DEFAULT = "neighborhood"
+
+
+# (x1, y1, x2, y2, layer index, net, polygon id)
+SweepBox = Tuple[int, int, int, int, int, NetName, int]
+
+# (top layer index, top net, bottom layer index, bottom net)
+OverlapAreaKey = Tuple[int, NetName, int, NetName]
+
+# (bottom polygon id, top polygon id)
+PolygonPair = Tuple[int, int]
+
+
+@dataclass
+class PairOverlap:
+    area: int = 0  # dbu²
+    cells: List[BoxTuple] = field(default_factory=list)  # only if collected
+
+
+class SweepSegment:
+    """
+    Part [ys[i], ys[i+1]) of the sweep line with constant occupancy.
+    The overlap contributions are evaluated when the occupancy changes,
+    the areas are accumulated lazily (since_x) when the segment is changed the next time.
+    """
+    __slots__ = ('occupants', 'since_x', 'contributions', 'stops')
+
+    def __init__(self,
+                 occupants: Dict[int, SweepBox],
+                 since_x: int,
+                 contributions: List[PolygonPair],
+                 stops: List[Tuple[int, int]]):
+        self.occupants = occupants          # by box index
+        self.since_x = since_x
+        self.contributions = contributions  # (bottom polygon id, top polygon id) pairs
+        self.stops = stops                  # (bottom polygon id, top layer index) where the search is stopped
+
+    def copy(self) -> SweepSegment:
+        return SweepSegment(occupants=dict(self.occupants),
+                            since_x=self.since_x,
+                            contributions=self.contributions,
+                            stops=self.stops)
+
+
+class OverlapSweep:
+    """
+    Plane sweep over the boxes of all layers of the stack.
+
+    The sweep line (along y) is kept as sorted segments of constant layer occupancy,
+    which are only split, updated and merged where boxes start or end (x events).
+    The overlap contributions of a segment (for all layer pairs, including shielding
+    by the layers in between) are evaluated once per occupancy change,
+    and its area is accumulated when it changes the next time.
+
+    The semantics are the same as in OverlapExtractor.PEXPolygonNeighborhoodVisitor:
+        - for each bottom shape, the layers above are visited in stack order
+        - shapes of the same net are skipped (and do not shield)
+        - the first different-net shape above wins, and shields everything beyond
+        - a different-net shape on a layer without overlap spec
+          stops the search for the whole bottom polygon (from that layer on)
+    """
+
+    def __init__(self,
+                 layer_count: int,
+                 has_overlap_spec: Callable[[int, int], bool]):  # (top layer index, bottom layer index)
+        self.layer_count = layer_count
+        self.has_overlap_spec = has_overlap_spec
+        self.boxes: List[SweepBox] = []
+        # NOTE: boxes of these polygons only act as top / shield (their bottom side is extracted elsewhere)
+        self.top_only_polygon_ids: Set[int] = set()
+        self.bottom_net_override: Dict[int, NetName] = {}
+
+        self.ys: List[int] = []
+        self.segments: List[SweepSegment] = []
+        self.collect_cells = False
+        self.overlap_by_pair: Dict[PolygonPair, PairOverlap] = defaultdict(PairOverlap)
+        self.stop_layer_by_polygon: Dict[int, int] = {}
+
+    def add_box(self,
+                x1: int, y1: int, x2: int, y2: int,
+                layer_index: int,
+                net: NetName,
+                polygon_id: int,
+                top_only: bool = False):
+        if x2 <= x1 or y2 <= y1:
+            return
+        self.boxes.append((x1, y1, x2, y2, layer_index, net, polygon_id))
+        if top_only:
+            self.top_only_polygon_ids.add(polygon_id)
+
+    def evaluate(self, occupants: Dict[int, SweepBox]) -> Tuple[List[PolygonPair], List[Tuple[int, int]]]:
+        contributions: List[PolygonPair] = []
+        stops: List[Tuple[int, int]] = []
+        stack = sorted(occupants.values(), key=lambda b: (b[4], b[6]))  # stable order, like the neighborhood
+        for i, bottom in enumerate(stack):
+            bot_layer_index, polygon_id = bottom[4], bottom[6]
+            if polygon_id in self.top_only_polygon_ids:
+                continue
+            net_bot = self.bottom_net_override.get(bot_layer_index, bottom[5])
+            shielded = False
+            for top in stack[i + 1:]:
+                top_layer_index = top[4]
+                if top_layer_index == bot_layer_index or top[5] == net_bot:
+                    continue
+                if not self.has_overlap_spec(top_layer_index, bot_layer_index):
+                    stops.append((polygon_id, top_layer_index))
+                    break
+                if not shielded:
+                    contributions.append((polygon_id, top[6]))
+                    shielded = True
+        return contributions, stops
+
+    def flush(self, idx: int, x: int):
+        seg = self.segments[idx]
+        width = x - seg.since_x
+        seg.since_x = x
+        if width <= 0 or not seg.occupants:
+            return
+        y1, y2 = self.ys[idx], self.ys[idx + 1]
+        area = width * (y2 - y1)
+        for pair in seg.contributions:
+            overlap = self.overlap_by_pair[pair]
+            overlap.area += area
+            if self.collect_cells:
+                overlap.cells.append((x - width, y1, x, y2))
+        for polygon_id, top_layer_index in seg.stops:
+            stop = self.stop_layer_by_polygon.get(polygon_id, self.layer_count)
+            if top_layer_index < stop:
+                self.stop_layer_by_polygon[polygon_id] = top_layer_index
+
+    def split(self, y: int, x: int) -> int:
+        """
+        :return: index of breakpoint y, inserted if necessary
+        """
+        idx = bisect_left(self.ys, y)
+        if idx < len(self.ys) and self.ys[idx] == y:
+            return idx
+        if not self.ys:
+            self.ys.append(y)
+        elif idx == 0:
+            self.ys.insert(0, y)
+            self.segments.insert(0, SweepSegment(occupants={}, since_x=x, contributions=[], stops=[]))
+        elif idx == len(self.ys):
+            self.ys.append(y)
+            self.segments.append(SweepSegment(occupants={}, since_x=x, contributions=[], stops=[]))
+        else:
+            # NOTE: both halves keep the pending area, each accumulates its own height
+            self.ys.insert(idx, y)
+            self.segments.insert(idx, self.segments[idx - 1].copy())
+        return idx
+
+    def try_merge(self, idx: int, x: int):
+        """
+        Removes breakpoint idx, if the segments on both sides have the same occupancy
+        """
+        if idx <= 0 or idx >= len(self.segments):
+            return
+        below, above = self.segments[idx - 1], self.segments[idx]
+        if below.occupants.keys() != above.occupants.keys():
+            return
+        self.flush(idx - 1, x)
+        self.flush(idx, x)
+        del self.ys[idx]
+        del self.segments[idx]
+
+    def trim(self):
+        while self.segments and not self.segments[0].occupants:
+            del self.ys[0]
+            del self.segments[0]
+        while self.segments and not self.segments[-1].occupants:
+            del self.ys[-1]
+            del self.segments[-1]
+        if not self.segments:
+            self.ys.clear()
+
+    def update(self, box_index: int, box: SweepBox, x: int, insert: bool):
+        i1 = self.split(box[1], x)
+        i2 = self.split(box[3], x)
+        for idx in range(i1, i2):
+            self.flush(idx, x)
+            seg = self.segments[idx]
+            if insert:
+                seg.occupants[box_index] = box
+            else:
+                del seg.occupants[box_index]
+            seg.contributions, seg.stops = self.evaluate(seg.occupants)
+        if not insert:
+            self.try_merge(i2, x)
+            self.try_merge(i1, x)
+            self.trim()
+
+    def sweep(self,
+              bottom_net_override: Dict[int, NetName],
+              collect_cells: bool = False) -> Dict[PolygonPair, PairOverlap]:
+        """
+        :param bottom_net_override: net names used for bottom layers by layer index (i.e. the substrate)
+        :param collect_cells: also return the cells (rectangles) making up each overlap area
+        :return: overlap area per (bottom polygon id, top polygon id),
+                 without the pairs beyond a stop layer of the bottom polygon
+        """
+        self.bottom_net_override = bottom_net_override
+        self.collect_cells = collect_cells
+        self.ys, self.segments = [], []
+        self.overlap_by_pair = defaultdict(PairOverlap)
+        self.stop_layer_by_polygon = {}
+
+        events: List[Tuple[int, int, int]] = []  # (x, 0 = remove / 1 = insert, box index)
+        for box_index, b in enumerate(self.boxes):
+            events.append((b[0], 1, box_index))
+            events.append((b[2], 0, box_index))
+        events.sort()
+
+        for x, insert, box_index in events:
+            self.update(box_index, self.boxes[box_index], x, insert=insert == 1)
+
+        layer_by_polygon = {b[6]: b[4] for b in self.boxes}
+        return {pair: overlap for pair, overlap in self.overlap_by_pair.items()
+                if layer_by_polygon[pair[1]] < self.stop_layer_by_polygon.get(pair[0], self.layer_count)}
+
+    def overlap_areas(self,
+                      bottom_net_override: Dict[int, NetName]) -> Dict[OverlapAreaKey, int]:
+        """
+        :param bottom_net_override: net names used for bottom layers by layer index (i.e. the substrate)
+        :return: overlap areas (in dbu²) per top layer / net and bottom layer / net
+        """
+        info_by_polygon = {b[6]: (b[4], b[5]) for b in self.boxes}
+        areas: Dict[OverlapAreaKey, int] = defaultdict(int)
+        for (bottom_id, top_id), overlap in self.sweep(bottom_net_override).items():
+            bot_layer_index, net_bot = info_by_polygon[bottom_id]
+            top_layer_index, net_top = info_by_polygon[top_id]
+            net_bot = bottom_net_override.get(bot_layer_index, net_bot)
+            areas[(top_layer_index, net_top, bot_layer_index, net_bot)] += overlap.area
+        return areas
+
+
+class SweepOverlapExtractor:
+    """
+    Overlap extraction using OverlapSweep.
+
+    Non-rectilinear polygons can't be decomposed into boxes, so as bottom polygons,
+    they are extracted by OverlapExtractor. The same holds for the bottom polygons
+    interacting with non-rectilinear polygons above (as those may overlap or shield them),
+    in the sweep, these only act as top polygons / shields.
+    """
+
+    def __init__(self,
+                 all_layer_names: List[LayerName],
+                 layer_regions_by_name: Dict[LayerName, kdb.Region],
+                 dbu: float,
+                 tech_info: TechInfo,
+                 results: CellExtractionResults,
+                 report: ExtractionReporter,
+                 layer_relevance: Optional[LayerRelevance] = None,
+                 skip_substrate: bool = False,
+                 layer_geometry_by_name: Optional[Dict[LayerName, LayerGeometry]] = None):
+        self.all_layer_names = all_layer_names
+        self.layer_regions_by_name = layer_regions_by_name
+        self.dbu = dbu
+        self.tech_info = tech_info
+        self.results = results
+        self.report = report
+        self.layer_relevance = layer_relevance or LayerRelevance(all_layer_names=all_layer_names,
+                                                                 tech_info=tech_info)
+        # NOTE: if set, the substrate area caps are handled by SubstrateExtractor
+        self.skip_substrate = skip_substrate
+        # NOTE: rectangle decompositions shared with the other engines (see GeometryCache)
+        self.layer_geometry_by_name = layer_geometry_by_name or {}
+
+    def layer_geometry(self, layer_name: LayerName) -> LayerGeometry:
+        geometry = self.layer_geometry_by_name.get(layer_name, None)
+        if geometry is None:
+            geometry = LayerGeometry(region=self.layer_regions_by_name[layer_name])
+        return geometry
+
+    def fallback_polygon_indices(self, layer_names: List[LayerName]) -> Dict[LayerName, Set[int]]:
+        """
+        :return: per layer, the indices (see LayerGeometry.polygons) of the bottom polygons
+                 to be extracted by OverlapExtractor
+        """
+        fallback: Dict[LayerName, Set[int]] = {}
+        non_rectilinear_above = kdb.Region()
+        for layer_name in reversed(layer_names):
+            geometry = self.layer_geometry(layer_name)
+            indices: Set[int] = set()
+            above_bbox = non_rectilinear_above.bbox()
+            for idx, (p, boxes) in enumerate(zip(geometry.polygons, geometry.rectangles)):
+                if boxes is None:
+                    indices.add(idx)
+                elif not non_rectilinear_above.is_empty() and p.bbox().touches(above_bbox) and \
+                     not kdb.Region(p).interacting(non_rectilinear_above).is_empty():
+                    indices.add(idx)
+            if indices:
+                fallback[layer_name] = indices
+            for p, boxes in zip(geometry.polygons, geometry.rectangles):
+                if boxes is None:
+                    non_rectilinear_above.insert(p)
+        return fallback
+
+    def extract_fallback(self, fallback: Dict[LayerName, Set[int]]):
+        bottom_regions_by_name: Dict[LayerName, kdb.Region] = {}
+        for layer_name, indices in fallback.items():
+            geometry = self.layer_geometry(layer_name)
+            region = kdb.Region()
+            region.enable_properties()
+            for idx in sorted(indices):
+                region.insert(geometry.polygons[idx])
+            bottom_regions_by_name[layer_name] = region
+            warning(f"Overlap sweep: {len(indices)} polygon(s) on layer {layer_name} are not rectilinear "
+                    f"or interact with non-rectilinear polygons above, "
+                    f"using the neighborhood engine for them")
+
+        OverlapExtractor(all_layer_names=self.all_layer_names,
+                         layer_regions_by_name=self.layer_regions_by_name,
+                         dbu=self.dbu,
+                         tech_info=self.tech_info,
+                         results=self.results,
+                         report=self.report,
+                         layer_relevance=self.layer_relevance,
+                         skip_substrate=self.skip_substrate,
+                         bottom_regions_by_name=bottom_regions_by_name).extract()
+
+    def extract(self):
+        def has_overlap_spec(top_layer_index: int, bot_layer_index: int) -> bool:
+            return self.layer_relevance.has_overlap_spec(self.all_layer_names[top_layer_index],
+                                                         self.all_layer_names[bot_layer_index])
+
+        sweep = OverlapSweep(layer_count=len(self.all_layer_names),
+                             has_overlap_spec=has_overlap_spec)
+
+        layer_names = [ln for ln in self.layer_regions_by_name.keys()
+                       if not (self.skip_substrate and ln == self.tech_info.internal_substrate_layer_name)]
+        fallback = self.fallback_polygon_indices(layer_names)
+
+        # (layer index, polygon) per polygon id
+        polygons_by_id: List[Tuple[int, kdb.PolygonWithProperties]] = []
+        for layer_index, layer_name in enumerate(self.layer_regions_by_name.keys()):
+            if layer_name not in layer_names:
+                continue
+            geometry = self.layer_geometry(layer_name)
+            fallback_indices = fallback.get(layer_name, set())
+            for idx, (p, boxes) in enumerate(zip(geometry.polygons, geometry.rectangles)):
+                if boxes is None:
+                    continue
+                polygon_id = len(polygons_by_id)
+                polygons_by_id.append((layer_index, p))
+                net = p.property('net')
+                for left, bottom, right, top in boxes:
+                    sweep.add_box(left, bottom, right, top, layer_index, net, polygon_id,
+                                  top_only=idx in fallback_indices)
+
+        info(f"Overlap sweep over {len(sweep.boxes)} boxes")
+
+        substrate_layer_name = self.tech_info.internal_substrate_layer_name
+        bottom_net_override = {idx: substrate_layer_name
+                               for idx, ln in enumerate(self.all_layer_names)
+                               if ln == substrate_layer_name}
+
+        overlap_by_pair = sweep.sweep(bottom_net_override=bottom_net_override,
+                                      collect_cells=self.report.report_level.keeps_items())
+
+        # NOTE: same order as the neighborhood engine (by bottom layer, bottom polygon, top layer)
+        def pair_order(pair: PolygonPair) -> Tuple[int, int, int, int]:
+            bottom_id, top_id = pair
+            return polygons_by_id[bottom_id][0], bottom_id, polygons_by_id[top_id][0], top_id
+
+        for pair in sorted(overlap_by_pair.keys(), key=pair_order):
+            overlap = overlap_by_pair[pair]
+            bot_idx, bottom_polygon = polygons_by_id[pair[0]]
+            top_idx, top_polygon = polygons_by_id[pair[1]]
+            top_layer_name = self.all_layer_names[top_idx]
+            bot_layer_name = self.all_layer_names[bot_idx]
+            overlap_cap_spec = self.tech_info.overlap_cap_by_layer_names[top_layer_name][bot_layer_name]
+
+            net_top = top_polygon.property('net')
+            net_bot = bottom_net_override.get(bot_idx, bottom_polygon.property('net'))
+
+            overlap_area_um2 = overlap.area * self.dbu ** 2
+            cap_femto = overlap_area_um2 * overlap_cap_spec.capacitance / 1000.0
+            ovk = OverlapKey(layer_top=top_layer_name,
+                             net_top=net_top,
+                             layer_bot=bot_layer_name,
+                             net_bot=net_bot)
+            if self.results.moments is not None and overlap_area_um2 > 0.0:
+                self.results.moments.add_overlap(ovk, overlap_area_um2)
+            if cap_femto > 0.0:
+                cap = OverlapCap(key=ovk,
+                                 cap_value=cap_femto,
+                                 shielded_area=0.0,
+                                 unshielded_area=0.0,
+                                 tech_spec=overlap_cap_spec)
+                self.results.add_overlap_cap(cap)
+
+                if self.report.accept('overlap', cap.key, cap.cap_value):
+                    overlap_area = kdb.Region()
+                    for left, bottom, right, top in overlap.cells:
+                        overlap_area.insert(kdb.Box(left, bottom, right, top))
+                    self.report.output_overlap(overlap_cap=cap,
+                                               bottom_polygon=bottom_polygon,
+                                               top_polygon=top_polygon,
+                                               overlap_area=overlap_area.merged())
+
+        if fallback:
+            self.extract_fallback(fallback)
@@ -24,7 +24,6 @@
 #
 
 from functools import cached_property
-import math
 
 import klayout.db as kdb
 
@@ -37,6 +36,19 @@ from klayout_pex.log import (
 from klayout_pex.tech_info import TechInfo
 
 from klayout_pex.rcx25.c.geometry_restorer import GeometryRestorer
+from klayout_pex.rcx25.c.interval_shield import IntervalSet, common_box_x_range
+from klayout_pex.rcx25.c.batch_kernels import CapBatch
+from klayout_pex.rcx25.c.box_kernels import BoxTuple, rectilinear_boxes, fringe_spans, lower_envelope, covered_area
+from klayout_pex.rcx25.c.cap_formulas import FRINGE_CAP_THRESHOLD, fringe_cap_femto, sidewall_cap_femto
+from klayout_pex.rcx25.c.cross_section_tables import (
+    CROSS_SECTION_COVERAGE,
+    CrossSectionTable,
+    CrossSectionTables,
+    coupling_cap_femto,
+)
+from klayout_pex.rcx25.c.fringe_halo import AdaptiveFringeHalo, fringe_alpha, separate_fringe_pass
+from klayout_pex.rcx25.c.fringe_tables import FringeFractionTables
+from klayout_pex.rcx25.c.layer_relevance import LayerRelevance
 from klayout_pex.rcx25.extraction_results import *
 from klayout_pex.rcx25.extraction_reporter import ExtractionReporter
 from klayout_pex.rcx25.c.polygon_utils import find_polygon_with_nearest_edge, nearest_edge
@@ -52,7 +64,15 @@ class SidewallAndFringeExtractor:
                  scale_ratio_to_fit_halo: bool,
                  tech_info: TechInfo,
                  results: CellExtractionResults,
-                 report: ExtractionReporter):
+                 report: ExtractionReporter,
+                 layer_relevance: Optional[LayerRelevance] = None,
+                 adaptive_halo: Optional[AdaptiveFringeHalo] = None,
+                 batch_kernels: bool = False,
+                 interval_shielding: bool = False,
+                 substrate_fast_path: bool = False,
+                 box_kernels: bool = False,
+                 fringe_tables: Optional[FringeFractionTables] = None,
+                 cross_section_tables: Optional[CrossSectionTables] = None):
         self.all_layer_names = all_layer_names
         self.layer_regions_by_name = layer_regions_by_name
         self.dbu = dbu
@@ -60,44 +80,134 @@ class SidewallAndFringeExtractor:
         self.tech_info = tech_info
         self.results = results
         self.report = report
+        self.layer_relevance = layer_relevance
+        self.adaptive_halo = adaptive_halo
+        self.batch_kernels = batch_kernels
+        self.interval_shielding = interval_shielding
+        self.substrate_fast_path = substrate_fast_path
+        self.box_kernels = box_kernels
+        self.fringe_tables = fringe_tables
+        self.cross_section_tables = cross_section_tables
 
-        self.all_layer_regions = layer_regions_by_name.values()
+        self.all_layer_regions = list(layer_regions_by_name.values())
 
-    def extract(self):
-        for idx, (layer_name, layer_region) in enumerate(self.layer_regions_by_name.items()):
-            other_layer_regions = [
-                r for ln, r in self.layer_regions_by_name.items()
-                if ln != layer_name
-            ]
+    @cached_property
+    def shape_counts(self) -> List[int]:
+        return [r.count() for r in self.all_layer_regions]
 
-            en_visitor = self.PEXEdgeNeighborhoodVisitor(
-                all_layer_names=self.all_layer_names,
-                inside_layer_index=idx,
-                dbu=self.dbu,
-                scale_ratio_to_fit_halo=self.scale_ratio_to_fit_halo,
-                tech_info=self.tech_info,
-                results=self.results,
-                report=self.report
-            )
-
-            en_children = [kdb.CompoundRegionOperationNode.new_secondary(r)
-                           for r in self.all_layer_regions]
-            en_children[idx] = kdb.CompoundRegionOperationNode.new_foreign()  # sidewall of other nets on the same layer
-            en_children.append(kdb.CompoundRegionOperationNode.new_primary()) # opposing structures of the same polygon
+    def extract(self):
+        substrate_layer_index: Optional[int] = None
+        if self.substrate_fast_path and self.tech_info.internal_substrate_layer_name in self.all_layer_names:
+            substrate_layer_index = self.all_layer_names.index(self.tech_info.internal_substrate_layer_name)
 
+        for idx, (layer_name, layer_region) in enumerate(self.layer_regions_by_name.items()):
+            child_layer_indices: Optional[List[int]] = None
+            fringe_layer_indices: Optional[Set[int]] = None
+            if self.layer_relevance is not None:
+                if not self.layer_relevance.needs_edge_pass(idx):
+                    continue
+                # NOTE: the inside layer itself is the foreign child (sidewall),
+                #       the primary child keeps its index len(all_layer_names)
+                child_layer_indices = sorted(self.layer_relevance.fringe_shield_layer_indices[idx] + [idx])
+                child_layer_indices.append(len(self.all_layer_names))
+                fringe_layer_indices = set(self.layer_relevance.fringe_layer_indices[idx])
+
+            # NOTE: with the substrate fast path, the substrate is not passed as a child,
+            #       the visitor synthesizes it per edge interval instead
+            if substrate_layer_index is not None:
+                if idx == substrate_layer_index:
+                    continue
+                if child_layer_indices is None:
+                    child_layer_indices = list(range(0, len(self.all_layer_names) + 1))
+                child_layer_indices = [li for li in child_layer_indices if li != substrate_layer_index]
+
+            # NOTE: the adaptive halo only limits fringe, sidewall coupling always spans the side halo.
+            #       If the fringe halo is smaller (and it pays off, see separate_fringe_pass),
+            #       sidewall and fringe are extracted in separate passes,
+            #       so the fringe pass queries the smaller neighborhood
             side_halo_um = self.tech_info.tech.process_parasitics.side_halo
-            side_halo_dbu = int(side_halo_um / self.dbu) + 1  # add 1 nm to halo
+            fringe_halo_um = side_halo_um
+            if self.adaptive_halo is not None:
+                fringe_halo_um = self.adaptive_halo.halo_by_layer_index[idx].halo_um
 
-            en_node = kdb.CompoundRegionOperationNode.new_edge_neighborhood(
-                children=en_children,
-                visitor=en_visitor,
-                bext=-1, # NOTE: -1 dbu, suppresses quasi-empty contributions (will also suppress 90° edges)
-                eext=-1, # NOTE: -1 dbu, suppresses quasi-empty contributions (will also suppress 90° edges)
-                din=-1,  # NOTE: -1 dbu, suppresses the edge itself appearing as a pseudo-polygon in new_primary()
-                dout=side_halo_dbu # dout
-            )
+            batch: Optional[CapBatch] = None
+            if self.batch_kernels:
+                batch = CapBatch(side_halo=side_halo_um,
+                                 scale_ratio_to_fit_halo=self.scale_ratio_to_fit_halo,
+                                 fringe_tables=self.fringe_tables)
 
-            layer_region.complex_op(en_node)
+            side_halo_dbu = int(side_halo_um / self.dbu) + 1  # add 1 nm to halo
+            fringe_halo_dbu = int(fringe_halo_um / self.dbu) + 1
+
+            child_shape_count = sum(self.shape_counts[li]
+                                    for li in (child_layer_indices or range(len(self.all_layer_names)))
+                                    if li < len(self.all_layer_names))
+
+            # (child layer indices, dout, emit sidewalls, emit fringes)
+            passes: List[Tuple[Optional[List[int]], int, bool, bool]]
+            if separate_fringe_pass(side_halo_um=side_halo_um,
+                                    fringe_halo_um=fringe_halo_um,
+                                    inside_shape_count=self.shape_counts[idx],
+                                    child_shape_count=child_shape_count):
+                # NOTE: the sidewall pass needs the other layers only to classify the gap (see cross_section_table)
+                sidewall_child_layer_indices = child_layer_indices if self.cross_section_tables is not None \
+                                               else [idx]
+                passes = [(sidewall_child_layer_indices, side_halo_dbu, True, False),
+                          (child_layer_indices, fringe_halo_dbu, False, True)]
+            else:
+                passes = [(child_layer_indices, side_halo_dbu, True, True)]
+
+            for pass_child_layer_indices, dout, emit_sidewalls, emit_fringes in passes:
+                en_visitor = self.PEXEdgeNeighborhoodVisitor(
+                    all_layer_names=self.all_layer_names,
+                    inside_layer_index=idx,
+                    dbu=self.dbu,
+                    scale_ratio_to_fit_halo=self.scale_ratio_to_fit_halo,
+                    tech_info=self.tech_info,
+                    results=self.results,
+                    report=self.report,
+                    child_layer_indices=pass_child_layer_indices,
+                    fringe_layer_indices=fringe_layer_indices,
+                    side_halo=side_halo_um,
+                    fringe_halo=fringe_halo_um,
+                    batch=batch,
+                    interval_shielding=self.interval_shielding,
+                    substrate_layer_index=substrate_layer_index,
+                    substrate_halo_dbu=fringe_halo_dbu,
+                    box_kernels=self.box_kernels,
+                    cross_section_tables=self.cross_section_tables,
+                    emit_sidewalls=emit_sidewalls,
+                    emit_fringes=emit_fringes
+                )
+
+                if pass_child_layer_indices is None:
+                    en_children = [kdb.CompoundRegionOperationNode.new_secondary(r)
+                                   for r in self.all_layer_regions]
+                    en_children[idx] = kdb.CompoundRegionOperationNode.new_foreign()  # sidewall of other nets on the same layer
+                    en_children.append(kdb.CompoundRegionOperationNode.new_primary()) # opposing structures of the same polygon
+                else:
+                    en_children = []
+                    for li in pass_child_layer_indices:
+                        if li == idx:
+                            en_children.append(kdb.CompoundRegionOperationNode.new_foreign())
+                        elif li == len(self.all_layer_names):
+                            en_children.append(kdb.CompoundRegionOperationNode.new_primary())
+                        else:
+                            en_children.append(kdb.CompoundRegionOperationNode.new_secondary(self.all_layer_regions[li]))
+
+                en_node = kdb.CompoundRegionOperationNode.new_edge_neighborhood(
+                    children=en_children,
+                    visitor=en_visitor,
+                    bext=-1, # NOTE: -1 dbu, suppresses quasi-empty contributions (will also suppress 90° edges)
+                    eext=-1, # NOTE: -1 dbu, suppresses quasi-empty contributions (will also suppress 90° edges)
+                    din=-1,  # NOTE: -1 dbu, suppresses the edge itself appearing as a pseudo-polygon in new_primary()
+                    dout=dout
+                )
+
+                layer_region.complex_op(en_node)
+
+            if batch is not None:
+                batch.flush(self.results)
 
     # ------------------------------------------------------------------------
 
@@ -109,7 +219,19 @@ class SidewallAndFringeExtractor:
                      tech_info: TechInfo,
                      scale_ratio_to_fit_halo: bool,
                      results: CellExtractionResults,
-                     report: ExtractionReporter):
+                     report: ExtractionReporter,
+                     child_layer_indices: Optional[List[int]] = None,
+                     fringe_layer_indices: Optional[Set[int]] = None,
+                     side_halo: Optional[float] = None,
+                     fringe_halo: Optional[float] = None,
+                     batch: Optional[CapBatch] = None,
+                     interval_shielding: bool = False,
+                     substrate_layer_index: Optional[int] = None,
+                     substrate_halo_dbu: int = 0,
+                     box_kernels: bool = False,
+                     cross_section_tables: Optional[CrossSectionTables] = None,
+                     emit_sidewalls: bool = True,
+                     emit_fringes: bool = True):
             super().__init__()
 
             self.all_layer_names = all_layer_names
@@ -119,6 +241,33 @@ class SidewallAndFringeExtractor:
             self.scale_ratio_to_fit_halo = scale_ratio_to_fit_halo
             self.results = results
             self.report = report
+            # NOTE: if the children were pruned (see LayerRelevance),
+            #       child_layer_indices maps the child index back to the layer index,
+            #       and only fringe_layer_indices receive fringe, the others are shields only
+            self.child_layer_indices = child_layer_indices
+            self.fringe_layer_indices = fringe_layer_indices
+            # NOTE: if given, contributions are only recorded, and evaluated after the pass
+            self.batch = batch
+            # NOTE: if enabled, edge intervals where all shapes are boxes spanning the same x range
+            #       are shielded using 1D interval arithmetic instead of region booleans
+            self.interval_shielding = interval_shielding
+            # NOTE: if given, the substrate was not passed as a child (see substrate_fast_path)
+            self.substrate_layer_index = substrate_layer_index
+            self.substrate_halo_dbu = substrate_halo_dbu
+            # NOTE: if enabled, rectilinear polygons are evaluated per rectangle (see box_kernels)
+            self.box_kernels = box_kernels
+            # NOTE: if given, sidewall coupling is interpolated from the tables pre-solved by kpex_cross_sections,
+            #       for the width of the polygon and the layers below / above the gap
+            self.cross_section_tables = cross_section_tables
+            self.polygon: Optional[kdb.PolygonWithProperties] = None
+            self.side_halo = self.tech_info.tech.process_parasitics.side_halo if side_halo is None else side_halo
+            # NOTE: fringe is only evaluated up to fringe_halo (see AdaptiveFringeHalo),
+            #       but still normalized to the side halo (see scale_ratio_to_fit_halo)
+            self.fringe_halo = self.side_halo if fringe_halo is None else fringe_halo
+            self.fringe_halo_dbu = int(self.fringe_halo / self.dbu) + 1
+            # NOTE: sidewall and fringe may be extracted in separate passes with different halos
+            self.emit_sidewalls = emit_sidewalls
+            self.emit_fringes = emit_fringes
 
             # NOTE: prepare layers below and layers above the "inside" layer,
             #       each prepared for iteration that allows iterativly growing a shield region
@@ -134,15 +283,12 @@ class SidewallAndFringeExtractor:
                           layout: kdb.Layout,
                           cell: kdb.Cell,
                           polygon: kdb.Polygon):
-            pass
+            if self.cross_section_tables is not None:
+                self.polygon = polygon
 
         def end_polygon(self):
             pass
 
-        @cached_property
-        def side_halo(self) -> float:
-            return self.tech_info.tech.process_parasitics.side_halo
-
         def on_edge(self,
                     layout: kdb.Layout,
                     cell: kdb.Cell,
@@ -155,6 +301,17 @@ class SidewallAndFringeExtractor:
             #
             geometry_restorer = GeometryRestorer(self.to_original_trans(edge))
 
+            if self.child_layer_indices is not None:
+                neighborhood = [
+                    (edge_interval, {self.child_layer_indices[ci]: polygons
+                                     for ci, polygons in polygons_by_child.items()})
+                    for edge_interval, polygons_by_child in neighborhood
+                ]
+
+            if self.emit_fringes and self.substrate_layer_index is not None and \
+               (self.fringe_layer_indices is None or self.substrate_layer_index in self.fringe_layer_indices):
+                neighborhood = self.with_substrate(edge=edge, neighborhood=neighborhood)
+
             if get_log_level() == LogLevel.DEBUG:
                 self.report.output_edge_neighborhood(inside_layer=self.inside_layer_name,
                                                      all_layer_names=self.all_layer_names,
@@ -173,10 +330,22 @@ class SidewallAndFringeExtractor:
                             f"expected to be dropped due to bext/eext parameters, skipping…")
                     continue
 
-                layer_fringe_shields = [kdb.Region() for _ in self.all_layer_names]
-                for child_index, polygons in polygons_by_child.items():
-                    if child_index < len(self.all_layer_names):
-                        layer_fringe_shields[child_index].insert(polygons)
+                use_intervals = self.interval_shielding and \
+                                common_box_x_range(polygons_by_child) is not None
+
+                if self.emit_fringes:
+                    if use_intervals:
+                        layer_fringe_shield_intervals = [IntervalSet() for _ in self.all_layer_names]
+                        for child_index, polygons in polygons_by_child.items():
+                            if child_index < len(self.all_layer_names):
+                                for p in polygons:
+                                    bbox = p.bbox()
+                                    layer_fringe_shield_intervals[child_index].add(bbox.bottom, bbox.top)
+                    else:
+                        layer_fringe_shields = [kdb.Region() for _ in self.all_layer_names]
+                        for child_index, polygons in polygons_by_child.items():
+                            if child_index < len(self.all_layer_names):
+                                layer_fringe_shields[child_index].insert(polygons)
 
                 # NOTE: lateral fringe shielding, can be caused by
                 #         - sidewall (other net)
@@ -206,14 +375,27 @@ class SidewallAndFringeExtractor:
                             nearest_distance = distance
                             nearest_lateral_edge = nearest_edge(nearby_polygon)
 
+                        if not self.emit_sidewalls:
+                            continue
+
+                        cross_section_table: Optional[CrossSectionTable] = None
+                        if self.cross_section_tables is not None:
+                            cross_section_table = self.cross_section_table(polygons_by_child=polygons_by_child,
+                                                                           edge_interval=edge_interval,
+                                                                           gap_dbu=distance)
+
                         self.emit_sidewall(
                             layer_name=self.inside_layer_name,
                             edge=edge,
                             edge_interval=edge_interval,
                             polygon=nearby_polygon,
-                            geometry_restorer=geometry_restorer
+                            geometry_restorer=geometry_restorer,
+                            cross_section_table=cross_section_table
                         )
 
+                if not self.emit_fringes:
+                    continue
+
                 lateral_shield: Optional[kdb.Polygon] = None
                 if nearest_lateral_edge is not None:
                     lateral_shield = kdb.Polygon([
@@ -223,19 +405,41 @@ class SidewallAndFringeExtractor:
                         kdb.Point(nearest_lateral_edge.p2.x, (self.side_halo + 10) / self.dbu),
                     ])
 
+                lateral_shield_intervals: Optional[IntervalSet] = None
+                if use_intervals:
+                    lateral_shield_intervals = IntervalSet()
+                    if lateral_shield is not None:
+                        lateral_bbox = lateral_shield.bbox()
+                        lateral_shield_intervals.add(lateral_bbox.bottom, lateral_bbox.top)
+
                 for child_index, polygons in polygons_by_child.items():
                     if self.inside_layer_index == child_index:
                         continue  # already handled above
                     elif child_index < len(self.all_layer_names): # FRINGE!
-                        fringe_shield = kdb.Region()
-                        if lateral_shield is not None:
-                            fringe_shield.insert(lateral_shield)
+                        if self.fringe_layer_indices is not None and \
+                           child_index not in self.fringe_layer_indices:
+                            continue  # shield only
+                        if self.fringe_halo < self.side_halo:
+                            # NOTE: the neighborhood spans the side halo (single pass)
+                            #       or the fringe halo + 1 dbu (separate fringe pass)
+                            polygons = self.clip_to_fringe_halo(polygons)
+                            if not polygons:
+                                continue
                         if child_index < self.inside_layer_index:
                             r = range(child_index + 1, self.inside_layer_index)
-                            for idx in r:
-                                fringe_shield += layer_fringe_shields[idx]
-                        elif self.inside_layer_index < child_index:
+                        else:
                             r = range(self.inside_layer_index + 1, child_index)
+
+                        fringe_shield: Optional[kdb.Region] = None
+                        fringe_shield_intervals: Optional[IntervalSet] = None
+                        if use_intervals:
+                            fringe_shield_intervals = lateral_shield_intervals.copy()
+                            for idx in r:
+                                fringe_shield_intervals.update(layer_fringe_shield_intervals[idx])
+                        else:
+                            fringe_shield = kdb.Region()
+                            if lateral_shield is not None:
+                                fringe_shield.insert(lateral_shield)
                             for idx in r:
                                 fringe_shield += layer_fringe_shields[idx]
 
@@ -251,14 +455,136 @@ class SidewallAndFringeExtractor:
                             outside_polygons=polygons,
                             shield=fringe_shield,
                             lateral_shield=lateral_shield,
-                            geometry_restorer=geometry_restorer)
+                            geometry_restorer=geometry_restorer,
+                            shield_intervals=fringe_shield_intervals)
+
+        def clip_to_fringe_halo(self,
+                                polygons: List[kdb.PolygonWithProperties]) -> List[kdb.PolygonWithProperties]:
+            clipped: List[kdb.PolygonWithProperties] = []
+            for p in polygons:
+                bbox = p.bbox()
+                if bbox.top <= self.fringe_halo_dbu:
+                    clipped.append(p)
+                elif bbox.bottom >= self.fringe_halo_dbu:
+                    continue
+                else:
+                    clip_box = kdb.Box(bbox.left, bbox.bottom, bbox.right, self.fringe_halo_dbu)
+                    properties = {'net': p.property('net')}
+                    if p.is_box():
+                        clipped.append(kdb.PolygonWithProperties(kdb.Polygon(clip_box), properties))
+                    else:
+                        clipped.extend(kdb.PolygonWithProperties(cp, properties)
+                                       for cp in (kdb.Region(p) & kdb.Region(clip_box)).each())
+            return clipped
+
+        def cross_section_table(self,
+                                polygons_by_child: Dict[int, List[kdb.PolygonWithProperties]],
+                                edge_interval: EdgeInterval,
+                                gap_dbu: float) -> Optional[CrossSectionTable]:
+            """
+            Classifies the environment of the gap to the sidewall neighbour,
+            by the nearest layers below / above with shapes within the gap.
+
+            Those must cover the gap (at least CROSS_SECTION_COVERAGE of its area),
+            and there must be a table for exactly this environment,
+            otherwise returns None, and the sidewall formula is used.
+            """
+            x_start, x_end = int(edge_interval[0]), int(edge_interval[1])
+            gap_area = (x_end - x_start) * int(gap_dbu)
+            if gap_area <= 0:
+                return None
+
+            below_index: Optional[int] = None
+            below_coverage = 0.0
+            above_index: Optional[int] = None
+            above_coverage = 0.0
+            for child_index, polygons in polygons_by_child.items():
+                if child_index >= len(self.all_layer_names) or child_index == self.inside_layer_index:
+                    continue
+                if self.all_layer_names[child_index] == self.tech_info.internal_substrate_layer_name:
+                    continue
+                boxes: List[BoxTuple] = []
+                for p in polygons:
+                    p_boxes = rectilinear_boxes(p)
+                    if p_boxes is None:
+                        return None  # NOTE: not a plane the tables were solved for
+                    boxes.extend(p_boxes)
+                area = covered_area(boxes, x_start, x_end, 0, int(gap_dbu))
+                if area == 0:
+                    continue
+                coverage = area / gap_area
+                if child_index < self.inside_layer_index:
+                    if below_index is None or child_index > below_index:
+                        below_index = child_index
+                        below_coverage = coverage
+                elif above_index is None or child_index < above_index:
+                    above_index = child_index
+                    above_coverage = coverage
+
+            # NOTE: a partially covered gap is neither the plane nor the open environment of the tables
+            if below_index is not None and below_coverage < CROSS_SECTION_COVERAGE:
+                return None
+            if above_index is not None and above_coverage < CROSS_SECTION_COVERAGE:
+                return None
+
+            return self.cross_section_tables.table(
+                layer_name=self.inside_layer_name,
+                below_layer_name='' if below_index is None else self.all_layer_names[below_index],
+                above_layer_name='' if above_index is None else self.all_layer_names[above_index]
+            )
+
+        def conductor_width_um(self, edge: kdb.EdgeWithProperties) -> float:
+            """
+            Width of the current polygon across the edge,
+            exact for boxes, otherwise estimated by 2·area/perimeter (exact for long wires)
+            """
+            polygon = self.polygon
+            if polygon.is_box():
+                bbox = polygon.bbox()
+                if edge.dy() == 0:
+                    return bbox.height() * self.dbu
+                if edge.dx() == 0:
+                    return bbox.width() * self.dbu
+            return 2.0 * polygon.area() / polygon.perimeter() * self.dbu
+
+        def with_substrate(self,
+                           edge: kdb.EdgeWithProperties,
+                           neighborhood: EdgeNeighborhood) -> EdgeNeighborhood:
+            """
+            Adds the substrate to each edge interval, as a box spanning the interval up to the halo.
+            The substrate covers everything, so the edge parts without any neighbors
+            get an interval of their own.
+            """
+            substrate_net = self.tech_info.internal_substrate_layer_name
+
+            def substrate_box(x1: int, x2: int) -> kdb.PolygonWithProperties:
+                return kdb.PolygonWithProperties(kdb.Polygon(kdb.Box(x1, 0, x2, self.substrate_halo_dbu)),
+                                                 {'net': substrate_net})
+
+            result: EdgeNeighborhood = []
+            for (x1, x2), polygons_by_child in neighborhood:
+                polygons_by_child = dict(polygons_by_child)
+                polygons_by_child[self.substrate_layer_index] = [substrate_box(int(x1), int(x2))]
+                result.append(((x1, x2), polygons_by_child))
+
+            # NOTE: bext = eext = -1 dbu
+            x = 1
+            x_end = int(edge.length()) - 1
+            for x1, x2 in sorted(edge_interval for edge_interval, _ in neighborhood):
+                if x < x1:
+                    result.append(((x, int(x1)), {self.substrate_layer_index: [substrate_box(x, int(x1))]}))
+                x = max(x, int(x2))
+            if x < x_end:
+                result.append(((x, x_end), {self.substrate_layer_index: [substrate_box(x, x_end)]}))
+            return result
 
         def emit_sidewall(self,
                           layer_name: LayerName,
                           edge: kdb.EdgeWithProperties,
                           edge_interval: EdgeInterval,
                           polygon: kdb.PolygonWithProperties,
-                          geometry_restorer: GeometryRestorer):
+                          geometry_restorer: GeometryRestorer,
+                          cross_section_table: Optional[CrossSectionTable] = None):
             net1 = edge.property('net')
             net2 = polygon.property('net')
 
@@ -276,39 +602,66 @@ class SidewallAndFringeExtractor:
             # nearby_opposing_edge = [e for e in nearest_lateral_shape[1].each_edge() if e.d().x < 0][-1]
             # nearby_opposing_edge_trans = geometry_restorer.restore_edge(edge) * nearby_opposing_edge
 
-            # C = Csidewall * l * t / s
-            # C = Csidewall * l / s
+            # (length, distance) in dbu
+            segments = [(edge_interval[1] - edge_interval[0],
+                         min(polygon.bbox().p1.y, polygon.bbox().p2.y))]
+            if self.box_kernels and not polygon.is_box():
+                # NOTE: exact nearest distance along the edge, instead of the bounding box
+                boxes = rectilinear_boxes(polygon)
+                if boxes is not None:
+                    segments = [(x2 - x1, near)
+                                for x1, x2, near in lower_envelope(boxes, int(edge_interval[0]), int(edge_interval[1]))]
 
-            avg_length = edge_interval[1] - edge_interval[0]
-            avg_distance = min(polygon.bbox().p1.y, polygon.bbox().p2.y)
+            swk = SidewallKey(layer=layer_name, net1=net1, net2=net2)
 
-            outside_edge = nearest_edge(polygon)
+            width_um: Optional[float] = None
+            if cross_section_table is not None:
+                width_um = self.conductor_width_um(edge)
 
-            length_um = avg_length * self.dbu
-            distance_um = avg_distance * self.dbu
+            for avg_length, avg_distance in segments:
+                length_um = avg_length * self.dbu
+                distance_um = avg_distance * self.dbu
 
-            # NOTE: dividing by 2 (like MAGIC this not bidirectional),
-            #       but we count 2 sidewall contributions (one for each side of the cap)
-            cap_femto = ((length_um * sidewall_cap_spec.capacitance)
-                         / (distance_um + sidewall_cap_spec.offset)
-                         / 2.0  # non-bidirectional (half)
-                         / 1000.0)  # aF -> fF
+                coupling: Optional[float] = None
+                if cross_section_table is not None:
+                    coupling = cross_section_table.coupling(width_um=width_um, spacing_um=distance_um)
 
-            # info(f"(Sidewall) layer {layer_name}: Nets {net1} <-> {net2}: {round(cap_femto, 5)} fF")
+                if self.results.moments is not None:
+                    self.results.moments.add_sidewall(key=swk, length_um=length_um, distance_um=distance_um)
 
-            swk = SidewallKey(layer=layer_name, net1=net1, net2=net2)
-            sw_cap = SidewallCap(key=swk,
-                                 cap_value=cap_femto,
-                                 distance=distance_um,
-                                 length=length_um,
-                                 tech_spec=sidewall_cap_spec)
-            self.results.add_sidewall_cap(sw_cap)
-
-            self.report.output_sidewall(
-                sidewall_cap=sw_cap,
-                inside_edge=geometry_restorer.restore_edge_interval(edge_interval),
-                outside_edge=geometry_restorer.restore_edge(outside_edge)
-            )
+                if self.batch is not None:
+                    self.batch.sidewall.add(layer_name=layer_name,
+                                            sidewall_cap_spec=sidewall_cap_spec,
+                                            key=swk,
+                                            length_um=length_um,
+                                            distance_um=distance_um,
+                                            coupling=coupling)
+                    continue
+
+                outside_edge = nearest_edge(polygon)
+
+                if coupling is not None:
+                    cap_femto = coupling_cap_femto(length_um=length_um, coupling=coupling)
+                else:
+                    cap_femto = sidewall_cap_femto(length_um=length_um,
+                                                   distance_um=distance_um,
+                                                   sidewall_cap_spec=sidewall_cap_spec)
+
+                # info(f"(Sidewall) layer {layer_name}: Nets {net1} <-> {net2}: {round(cap_femto, 5)} fF")
+
+                sw_cap = SidewallCap(key=swk,
+                                     cap_value=cap_femto,
+                                     distance=distance_um,
+                                     length=length_um,
+                                     tech_spec=sidewall_cap_spec)
+                self.results.add_sidewall_cap(sw_cap)
+
+                if self.report.accept('sidewall', swk, cap_femto):
+                    self.report.output_sidewall(
+                        sidewall_cap=sw_cap,
+                        inside_edge=geometry_restorer.restore_edge_interval(edge_interval),
+                        outside_edge=geometry_restorer.restore_edge(outside_edge)
+                    )
 
         def fringe_cap(self,
                        edge_interval_length: float,
@@ -316,35 +669,12 @@ class SidewallAndFringeExtractor:
                        distance_far: float,
                        overlap_cap_spec: CapacitanceInfo.OverlapCapacitance,
                        sideoverlap_cap_spec: CapacitanceInfo.SideOverlapCapacitance) -> float:
-            distance_near_um = distance_near * self.dbu
-            distance_far_um = distance_far * self.dbu
-            edge_interval_length_um = edge_interval_length * self.dbu
-
-            # NOTE: overlap scaling is 1/50  (see MAGIC ExtTech)
-            alpha_scale_factor = 0.02 * 0.01 * 0.5 * 200.0
-            alpha_c = overlap_cap_spec.capacitance * alpha_scale_factor
-
-            # see Magic ExtCouple.c L1164
-            cnear = (2.0 / math.pi) * math.atan(alpha_c * distance_near_um)
-            cfar = (2.0 / math.pi) * math.atan(alpha_c * distance_far_um)
-
-            if self.scale_ratio_to_fit_halo:
-                full_halo_ratio = (2.0 / math.pi) * math.atan(alpha_c * self.side_halo)
-                # NOTE: for a large enough halo, full_halo would be 1,
-                #       but it is smaller, so we compensate
-                if full_halo_ratio < 1.0:
-                    cnear /= full_halo_ratio
-                    cfar /= full_halo_ratio
-
-            # "cfrac" is the fractional portion of the fringe cap seen
-            # by tile tp along its length.  This is independent of the
-            # portion of the boundary length that tile tp occupies.
-            cfrac = cfar - cnear
-
-            cap_femto = (cfrac * edge_interval_length_um *
-                         sideoverlap_cap_spec.capacitance / 1000.0)
-
-            return cap_femto
+            return fringe_cap_femto(length_um=edge_interval_length * self.dbu,
+                                    distance_near_um=distance_near * self.dbu,
+                                    distance_far_um=distance_far * self.dbu,
+                                    alpha_c=fringe_alpha(overlap_cap_spec),
+                                    sideoverlap_cap_spec=sideoverlap_cap_spec,
+                                    halo_um=self.side_halo if self.scale_ratio_to_fit_halo else None)
 
         def emit_fringe(self,
                         inside_layer_name: LayerName,
@@ -352,9 +682,10 @@ class SidewallAndFringeExtractor:
                         edge: kdb.EdgeWithProperties,
                         edge_interval: EdgeInterval,
                         outside_polygons: List[kdb.PolygonWithProperties],
-                        shield: kdb.Region,
+                        shield: Optional[kdb.Region],
                         lateral_shield: kdb.Polygon,
-                        geometry_restorer: GeometryRestorer):
+                        geometry_restorer: GeometryRestorer,
+                        shield_intervals: Optional[IntervalSet] = None):
             inside_net_name = self.tech_info.internal_substrate_layer_name \
                 if inside_layer_name == self.tech_info.internal_substrate_layer_name \
                 else edge.property('net')
@@ -396,7 +727,16 @@ class SidewallAndFringeExtractor:
                     # TODO: log?
                     continue
 
-                if shield.is_empty():
+                if shield_intervals is not None:
+                    if shield_intervals.is_empty():
+                        polygons_by_net[outside_net].append(p)
+                        continue
+                    bbox = p.bbox()
+                    for lo, hi in shield_intervals.subtract_from(bbox.bottom, bbox.top):
+                        up = kdb.PolygonWithProperties(kdb.Polygon(kdb.Box(bbox.left, lo, bbox.right, hi)),
+                                                       {'net': outside_net})
+                        polygons_by_net[outside_net].append(up)
+                elif shield.is_empty():
                     polygons_by_net[outside_net].append(p)
                 else:
                     unshielded_region = kdb.Region(p)
@@ -414,53 +754,92 @@ class SidewallAndFringeExtractor:
 
             for outside_net_name, polygons in polygons_by_net.items():
                 for p in polygons:
-                    bbox = p.bbox()
-                    if not p.is_box():
-                        warning(f"Side overlap, polygon {p} is not a box. "
-                                f"Currently, only boxes are supported, will be using bounding box {bbox}")
-
-                    distance_near = bbox.p1.y  # + 1
-                    if distance_near < 0:
-                        distance_near = 0
-                    distance_far = bbox.p2.y  # - 2
-                    if distance_far < 0:
-                        distance_far = 0
-                    try:
-                        assert distance_near >= 0
-                        assert distance_far >= distance_near
-                    except AssertionError:
-                        print()
-                        raise
-
-                    if distance_far == distance_near:
-                        return
-
-                    edge_interval_length = edge_interval[1] - edge_interval[0]
-                    edge_interval_length_um = edge_interval_length * self.dbu
-
-                    cap_femto = self.fringe_cap(edge_interval_length=edge_interval_length,
-                                                distance_near=distance_near,
-                                                distance_far=distance_far,
-                                                overlap_cap_spec=overlap_cap_spec,
-                                                sideoverlap_cap_spec=sideoverlap_cap_spec)
-
-                    if cap_femto > 0.0001:  # TODO: configurable threshold, but keeping accumulation might also be nice
-                        # info(f"(Side Overlap) "
-                        #      f"{inside_layer_name}({inside_net_name})-{outside_layer_name}({outside_net_name}): "
-                        #      f"{round(cap_femto, 5)} fF, "
-                        #      f"edge interval length = {round(edge_interval_length_um, 2)} µm")
-
-                        sok = SideOverlapKey(layer_inside=inside_layer_name,
-                                             net_inside=inside_net_name,
-                                             layer_outside=outside_layer_name,
-                                             net_outside=outside_net_name)
-                        soc = SideOverlapCap(key=sok, cap_value=cap_femto)
-                        self.results.add_sideoverlap_cap(soc)
-
-                        self.report.output_sideoverlap(
-                            sideoverlap_cap=soc,
-                            inside_edge=geometry_restorer.restore_edge_interval(edge_interval),
-                            outside_polygon=geometry_restorer.restore_polygon(p),
-                            lateral_shield=geometry_restorer.restore_polygon(lateral_shield) \
-                                           if lateral_shield is not None else None
-                        )
+                    # (length, near distance, far distance) in dbu
+                    spans: Optional[List[Tuple[int, int, int]]] = None
+                    if self.box_kernels:
+                        # NOTE: exact per rectangle, instead of the bounding box
+                        boxes = rectilinear_boxes(p)
+                        if boxes is not None:
+                            spans = fringe_spans(boxes, int(edge_interval[0]), int(edge_interval[1]))
+
+                    if spans is None:
+                        bbox = p.bbox()
+                        if not p.is_box():
+                            warning(f"Side overlap, polygon {p} is not a box. "
+                                    f"Currently, only boxes are supported, will be using bounding box {bbox}")
+
+                        distance_near = bbox.p1.y  # + 1
+                        if distance_near < 0:
+                            distance_near = 0
+                        distance_far = bbox.p2.y  # - 2
+                        if distance_far < 0:
+                            distance_far = 0
+                        try:
+                            assert distance_near >= 0
+                            assert distance_far >= distance_near
+                        except AssertionError:
+                            print()
+                            raise
+
+                        if distance_far == distance_near:
+                            return
+
+                        spans = [(edge_interval[1] - edge_interval[0], distance_near, distance_far)]
+
+                    for edge_interval_length, distance_near, distance_far in spans:
+                        edge_interval_length_um = edge_interval_length * self.dbu
+
+                        if self.results.moments is not None:
+                            self.results.moments.add_fringe(
+                                key=SideOverlapKey(layer_inside=inside_layer_name,
+                                                   net_inside=inside_net_name,
+                                                   layer_outside=outside_layer_name,
+                                                   net_outside=outside_net_name),
+                                length_um=edge_interval_length_um,
+                                distance_near_um=distance_near * self.dbu,
+                                distance_far_um=distance_far * self.dbu,
+                                halo_um=self.side_halo
+                            )
+
+                        if self.batch is not None:
+                            self.batch.fringe.add(
+                                inside_layer_name=inside_layer_name,
+                                outside_layer_name=outside_layer_name,
+                                overlap_cap_spec=overlap_cap_spec,
+                                sideoverlap_cap_spec=sideoverlap_cap_spec,
+                                key=SideOverlapKey(layer_inside=inside_layer_name,
+                                                   net_inside=inside_net_name,
+                                                   layer_outside=outside_layer_name,
+                                                   net_outside=outside_net_name),
+                                length_um=edge_interval_length_um,
+                                distance_near_um=distance_near * self.dbu,
+                                distance_far_um=distance_far * self.dbu)
+                            continue
+
+                        cap_femto = self.fringe_cap(edge_interval_length=edge_interval_length,
+                                                    distance_near=distance_near,
+                                                    distance_far=distance_far,
+                                                    overlap_cap_spec=overlap_cap_spec,
+                                                    sideoverlap_cap_spec=sideoverlap_cap_spec)
+
+                        if cap_femto > FRINGE_CAP_THRESHOLD:  # TODO: configurable threshold, but keeping accumulation might also be nice
+                            # info(f"(Side Overlap) "
+                            #      f"{inside_layer_name}({inside_net_name})-{outside_layer_name}({outside_net_name}): "
+                            #      f"{round(cap_femto, 5)} fF, "
+                            #      f"edge interval length = {round(edge_interval_length_um, 2)} µm")
+
+                            sok = SideOverlapKey(layer_inside=inside_layer_name,
+                                                 net_inside=inside_net_name,
+                                                 layer_outside=outside_layer_name,
+                                                 net_outside=outside_net_name)
+                            soc = SideOverlapCap(key=sok, cap_value=cap_femto)
+                            self.results.add_sideoverlap_cap(soc)
+
+                            if self.report.accept('sideoverlap', sok, cap_femto):
+                                self.report.output_sideoverlap(
+                                    sideoverlap_cap=soc,
+                                    inside_edge=geometry_restorer.restore_edge_interval(edge_interval),
+                                    outside_polygon=geometry_restorer.restore_polygon(p),
+                                    lateral_shield=geometry_restorer.restore_polygon(lateral_shield) \
+                                                   if lateral_shield is not None else None
+                                )
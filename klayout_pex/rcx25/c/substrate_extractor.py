@@ -0,0 +1,187 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from typing import *
+
+import klayout.db as kdb
+
+from klayout_pex.log import (
+    warning,
+)
+from klayout_pex.tech_info import TechInfo
+
+from klayout_pex.rcx25.c.layer_relevance import LayerRelevance
+from klayout_pex.rcx25.types import PolygonNeighborhood
+from klayout_pex.rcx25.extraction_results import *
+from klayout_pex.rcx25.extraction_reporter import ExtractionReporter
+from klayout_pex_protobuf.kpex.tech.process_parasitics_pb2 import CapacitanceInfo
+
+
+class SubstrateExtractor:
+    """
+    Dedicated pass for the substrate area capacitances.
+
+    Instead of visiting the single (die sized) substrate polygon, whose neighborhood
+    is the whole layout, each shape looks down to the layers below it:
+    the substrate area capacitance applies to the part not covered by any lower layer.
+
+    Fringe to the substrate is handled by SidewallAndFringeExtractor
+    (see substrate_fast_path there), which synthesizes the substrate per edge interval.
+    """
+
+    def __init__(self,
+                 all_layer_names: List[LayerName],
+                 layer_regions_by_name: Dict[LayerName, kdb.Region],
+                 dbu: float,
+                 tech_info: TechInfo,
+                 results: CellExtractionResults,
+                 report: ExtractionReporter,
+                 layer_relevance: Optional[LayerRelevance] = None):
+        self.all_layer_names = all_layer_names
+        self.layer_regions_by_name = layer_regions_by_name
+        self.dbu = dbu
+        self.tech_info = tech_info
+        self.results = results
+        self.report = report
+        self.layer_relevance = layer_relevance or LayerRelevance(all_layer_names=all_layer_names,
+                                                                 tech_info=tech_info)
+
+    @property
+    def substrate_layer_name(self) -> LayerName:
+        return self.tech_info.internal_substrate_layer_name
+
+    def has_foreign_net_shapes(self, region: kdb.Region) -> bool:
+        for p in region.each():
+            if p.property('net') != self.substrate_layer_name:
+                return True
+        return False
+
+    def extract(self):
+        substrate_layer_index = self.all_layer_names.index(self.substrate_layer_name)
+        substrate_region = self.layer_regions_by_name[self.substrate_layer_name]
+        substrate_polygon = next(iter(substrate_region.each()), None)
+
+        all_layer_regions = list(self.layer_regions_by_name.values())
+
+        for layer_index in self.layer_relevance.overlap_layer_indices[substrate_layer_index]:
+            layer_name = self.all_layer_names[layer_index]
+            layer_region = all_layer_regions[layer_index]
+
+            overlap_cap_spec = self.tech_info.overlap_cap_by_layer_names.get(layer_name, {}) \
+                                                                      .get(self.substrate_layer_name, None)
+            if not overlap_cap_spec:
+                # NOTE: like in OverlapExtractor, a layer without spec stops the upward search
+                #       of the (single) substrate polygon
+                if self.has_foreign_net_shapes(layer_region):
+                    warning(f"No overlap cap specified for layer top={layer_name}, "
+                            f"bottom={self.substrate_layer_name}, "
+                            f"skipping substrate area caps of this and all layers above")
+                    return
+                continue
+
+            shield_layer_indices = [idx for idx in range(substrate_layer_index + 1, layer_index)]
+
+            visitor = self.PEXSubstrateAreaVisitor(
+                layer_name=layer_name,
+                substrate_layer_name=self.substrate_layer_name,
+                substrate_polygon=substrate_polygon,
+                overlap_cap_spec=overlap_cap_spec,
+                dbu=self.dbu,
+                results=self.results,
+                report=self.report
+            )
+
+            if shield_layer_indices:
+                children = [kdb.CompoundRegionOperationNode.new_secondary(all_layer_regions[idx])
+                            for idx in shield_layer_indices]
+                node = kdb.CompoundRegionOperationNode.new_polygon_neighborhood(children, visitor)
+                layer_region.complex_op(node)
+            else:
+                for p in layer_region.each():
+                    visitor.neighbors(layout=None, cell=None, polygon=p, neighborhood={})
+
+    class PEXSubstrateAreaVisitor(kdb.PolygonNeighborhoodVisitor):
+        def __init__(self,
+                     layer_name: LayerName,
+                     substrate_layer_name: LayerName,
+                     substrate_polygon: Optional[kdb.PolygonWithProperties],
+                     overlap_cap_spec: CapacitanceInfo.OverlapCapacitance,
+                     dbu: float,
+                     results: CellExtractionResults,
+                     report: ExtractionReporter):
+            super().__init__()
+            self.layer_name = layer_name
+            self.substrate_layer_name = substrate_layer_name
+            self.substrate_polygon = substrate_polygon
+            self.overlap_cap_spec = overlap_cap_spec
+            self.dbu = dbu
+            self.results = results
+            self.report = report
+
+        def neighbors(self,
+                      layout: kdb.Layout,
+                      cell: kdb.Cell,
+                      polygon: kdb.PolygonWithProperties,
+                      neighborhood: PolygonNeighborhood):
+            net_top = polygon.property('net')
+            if net_top == self.substrate_layer_name:
+                return
+
+            shield = kdb.Region()
+            for polygons_below in neighborhood.values():
+                for p in polygons_below:
+                    if p.property('net') != self.substrate_layer_name:
+                        shield.insert(p)
+
+            overlap_area = kdb.Region(polygon)
+            if not shield.is_empty():
+                overlap_area -= shield
+
+            overlap_area_um2 = overlap_area.area() * self.dbu ** 2
+            cap_femto = overlap_area_um2 * self.overlap_cap_spec.capacitance / 1000.0
+
+            if self.results.moments is not None and overlap_area_um2 > 0.0:
+                self.results.moments.add_overlap(OverlapKey(layer_top=self.layer_name,
+                                                            net_top=net_top,
+                                                            layer_bot=self.substrate_layer_name,
+                                                            net_bot=self.substrate_layer_name),
+                                                 overlap_area_um2)
+
+            if cap_femto > 0.0:
+                ovk = OverlapKey(layer_top=self.layer_name,
+                                 net_top=net_top,
+                                 layer_bot=self.substrate_layer_name,
+                                 net_bot=self.substrate_layer_name)
+                cap = OverlapCap(key=ovk,
+                                 cap_value=cap_femto,
+                                 shielded_area=0.0,
+                                 unshielded_area=0.0,
+                                 tech_spec=self.overlap_cap_spec)
+                self.results.add_overlap_cap(cap)
+
+                if self.report.accept('overlap', cap.key, cap.cap_value):
+                    self.report.output_overlap(overlap_cap=cap,
+                                               bottom_polygon=self.substrate_polygon,
+                                               top_polygon=polygon,
+                                               overlap_area=overlap_area)
@@ -29,8 +29,10 @@ import klayout.db as kdb
 
 from .extraction_results import *
 from .types import EdgeNeighborhood, LayerName
+from .report_level import ReportLevel
 from klayout_pex.rcx25.c.geometry_restorer import GeometryRestorer
-from klayout_pex.klayout.shapes_pb2_converter import ShapesConverter
+from klayout_pex.rcx25.r.packed_r_network import unpack_r_network
+from klayout_pex.klayout.shapes_pb2_converter import shapes_converter
 
 import klayout_pex_protobuf.kpex.geometry.shapes_pb2 as shapes_pb2
 import klayout_pex_protobuf.kpex.layout.device_pb2 as device_pb2
@@ -47,13 +49,71 @@ VarShapes = kdb.Shapes | kdb.Region | List[kdb.Edge] | List[kdb.Polygon | kdb.Bo
 class ExtractionReporter:
     def __init__(self,
                  cell_name: str,
-                 dbu: float):
+                 dbu: float,
+                 report_level: ReportLevel = ReportLevel.DEFAULT,
+                 sampling_rate: int = 100):
+        """
+        :param cell_name: name of the extracted cell
+        :param dbu: database unit
+        :param report_level: amount of information written to the report database
+        :param sampling_rate: for ReportLevel.SAMPLED, keep every n-th item (per category)
+        """
         self.report = rdb.ReportDatabase(f"PEX {cell_name}")
         self.cell = self.report.create_cell(cell_name)
         self.dbu = dbu
         self.dbu_trans = kdb.CplxTrans(mag=dbu)
         self.category_name_counter: Dict[str, int] = defaultdict(int)
-        self.shapes_converter = ShapesConverter(dbu=dbu)
+        self.shapes_converter = shapes_converter(dbu=dbu)
+
+        self.report_level = report_level
+        self.sampling_rate = max(1, sampling_rate)
+        self.sample_counter: Dict[str, int] = defaultdict(int)
+        self.summary_totals: Dict[Tuple[str, str], CapTotal] = defaultdict(CapTotal)
+
+    def accept(self,
+               category: str,
+               key: Any,
+               cap_value: float) -> bool:
+        """
+        Called for every extracted item, before preparing its report geometries
+        :return: True if the item should be output (with geometries)
+        """
+        match self.report_level:
+            case ReportLevel.FULL:
+                return True
+            case ReportLevel.OFF:
+                return False
+            case _:
+                self.summary_totals[(category, repr(key))].add(cap_value)
+                if self.report_level == ReportLevel.SUMMARY:
+                    return False
+                self.sample_counter[category] += 1
+                return self.sample_counter[category] % self.sampling_rate == 1 % self.sampling_rate
+
+    def sample(self, category: str) -> bool:
+        """
+        Like accept(), but for items without a capacitance value (e.g. R networks)
+        """
+        match self.report_level:
+            case ReportLevel.FULL:
+                return True
+            case ReportLevel.OFF | ReportLevel.SUMMARY:
+                return False
+            case _:
+                self.sample_counter[category] += 1
+                return self.sample_counter[category] % self.sampling_rate == 1 % self.sampling_rate
+
+    def output_summary(self):
+        if not self.summary_totals:
+            return
+        cat_summary = self.report.create_category("Summary")
+        cat_by_name: Dict[str, rdb.RdbCategory] = {}
+        for (category, key), total in sorted(self.summary_totals.items()):
+            cat = cat_by_name.get(category, None)
+            if cat is None:
+                cat = self.report.create_category(cat_summary, category)
+                cat_by_name[category] = cat
+            self.report.create_category(cat, f"{key}: {round(total.cap_value, 6)} fF ({total.count} items)")
 
     @cached_property
     def cat_common(self) -> rdb.RdbCategory:
@@ -124,6 +184,9 @@ class ExtractionReporter:
         return self.report.create_category("[C] Edge Neighborhood Visitor")
 
     def save(self, path: str):
+        if self.report_level == ReportLevel.OFF:
+            return
+        self.output_summary()
         self.report.save(path)
 
     def output_shapes(self,
@@ -217,6 +280,8 @@ class ExtractionReporter:
                                  edge: kdb.EdgeWithProperties,
                                  neighborhood: EdgeNeighborhood,
                                  geometry_restorer: GeometryRestorer):
+        if self.report_level != ReportLevel.FULL:
+            return
         cat_en_layer_inside = self.report.create_category(self.cat_edge_neighborhood, f"inside_layer={inside_layer}")
         inside_net = edge.property('net')
         cat_en_net_inside = self.report.create_category(cat_en_layer_inside, f'inside_net={inside_net}')
@@ -350,12 +415,15 @@ class ExtractionReporter:
                                self.shapes_converter.klayout_region(l2r.region))
 
     def output_rex_request(self, request: pex_request_pb2.RExtractionRequest):
+        if not self.report_level.keeps_items():
+            return
         self.output_rex_tech(request.tech)
         self.output_devices(request.devices)
         self.output_pins(request.pins, category=self.cat_rex_request_pins)
 
         for r in request.net_extraction_requests:
-            self.output_net_extraction_request(r)
+            if self.sample('net_extraction_request'):
+                self.output_net_extraction_request(r)
 
     def output_rex_result_network(self, network: r_network_pb2.RNetwork):
         cat_network = self.report.create_category(self.cat_rex_result_networks, f"Net {network.net_name}")
@@ -372,8 +440,16 @@ class ExtractionReporter:
 
     def output_rex_result(self,
                           result: pex_result_pb2.RExtractionResult):
+        if not self.report_level.keeps_items():
+            return
         for network in result.networks:
-            self.output_rex_result_network(network)
+            if self.sample('rex_result_network'):
+                self.output_rex_result_network(network)
+        for packed in result.packed_networks:
+            if self.sample('rex_result_network'):
+                network = r_network_pb2.RNetwork()
+                unpack_r_network(packed, network)
+                self.output_rex_result_network(network)
 
     def marker_box_for_pb_point(self, point: shapes_pb2.Point) -> shapes_pb2.Box:
         sized_value = 5
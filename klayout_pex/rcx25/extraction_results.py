@@ -28,12 +28,18 @@ from dataclasses import dataclass, field
 from typing import *
 
 from .types import NetName, LayerName, CellName
+from .result_mode import ResultMode
 from ..log import error
+from ..util.delimited_protobuf import read_delimited, write_delimited
 
+import klayout_pex_protobuf.kpex.c.capacitance_pb2 as capacitance_pb2
 import klayout_pex_protobuf.kpex.r.r_network_pb2 as r_network_pb2
 import klayout_pex_protobuf.kpex.result.pex_result_pb2 as pex_result_pb2
 import klayout_pex_protobuf.kpex.tech.process_parasitics_pb2 as process_parasitics_pb2
 
+if TYPE_CHECKING:
+    from .c.geometric_moments import GeometricMoments
+
 
 @dataclass
 class NodeRegion:
@@ -135,6 +141,20 @@ class NetCoupleKey:
             return NetCoupleKey(self.net2, self.net1)
 
 
+@dataclass
+class CapTotal:
+    cap_value: float = 0.0  # femto farad
+    count: int = 0          # number of accumulated contributions
+
+    def add(self, cap_value: float):
+        self.cap_value += cap_value
+        self.count += 1
+
+    def merge(self, other: CapTotal):
+        self.cap_value += other.cap_value
+        self.count += other.count
+
+
 @dataclass
 class ExtractionSummary:
     capacitances: Dict[NetCoupleKey, float]
@@ -163,14 +183,112 @@ class CellExtractionResults:
 
     r_extraction_result: pex_result_pb2.RExtractionResult = field(default_factory=lambda: pex_result_pb2.RExtractionResult())
 
+    result_mode: ResultMode = ResultMode.DEFAULT
+
+    # NOTE: for the aggregating result modes, the *_table dicts above stay empty,
+    #       instead we keep running totals, so memory is O(net pairs) (or O(net pairs x layer pairs))
+    net_couple_cap_totals: Dict[NetCoupleKey, float] = field(default_factory=lambda: defaultdict(float))
+    overlap_totals: Dict[OverlapKey, CapTotal] = field(default_factory=lambda: defaultdict(CapTotal))
+    sidewall_totals: Dict[SidewallKey, CapTotal] = field(default_factory=lambda: defaultdict(CapTotal))
+    sideoverlap_totals: Dict[SideOverlapKey, CapTotal] = field(default_factory=lambda: defaultdict(CapTotal))
+
+    # NOTE: if set, the extractors additionally record the coefficient independent geometry
+    #       (e.g. to evaluate the style variants / corners of the technology)
+    moments: Optional[GeometricMoments] = None
+
+    def _accumulate(self,
+                    couple_key: NetCoupleKey,
+                    totals: Dict[Any, CapTotal],
+                    key: Any,
+                    cap_value: float):
+        self.net_couple_cap_totals[couple_key.normed()] += cap_value
+        if self.result_mode.keeps_layer_breakdown():
+            totals[key].add(cap_value)
+
     def add_overlap_cap(self, cap: OverlapCap):
-        self.overlap_table[cap.key].append(cap)
+        if self.result_mode.keeps_entries():
+            self.overlap_table[cap.key].append(cap)
+        else:
+            self._accumulate(NetCoupleKey(cap.key.net_bot, cap.key.net_top),
+                             self.overlap_totals, cap.key, cap.cap_value)
 
     def add_sidewall_cap(self, cap: SidewallCap):
-        self.sidewall_table[cap.key].append(cap)
+        if self.result_mode.keeps_entries():
+            self.sidewall_table[cap.key].append(cap)
+        else:
+            self._accumulate(NetCoupleKey(cap.key.net1, cap.key.net2),
+                             self.sidewall_totals, cap.key, cap.cap_value)
 
     def add_sideoverlap_cap(self, cap: SideOverlapCap):
-        self.sideoverlap_table[cap.key].append(cap)
+        if self.result_mode.keeps_entries():
+            self.sideoverlap_table[cap.key].append(cap)
+        else:
+            self._accumulate(NetCoupleKey(cap.key.net_inside, cap.key.net_outside),
+                             self.sideoverlap_totals, cap.key, cap.cap_value)
+
+    def overlap_cap_sums(self) -> Dict[OverlapKey, float]:
+        if self.result_mode.keeps_entries():
+            return {k: sum((e.cap_value for e in entries)) for k, entries in self.overlap_table.items()}
+        return {k: t.cap_value for k, t in self.overlap_totals.items()}
+
+    def sidewall_cap_sums(self) -> Dict[SidewallKey, float]:
+        if self.result_mode.keeps_entries():
+            return {k: sum((e.cap_value for e in entries)) for k, entries in self.sidewall_table.items()}
+        return {k: t.cap_value for k, t in self.sidewall_totals.items()}
+
+    def sideoverlap_cap_sums(self) -> Dict[SideOverlapKey, float]:
+        if self.result_mode.keeps_entries():
+            return {k: sum((e.cap_value for e in entries)) for k, entries in self.sideoverlap_table.items()}
+        return {k: t.cap_value for k, t in self.sideoverlap_totals.items()}
+
+    def each_resistor_element(self) -> Iterator[Tuple[NetCoupleKey, float, LayerName, LayerName]]:
+        """
+        :return: per resistor element of all networks (normalized net couple key,
+                 resistance in Ω, layer name of node a, layer name of node b)
+        """
+        def node_name(network: r_network_pb2.RNetwork,
+                      node: r_network_pb2.RNode) -> str:
+            # NOTE: if we have an electrical short between 2 pins A and B
+            #       and a parasitic resistance between the two,
+            #       KLayout will call the net of both pins "A,B"
+            #       but we really want the pin name as the node name
+            if not node.net_name or ',' in node.net_name:
+                # NOTE: network prefix, as node name is only unique per network
+                return f"{network.net_name}.{node.node_name}"
+            return node.net_name
+
+        for network in self.r_extraction_result.networks:
+            node_by_id: Dict[int, r_network_pb2.RNode] = {n.node_id: n for n in network.nodes}
+            for element in network.elements:
+                node_a = node_by_id[element.node_a.node_id]
+                node_b = node_by_id[element.node_b.node_id]
+                normalized_key = NetCoupleKey(node_name(network, node_a),
+                                              node_name(network, node_b)).normed()
+                yield normalized_key, element.resistance, node_a.layer_name, node_b.layer_name
+
+        for packed in self.r_extraction_result.packed_networks:
+            # same naming rule as node_name() above, but evaluated once per string table entry
+            string_table = packed.string_table
+            net_prefix = f"{packed.net_name}."
+            resolved_names: Dict[Tuple[int, int], str] = {}
+            names: List[str] = []
+            for name_idx, net_name_idx in zip(packed.node_name_indices, packed.node_net_name_indices):
+                name = resolved_names.get((name_idx, net_name_idx), None)
+                if name is None:
+                    net_name = string_table[net_name_idx]
+                    if not net_name or ',' in net_name:
+                        name = net_prefix + string_table[name_idx]
+                    else:
+                        name = net_name
+                    resolved_names[(name_idx, net_name_idx)] = name
+                names.append(name)
+            layer_names = [string_table[idx] for idx in packed.node_layer_indices]
+
+            for a, b, resistance in zip(packed.element_node_a,
+                                        packed.element_node_b,
+                                        packed.element_resistances):
+                normalized_key = NetCoupleKey(names[a], names[b]).normed()
+                yield normalized_key, resistance, layer_names[a], layer_names[b]
 
     def summarize(self) -> ExtractionSummary:
         normalized_overlap_table: Dict[NetCoupleKey, float] = defaultdict(float)
@@ -195,36 +313,161 @@ class CellExtractionResults:
                                                 resistances={})
 
         normalized_resistance_table: Dict[NetCoupleKey, float] = defaultdict(float)
+        for normalized_key, resistance, _, _ in self.each_resistor_element():
+            normalized_resistance_table[normalized_key] += resistance
 
-        def node_name(network: r_network_pb2.RNetwork,
-                      node: r_network_pb2.RNode) -> str:
-            # NOTE: if we have an electrical short between 2 pins A and B
-            #       and a parasitic resistance between the two,
-            #       KLayout will call the net of both pins "A,B"
-            #       but we really want the pin name as the node name
-            if not node.net_name or ',' in node.net_name:
-                # NOTE: network prefix, as node name is only unique per network
-                return f"{network.net_name}.{node.node_name}"
-            return node.net_name
-
-        for network in self.r_extraction_result.networks:
-            node_by_id: Dict[int, r_network_pb2.RNode] = {n.node_id: n for n in network.nodes}
-            for element in network.elements:
-                node_a = node_by_id[element.node_a.node_id]
-                node_b = node_by_id[element.node_b.node_id]
-                resistance = element.resistance
-                normalized_key = NetCoupleKey(node_name(network, node_a),
-                                              node_name(network, node_b)).normed()
-                normalized_resistance_table[normalized_key] += resistance
-                
         resistance_summary = ExtractionSummary(capacitances={},
                                                resistances=normalized_resistance_table)
 
+        # only populated in the aggregating result modes
+        aggregated_summary = ExtractionSummary(capacitances=self.net_couple_cap_totals,
+                                               resistances={})
+
         return ExtractionSummary.merged([
             overlap_summary, sidewall_summary, sideoverlap_summary,
-            resistance_summary
+            resistance_summary, aggregated_summary
         ])
 
+    def merge(self, other: CellExtractionResults):
+        """
+        Merges the results of another extraction of the same cell (e.g. another tile)
+        """
+        for entries in other.overlap_table.values():
+            for e in entries:
+                self.add_overlap_cap(e)
+        for entries in other.sidewall_table.values():
+            for e in entries:
+                self.add_sidewall_cap(e)
+        for entries in other.sideoverlap_table.values():
+            for e in entries:
+                self.add_sideoverlap_cap(e)
+
+        if not other.result_mode.keeps_entries():
+            if self.result_mode.keeps_entries():
+                raise ValueError(f"Can't merge aggregated results ({other.result_mode}) "
+                                 f"into results of mode {self.result_mode}")
+            for key, cap_value in other.net_couple_cap_totals.items():
+                self.net_couple_cap_totals[key] += cap_value
+            if self.result_mode.keeps_layer_breakdown():
+                for totals, other_totals in ((self.overlap_totals, other.overlap_totals),
+                                             (self.sidewall_totals, other.sidewall_totals),
+                                             (self.sideoverlap_totals, other.sideoverlap_totals)):
+                    for key, total in other_totals.items():
+                        totals[key].merge(total)
+
+        if self.moments is not None and other.moments is not None:
+            self.moments.merge(other.moments)
+
+        self.r_extraction_result.MergeFrom(other.r_extraction_result)
+
+    def c_result_pb(self) -> pex_result_pb2.CExtractionResult:
+        """
+        Compact capacitance result, one entry per key
+        (per polygon/edge details like areas and distances are not serialized)
+        """
+        c_result = pex_result_pb2.CExtractionResult()
+        c_result.cell_name = self.cell_name
+
+        # NOTE: in ResultMode.AGGREGATE there is no per key breakdown, only the net pair table
+        for key, cap_value in sorted(self.overlap_cap_sums().items(), key=lambda kv: repr(kv[0])):
+            ov = c_result.overlaps.add()
+            ov.key.layer_top = key.layer_top
+            ov.key.net_top = key.net_top
+            ov.key.layer_bot = key.layer_bot
+            ov.key.net_bot = key.net_bot
+            ov.capacitance = cap_value
+
+        for key, cap_value in sorted(self.sidewall_cap_sums().items(), key=lambda kv: repr(kv[0])):
+            sw = c_result.sidewalls.add()
+            sw.key.layer = key.layer
+            sw.key.net1 = key.net1
+            sw.key.net2 = key.net2
+            sw.capacitance = cap_value
+
+        for key, cap_value in sorted(self.sideoverlap_cap_sums().items(), key=lambda kv: repr(kv[0])):
+            fr = c_result.fringes.add()
+            fr.key.layer_inside = key.layer_inside
+            fr.key.net_inside = key.net_inside
+            fr.key.layer_outside = key.layer_outside
+            fr.key.net_outside = key.net_outside
+            fr.capacitance = cap_value
+
+        summary = self.summarize()
+        for key, cap_value in sorted(summary.capacitances.items()):
+            nc = c_result.net_couples.add()
+            nc.net1 = key.net1
+            nc.net2 = key.net2
+            nc.capacitance = cap_value
+
+        if self.moments is not None:
+            self.moments.to_pb(c_result.moments)
+
+        return c_result
+
+    def cell_result_pb(self) -> pex_result_pb2.CellExtractionResult:
+        cell_result = pex_result_pb2.CellExtractionResult()
+        cell_result.c_result.CopyFrom(self.c_result_pb())
+        cell_result.r_result.CopyFrom(self.r_extraction_result)
+        return cell_result
+
+    @classmethod
+    def from_pb(cls, cell_result: pex_result_pb2.CellExtractionResult) -> CellExtractionResults:
+        c_result = cell_result.c_result
+
+        has_breakdown = len(c_result.overlaps) + len(c_result.sidewalls) + len(c_result.fringes) >= 1
+        if not has_breakdown and len(c_result.net_couples) >= 1:
+            # written in ResultMode.AGGREGATE
+            results = CellExtractionResults(cell_name=c_result.cell_name,
+                                            result_mode=ResultMode.AGGREGATE)
+            for nc in c_result.net_couples:
+                results.net_couple_cap_totals[NetCoupleKey(nc.net1, nc.net2).normed()] += nc.capacitance
+            results.r_extraction_result.CopyFrom(cell_result.r_result)
+            results.moments = cls.moments_from_pb(c_result)
+            return results
+
+        results = CellExtractionResults(cell_name=c_result.cell_name)
+
+        for ov in c_result.overlaps:
+            key = OverlapKey(layer_top=ov.key.layer_top,
+                             net_top=ov.key.net_top,
+                             layer_bot=ov.key.layer_bot,
+                             net_bot=ov.key.net_bot)
+            results.add_overlap_cap(OverlapCap(key=key,
+                                               cap_value=ov.capacitance,
+                                               shielded_area=0.0,
+                                               unshielded_area=0.0,
+                                               tech_spec=None))
+
+        for sw in c_result.sidewalls:
+            key = SidewallKey(layer=sw.key.layer,
+                              net1=sw.key.net1,
+                              net2=sw.key.net2)
+            results.add_sidewall_cap(SidewallCap(key=key,
+                                                 cap_value=sw.capacitance,
+                                                 distance=0.0,
+                                                 length=0.0,
+                                                 tech_spec=None))
+
+        for fr in c_result.fringes:
+            key = SideOverlapKey(layer_inside=fr.key.layer_inside,
+                                 net_inside=fr.key.net_inside,
+                                 layer_outside=fr.key.layer_outside,
+                                 net_outside=fr.key.net_outside)
+            results.add_sideoverlap_cap(SideOverlapCap(key=key,
+                                                       cap_value=fr.capacitance))
+
+        results.r_extraction_result.CopyFrom(cell_result.r_result)
+        results.moments = cls.moments_from_pb(c_result)
+        return results
+
+    @staticmethod
+    def moments_from_pb(c_result: pex_result_pb2.CExtractionResult) -> Optional[GeometricMoments]:
+        if not c_result.HasField('moments'):
+            return None
+        # NOTE: imported here, geometric_moments itself depends on this module
+        from .c.geometric_moments import GeometricMoments
+        return GeometricMoments.from_pb(c_result.moments)
+
 
 @dataclass
 class ExtractionResults:
@@ -233,3 +476,40 @@ class ExtractionResults:
     def summarize(self) -> ExtractionSummary:
         subsummaries = [s.summarize() for s in self.cell_extraction_results.values()]
         return ExtractionSummary.merged(subsummaries)
+
+    def write_netlist_csv(self, path: str):
+        # TODO: merge this with klayout_pex/klayout/netlist_csv.py
+        with open(path, 'w', encoding='utf-8') as f:
+            summary = self.summarize()
+
+            f.write('Device;Net1;Net2;Capacitance [fF];Resistance [Ω]\n')
+            for idx, (key, cap_value) in enumerate(sorted(summary.capacitances.items())):
+                f.write(f"C{idx + 1};{key.net1};{key.net2};{round(cap_value, 3)};\n")
+            for idx, (key, res_value) in enumerate(sorted(summary.resistances.items())):
+                f.write(f"R{idx + 1};{key.net1};{key.net2};;{round(res_value, 3)}\n")
+
+    def write(self, path: str):
+        """
+        Writes a stream of length-delimited CellExtractionResult messages, one per cell
+        """
+        with open(path, 'wb') as f:
+            for cell_results in self.cell_extraction_results.values():
+                write_delimited(f, cell_results.cell_result_pb())
+
+    @classmethod
+    def read(cls, paths: List[str]) -> ExtractionResults:
+        """
+        Reads one or more result streams written by write(),
+        results of the same cell (e.g. of several tiles) are merged
+        """
+        results = ExtractionResults()
+        for path in paths:
+            with open(path, 'rb') as f:
+                for cell_result in read_delimited(f, pex_result_pb2.CellExtractionResult):
+                    cell_results = CellExtractionResults.from_pb(cell_result)
+                    existing = results.cell_extraction_results.get(cell_results.cell_name, None)
+                    if existing is None:
+                        results.cell_extraction_results[cell_results.cell_name] = cell_results
+                    else:
+                        existing.merge(cell_results)
+        return results
@@ -25,6 +25,7 @@
 
 import klayout.db as kdb
 
+from ..klayout.geometry_cache import LayerGeometry
 from ..klayout.lvsdb_extractor import KLayoutExtractionContext, GDSPair
 from ..log import (
     debug,
@@ -38,9 +39,19 @@ from ..tech_info import TechInfo
 from .extraction_results import *
 from .extraction_reporter import ExtractionReporter
 from .pex_mode import PEXMode
+from .result_mode import ResultMode
+from .report_level import ReportLevel
+from klayout_pex.rcx25.c.fringe_halo import AdaptiveFringeHalo
+from klayout_pex.rcx25.c.cross_section_tables import CrossSectionTables
+from klayout_pex.rcx25.c.fringe_tables import FringeFractionTables
+from klayout_pex.rcx25.c.geometric_moments import GeometricMoments
+from klayout_pex.rcx25.c.layer_relevance import LayerRelevance
 from klayout_pex.rcx25.c.overlap_extractor import OverlapExtractor
+from klayout_pex.rcx25.c.overlap_sweep import OverlapEngine, SweepOverlapExtractor
 from klayout_pex.rcx25.c.sidewall_and_fringe_extractor import SidewallAndFringeExtractor
+from klayout_pex.rcx25.c.substrate_extractor import SubstrateExtractor
 from klayout_pex.rcx25.r.r_extractor import RExtractor
+from klayout_pex.rcx25.r.packed_r_network import RNetworkFormat
 
 import klayout_pex_protobuf.kpex.geometry.shapes_pb2 as shapes_pb2
 import klayout_pex_protobuf.kpex.layout.location_pb2 as location_pb2
@@ -58,7 +69,22 @@ class RCX25Extractor:
                  delaunay_amax: float,
                  delaunay_b: float,
                  tech_info: TechInfo,
-                 report_path: str):
+                 report_path: str,
+                 r_network_format: RNetworkFormat = RNetworkFormat.DEFAULT,
+                 result_mode: ResultMode = ResultMode.DEFAULT,
+                 report_level: ReportLevel = ReportLevel.DEFAULT,
+                 report_sampling_rate: int = 100,
+                 prune_layers: bool = True,
+                 halo_tolerance: Optional[float] = None,
+                 batch_kernels: bool = False,
+                 interval_shielding: bool = False,
+                 overlap_engine: OverlapEngine = OverlapEngine.DEFAULT,
+                 substrate_fast_path: bool = False,
+                 box_kernels: bool = False,
+                 fringe_tables: bool = False,
+                 cross_section_tables: bool = False,
+                 record_moments: bool = False,
+                 via_arrays: bool = False):
         self.pex_context = pex_context
         self.pex_mode = pex_mode
         self.scale_ratio_to_fit_halo = scale_ratio_to_fit_halo
@@ -66,6 +92,21 @@ class RCX25Extractor:
         self.delaunay_b = delaunay_b
         self.tech_info = tech_info
         self.report_path = report_path
+        self.r_network_format = r_network_format
+        self.result_mode = result_mode
+        self.report_level = report_level
+        self.report_sampling_rate = report_sampling_rate
+        self.prune_layers = prune_layers
+        self.halo_tolerance = halo_tolerance
+        self.batch_kernels = batch_kernels
+        self.interval_shielding = interval_shielding
+        self.overlap_engine = overlap_engine
+        self.substrate_fast_path = substrate_fast_path
+        self.box_kernels = box_kernels
+        self.fringe_tables = fringe_tables
+        self.cross_section_tables = cross_section_tables
+        self.record_moments = record_moments
+        self.via_arrays = via_arrays
 
         if "PolygonWithProperties" not in kdb.__all__:
             raise Exception("KLayout version does not support properties (needs 0.30 at least)")
@@ -91,8 +132,13 @@ class RCX25Extractor:
         # TODO: for now, we always flatten and have only 1 cell
         cell_name = self.pex_context.annotated_top_cell.name
         extraction_report = ExtractionReporter(cell_name=cell_name,
-                                               dbu=self.pex_context.dbu)
-        cell_extraction_results = CellExtractionResults(cell_name=cell_name)
+                                               dbu=self.pex_context.dbu,
+                                               report_level=self.report_level,
+                                               sampling_rate=self.report_sampling_rate)
+        cell_extraction_results = CellExtractionResults(cell_name=cell_name,
+                                                        result_mode=self.result_mode)
+        if self.record_moments:
+            cell_extraction_results.moments = GeometricMoments(scale_ratio_to_fit_halo=self.scale_ratio_to_fit_halo)
 
         # Explicitly log the stacktrace here, because otherwise Exceptions 
         # raised in the callbacks of *NeighborhoodVisitors can cause RuntimeErrors
@@ -136,6 +182,11 @@ class RCX25Extractor:
         via_name_above_layer_name: Dict[LayerName, Optional[LayerName]] = {}
         via_regions_by_via_name: Dict[LayerName, kdb.Region] = defaultdict(kdb.Region)
 
+        # cached geometry of canonical layers backed by exactly one extracted layer,
+        # shared with the other engines via KLayoutExtractionContext.geometry_cache
+        layer_geometry_by_name: Dict[LayerName, LayerGeometry] = {}
+        layer_contributions: Dict[LayerName, int] = defaultdict(int)
+
         previous_via_name: Optional[str] = None
 
         for metal_layer in self.tech_info.process_metal_layers:
@@ -151,6 +202,12 @@ class RCX25Extractor:
                 layer_regions_by_name[canonical_layer_name].enable_properties()
                 all_region += all_layer_shapes
 
+                layer_contributions[canonical_layer_name] += 1
+                if layer_contributions[canonical_layer_name] == 1:
+                    layer_geometry_by_name[canonical_layer_name] = self.pex_context.geometry_of_layer(gds_pair)
+                else:
+                    del layer_geometry_by_name[canonical_layer_name]
+
             if metal_layer.metal_layer.HasField('contact_above'):
                 contact = metal_layer.metal_layer.contact_above
 
@@ -169,16 +226,60 @@ class RCX25Extractor:
 
         # ------------------------------------------------------------------------
         if self.pex_mode.need_capacitance():
-            overlap_extractor = OverlapExtractor(
+            layer_relevance: Optional[LayerRelevance] = None
+            if self.prune_layers:
+                layer_relevance = LayerRelevance(all_layer_names=all_layer_names,
+                                                 tech_info=self.tech_info)
+
+            fringe_tables: Optional[FringeFractionTables] = None
+            if self.fringe_tables:
+                fringe_tables = FringeFractionTables(tech_info=self.tech_info, dbu=dbu)
+
+            cross_section_tables: Optional[CrossSectionTables] = None
+            if self.cross_section_tables:
+                cross_section_tables = CrossSectionTables(tech_info=self.tech_info)
+
+            adaptive_halo: Optional[AdaptiveFringeHalo] = None
+            if self.halo_tolerance is not None:
+                adaptive_halo = AdaptiveFringeHalo(all_layer_names=all_layer_names,
+                                                   tech_info=self.tech_info,
+                                                   tolerance=self.halo_tolerance,
+                                                   fringe_tables=fringe_tables)
+                for idx, layer_name in enumerate(all_layer_names):
+                    halo = adaptive_halo.halo_by_layer_index[idx]
+                    info(f"Fringe halo for layer {layer_name}: {round(halo.halo_um, 3)} µm, "
+                         f"truncated fringe fraction ≤ {halo.truncation_bound:.3g}")
+
+            overlap_args = dict(
                 all_layer_names=all_layer_names,
                 layer_regions_by_name=layer_regions_by_name,
                 dbu=dbu,
                 tech_info=self.tech_info,
                 results=results,
-                report=report
+                report=report,
+                layer_relevance=layer_relevance,
+                skip_substrate=self.substrate_fast_path
             )
+            match self.overlap_engine:
+                case OverlapEngine.SWEEP:
+                    overlap_extractor = SweepOverlapExtractor(**overlap_args,
+                                                              layer_geometry_by_name=layer_geometry_by_name)
+                case _:
+                    overlap_extractor = OverlapExtractor(**overlap_args)
             overlap_extractor.extract()
 
+            if self.substrate_fast_path:
+                substrate_extractor = SubstrateExtractor(
+                    all_layer_names=all_layer_names,
+                    layer_regions_by_name=layer_regions_by_name,
+                    dbu=dbu,
+                    tech_info=self.tech_info,
+                    results=results,
+                    report=report,
+                    layer_relevance=layer_relevance
+                )
+                substrate_extractor.extract()
+
             sidewall_and_fringe_extractor = SidewallAndFringeExtractor(
                 all_layer_names=all_layer_names,
                 layer_regions_by_name=layer_regions_by_name,
@@ -186,7 +287,15 @@ class RCX25Extractor:
                 scale_ratio_to_fit_halo=self.scale_ratio_to_fit_halo,
                 tech_info=self.tech_info,
                 results=results,
-                report=report
+                report=report,
+                layer_relevance=layer_relevance,
+                adaptive_halo=adaptive_halo,
+                batch_kernels=self.batch_kernels,
+                interval_shielding=self.interval_shielding,
+                substrate_fast_path=self.substrate_fast_path,
+                box_kernels=self.box_kernels,
+                fringe_tables=fringe_tables,
+                cross_section_tables=cross_section_tables
             )
             sidewall_and_fringe_extractor.extract()
 
@@ -205,7 +314,9 @@ class RCX25Extractor:
                                      delaunay_b = self.delaunay_b,
                                      delaunay_amax = self.delaunay_amax,
                                      via_merge_distance = 0,
-                                     skip_simplify = True)
+                                     skip_simplify = True,
+                                     network_format = self.r_network_format,
+                                     via_arrays = self.via_arrays)
             rex_request = r_extractor.prepare_request()
             report.output_rex_request(request=rex_request)
 
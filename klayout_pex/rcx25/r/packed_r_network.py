@@ -0,0 +1,189 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from __future__ import annotations
+from enum import StrEnum
+from typing import *
+
+import klayout_pex_protobuf.kpex.layout.location_pb2 as location_pb2
+import klayout_pex_protobuf.kpex.r.r_network_pb2 as r_network_pb2
+
+
+class RNetworkFormat(StrEnum):
+    MESSAGES = "messages"  # one RNode / RElement message per node / element
+    PACKED = "packed"      # columnar PackedRNetwork
+    DEFAULT = "messages"
+
+
+class PackedRNetworkBuilder:
+    """
+    Collects nodes and elements of one resistor network column-wise,
+    and writes them in one go into a PackedRNetwork message
+    (extending packed repeated fields is way cheaper than adding sub-messages).
+    """
+
+    def __init__(self, net_name: str):
+        self.net_name = net_name
+
+        self.string_table: List[str] = ['']
+        self.string_index: Dict[str, int] = {'': 0}
+
+        self.node_row_by_id: Dict[int, int] = {}
+
+        self.node_ids: List[int] = []
+        self.node_kinds: List[int] = []
+        self.node_name_indices: List[int] = []
+        self.node_net_name_indices: List[int] = []
+        self.node_layer_indices: List[int] = []
+        self.node_x: List[int] = []
+        self.node_y: List[int] = []
+        self.node_width: List[int] = []
+        self.node_height: List[int] = []
+
+        self.element_ids: List[int] = []
+        self.element_node_a: List[int] = []
+        self.element_node_b: List[int] = []
+        self.element_resistances: List[float] = []
+
+    def intern(self, s: str) -> int:
+        idx = self.string_index.get(s, None)
+        if idx is None:
+            idx = len(self.string_table)
+            self.string_table.append(s)
+            self.string_index[s] = idx
+        return idx
+
+    def add_node(self,
+                 node_id: int,
+                 node_kind: r_network_pb2.RNode.Kind,
+                 node_name: str,
+                 net_name: str,
+                 layer_name: str,
+                 x: int,
+                 y: int,
+                 width: int = 0,
+                 height: int = 0) -> int:
+        row = len(self.node_ids)
+        self.node_row_by_id[node_id] = row
+        self.node_ids.append(node_id)
+        self.node_kinds.append(node_kind)
+        self.node_name_indices.append(self.intern(node_name))
+        self.node_net_name_indices.append(self.intern(net_name))
+        self.node_layer_indices.append(self.intern(layer_name))
+        self.node_x.append(x)
+        self.node_y.append(y)
+        self.node_width.append(width)
+        self.node_height.append(height)
+        return row
+
+    def add_element(self,
+                    element_id: int,
+                    node_id_a: int,
+                    node_id_b: int,
+                    resistance: float):
+        self.element_ids.append(element_id)
+        self.element_node_a.append(self.node_row_by_id[node_id_a])
+        self.element_node_b.append(self.node_row_by_id[node_id_b])
+        self.element_resistances.append(resistance)
+
+    def build(self, packed: r_network_pb2.PackedRNetwork):
+        packed.net_name = self.net_name
+        packed.string_table.extend(self.string_table)
+        packed.node_ids.extend(self.node_ids)
+        packed.node_kinds.extend(self.node_kinds)
+        packed.node_name_indices.extend(self.node_name_indices)
+        packed.node_net_name_indices.extend(self.node_net_name_indices)
+        packed.node_layer_indices.extend(self.node_layer_indices)
+        packed.node_x.extend(self.node_x)
+        packed.node_y.extend(self.node_y)
+        packed.node_width.extend(self.node_width)
+        packed.node_height.extend(self.node_height)
+        packed.element_ids.extend(self.element_ids)
+        packed.element_node_a.extend(self.element_node_a)
+        packed.element_node_b.extend(self.element_node_b)
+        packed.element_resistances.extend(self.element_resistances)
+
+
+def pack_r_network(network: r_network_pb2.RNetwork,
+                   packed: r_network_pb2.PackedRNetwork):
+    builder = PackedRNetworkBuilder(net_name=network.net_name)
+    for node in network.nodes:
+        x = y = w = h = 0
+        match node.location.kind:
+            case location_pb2.Location.Kind.LOCATION_KIND_POINT:
+                x, y = node.location.point.x, node.location.point.y
+            case location_pb2.Location.Kind.LOCATION_KIND_BOX:
+                b = node.location.box
+                x, y = b.lower_left.x, b.lower_left.y
+                w, h = b.upper_right.x - x, b.upper_right.y - y
+        builder.add_node(node_id=node.node_id,
+                         node_kind=node.node_kind,
+                         node_name=node.node_name,
+                         net_name=node.net_name,
+                         layer_name=node.layer_name,
+                         x=x, y=y, width=w, height=h)
+    for element in network.elements:
+        builder.add_element(element_id=element.element_id,
+                            node_id_a=element.node_a.node_id,
+                            node_id_b=element.node_b.node_id,
+                            resistance=element.resistance)
+    builder.build(packed)
+
+
+def unpack_r_network(packed: r_network_pb2.PackedRNetwork,
+                     network: r_network_pb2.RNetwork):
+    """
+    Expands a PackedRNetwork into the message based RNetwork,
+    e.g. for reporting purposes (not intended for the hot path)
+    """
+    st = packed.string_table
+    network.net_name = packed.net_name
+    for row, node_id in enumerate(packed.node_ids):
+        node = network.nodes.add()
+        node.node_id = node_id
+        node.node_kind = packed.node_kinds[row]
+        node.node_name = st[packed.node_name_indices[row]]
+        node.net_name = st[packed.node_net_name_indices[row]]
+        node.layer_name = st[packed.node_layer_indices[row]]
+        x, y = packed.node_x[row], packed.node_y[row]
+        if node.node_kind == r_network_pb2.RNode.Kind.KIND_PIN:
+            node.location.kind = location_pb2.Location.Kind.LOCATION_KIND_POINT
+            node.location.point.x = x
+            node.location.point.y = y
+            node.location.point.net = node.net_name
+        else:
+            node.location.kind = location_pb2.Location.Kind.LOCATION_KIND_BOX
+            node.location.box.lower_left.x = x
+            node.location.box.lower_left.y = y
+            node.location.box.upper_right.x = x + packed.node_width[row]
+            node.location.box.upper_right.y = y + packed.node_height[row]
+            node.location.box.net = node.net_name
+
+    node_ids = packed.node_ids
+    for row, element_id in enumerate(packed.element_ids):
+        element = network.elements.add()
+        element.element_id = element_id
+        element.node_a.node_id = node_ids[packed.element_node_a[row]]
+        element.node_b.node_id = node_ids[packed.element_node_b[row]]
+        element.resistance = packed.element_resistances[row]
@@ -31,10 +31,12 @@ from klayout_pex.log import (
 )
 
 from ..types import NetName
+from .packed_r_network import PackedRNetworkBuilder, RNetworkFormat
 
-from klayout_pex.klayout.shapes_pb2_converter import ShapesConverter
-from klayout_pex.klayout.lvsdb_extractor import KLayoutExtractionContext
+from klayout_pex.klayout.shapes_pb2_converter import shapes_converter
+from klayout_pex.klayout.lvsdb_extractor import KLayoutExtractionContext, KLayoutExtractedLayerInfo
 from klayout_pex.klayout.rex_core import klayout_r_extractor_tech
+from klayout_pex.klayout.via_arrays import ViaArrayHomogenizer
 
 import klayout_pex_protobuf.kpex.layout.device_pb2 as device_pb2
 import klayout_pex_protobuf.kpex.layout.location_pb2 as location_pb2
@@ -56,7 +58,9 @@ class RExtractor:
                  delaunay_b: float,
                  delaunay_amax: float,
                  via_merge_distance: float,
-                 skip_simplify: bool):
+                 skip_simplify: bool,
+                 network_format: RNetworkFormat = RNetworkFormat.DEFAULT,
+                 via_arrays: bool = False):
         """
         :param pex_context: KLayout PEX extraction context
         :param substrate_algorithm: The KLayout PEXCore Algorithm for decomposing polygons.
@@ -69,6 +73,10 @@ class RExtractor:
                               produced in square micrometers.
         :param via_merge_distance: Maximum distance where close vias are merged together
         :param skip_simplify: skip simplification of resistor network
+        :param network_format: Result format of the extracted networks,
+                               either one message per node/element or columnar (packed)
+        :param via_arrays: replace via / contact cut arrays (and drawn vias larger than one cut)
+                           by one block with the area of the number of cuts
         """
         self.pex_context = pex_context
         self.substrate_algorithm = substrate_algorithm
@@ -77,8 +85,10 @@ class RExtractor:
         self.delaunay_amax = delaunay_amax
         self.via_merge_distance = via_merge_distance
         self.skip_simplify = skip_simplify
+        self.network_format = network_format
+        self.via_arrays = via_arrays
 
-        self.shapes_converter = ShapesConverter(dbu=self.pex_context.dbu)
+        self.shapes_converter = shapes_converter(dbu=self.pex_context.dbu)
 
     def prepare_r_extractor_tech_pb(self,
                                     rex_tech: pb_RExtractorTech):
@@ -112,6 +122,10 @@ class RExtractor:
                     case _:
                         pass
 
+                if self.bind_precomputed_r_extractor_layer(rex_tech=rex_tech, source_layer=source_layer):
+                    continue
+
+                # fallback for technology files without precomputed R extractor tech
                 match computed_layer_info.layer_info.purpose:
                     case LP.PURPOSE_NWELL | LP.PURPOSE_PWELL:
                         pass  # TODO!?
@@ -232,6 +246,39 @@ class RExtractor:
 
         return rex_tech
 
+    def bind_precomputed_r_extractor_layer(self,
+                                           rex_tech: pb_RExtractorTech,
+                                           source_layer: KLayoutExtractedLayerInfo) -> bool:
+        """
+        Adds the conductor / via precomputed by gen_tech_pb (see TechInfo.precomputed_r_extractor_tech),
+        bound to the layer indices of the annotated layout and to the runtime options
+        :return: False if there is no precomputed entry for the layer
+        """
+        tech = self.pex_context.tech
+        layout = self.pex_context.annotated_layout
+
+        conductor = tech.precomputed_r_conductor_by_lvs_layer_name.get(source_layer.lvs_layer_name, None)
+        if conductor is not None:
+            cond = rex_tech.conductors.add()
+            cond.CopyFrom(conductor)
+            cond.layer.id = layout.layer(*source_layer.gds_pair)
+            cond.triangulation_min_b = self.delaunay_b
+            cond.triangulation_max_area = self.delaunay_amax
+            cond.algorithm = self.substrate_algorithm if conductor.substrate else self.wire_algorithm
+            return True
+
+        precomputed_via = tech.precomputed_r_via_by_lvs_layer_name.get(source_layer.lvs_layer_name, None)
+        if precomputed_via is not None:
+            via = rex_tech.vias.add()
+            via.CopyFrom(precomputed_via)
+            via.layer.id = layout.layer(*source_layer.gds_pair)
+            via.bottom_conductor.id = layout.layer(*tech.gds_pair(precomputed_via.bottom_conductor.lvs_layer_name))
+            via.top_conductor.id = layout.layer(*tech.gds_pair(precomputed_via.top_conductor.lvs_layer_name))
+            via.merge_distance = self.via_merge_distance
+            return True
+
+        return False
+
     def prepare_request(self) -> pex_request_pb2.RExtractionRequest:
         rex_request = pex_request_pb2.RExtractionRequest()
 
@@ -270,6 +317,8 @@ class RExtractor:
             raise Exception(f"Expected circuit called {self.pex_context.annotated_top_cell.name} in extracted netlist, "
                             f"only available circuits are: {circuits}")
         LK = tech_pb2.ComputedLayerInfo.Kind
+        LP = tech_pb2.LayerInfo.Purpose
+        via_homogenizer = ViaArrayHomogenizer(dbu=self.pex_context.dbu) if self.via_arrays else None
         for net in circuit.each_net():
             net_name = net.name or f"${net.cluster_id}"
             for lvs_gds_pair, lyr_info in self.pex_context.extracted_layers.items():
@@ -282,6 +331,12 @@ class RExtractor:
                             r = self.pex_context.shapes_of_net(lyr.gds_pair, net)
                             if not r:
                                 continue
+                            if via_homogenizer is not None and \
+                               li.layer_info.purpose in (LP.PURPOSE_CONTACT, LP.PURPOSE_VIA):
+                                contact = self.pex_context.tech.contact_by_contact_lvs_layer_name.get(
+                                    lyr.lvs_layer_name, None)
+                                if contact is not None:
+                                    r = via_homogenizer.for_resistance(r, contact)
                             l2r = get_or_create_net_request(net_name).region_by_layer.add()
                             l2r.layer.id = self.pex_context.annotated_layout.layer(*lvs_gds_pair)
                             l2r.layer.canonical_layer_name = self.pex_context.tech.canonical_layer_name_by_gds_pair[lvs_gds_pair]
@@ -345,6 +400,16 @@ class RExtractor:
                                            vertex_ports,
                                            polygon_ports)
 
+            if self.network_format == RNetworkFormat.PACKED:
+                self.pack_resistor_network(net_name=net_extraction_request.net_name,
+                                           resistor_network=resistor_network,
+                                           layer_names=layer_names,
+                                           wire_layer_ids=wire_layer_ids,
+                                           via_layer_ids=via_layer_ids,
+                                           vertex_port_pins=vertex_port_pins,
+                                           packed=rex_result.packed_networks.add())
+                continue
+
             result_network = rex_result.networks.add()
             result_network.net_name = net_extraction_request.net_name
 
@@ -416,3 +481,64 @@ class RExtractor:
 
         return rex_result
 
+    def pack_resistor_network(self,
+                              net_name: str,
+                              resistor_network: 'klp.RNetwork',
+                              layer_names: Dict[int, str],
+                              wire_layer_ids: Set[int],
+                              via_layer_ids: Set[int],
+                              vertex_port_pins: Dict[int, List[Tuple[str, str]]],
+                              packed: r_network_pb2.PackedRNetwork):
+        """
+        Columnar counterpart of the node/element loop in extract(),
+        node naming and kinds are identical, but no per-node messages are created
+        """
+        builder = PackedRNetworkBuilder(net_name=net_name)
+        NK = r_network_pb2.RNode.Kind
+        dbu = self.pex_context.dbu
+
+        for rn in resistor_network.each_node():
+            loc = rn.location()
+            node_name = rn.to_s()
+
+            match rn.type():
+                case klp.RNodeType.VertexPort:   # pins!
+                    p = loc.center().to_itype(dbu)
+                    node_name, node_net_name = vertex_port_pins[rn.layer()][rn.port_index()][0:2]
+                    builder.add_node(node_id=rn.object_id(),
+                                     node_kind=NK.KIND_PIN,
+                                     node_name=node_name,
+                                     net_name=node_net_name,
+                                     layer_name=layer_names[rn.layer()],
+                                     x=p.x, y=p.y)
+                    continue
+                case klp.RNodeType.PolygonPort:
+                    node_kind = NK.KIND_DEVICE_TERMINAL
+                case klp.RNodeType.Internal:
+                    if rn.layer() in via_layer_ids:
+                        node_kind = NK.KIND_VIA_JUNCTION
+                    elif rn.layer() in wire_layer_ids:
+                        node_kind = NK.KIND_WIRE_JUNCTION
+                    else:
+                        raise NotImplementedError()
+                case _:
+                    raise NotImplementedError()
+
+            p1 = loc.p1.to_itype(dbu)
+            p2 = loc.p2.to_itype(dbu)
+            builder.add_node(node_id=rn.object_id(),
+                             node_kind=node_kind,
+                             node_name=node_name,
+                             # NOTE: network prefix, as node name is only unique per network
+                             net_name=f"{net_name}.{node_name}",
+                             layer_name=layer_names[rn.layer()],
+                             x=p1.x, y=p1.y,
+                             width=p2.x - p1.x, height=p2.y - p1.y)
+
+        for el in resistor_network.each_element():
+            builder.add_element(element_id=el.object_id(),
+                                node_id_a=el.a().object_id(),
+                                node_id_b=el.b().object_id(),
+                                resistance=el.resistance())
+
+        builder.build(packed)
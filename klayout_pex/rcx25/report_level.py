@@ -0,0 +1,51 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from enum import StrEnum
+
+
+class ReportLevel(StrEnum):
+    OFF = "off"            # no report database at all
+    SUMMARY = "summary"    # only totals/counts per layer and net combination
+    SAMPLED = "sampled"    # summary, plus every n-th item with its geometry
+    FULL = "full"          # every item with its geometry
+    DEFAULT = "full"
+
+    def keeps_summary(self) -> bool:
+        match self:
+            case ReportLevel.SUMMARY | ReportLevel.SAMPLED:
+                return True
+            case ReportLevel.OFF | ReportLevel.FULL | ReportLevel.DEFAULT:
+                return False
+            case _:
+                raise NotImplementedError()
+
+    def keeps_items(self) -> bool:
+        match self:
+            case ReportLevel.SAMPLED | ReportLevel.FULL | ReportLevel.DEFAULT:
+                return True
+            case ReportLevel.OFF | ReportLevel.SUMMARY:
+                return False
+            case _:
+                raise NotImplementedError()
@@ -0,0 +1,50 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from enum import StrEnum
+
+
+class ResultMode(StrEnum):
+    FULL = "full"                              # keep every OverlapCap/SidewallCap/SideOverlapCap
+    AGGREGATE = "aggregate"                    # only per net pair totals
+    AGGREGATE_BY_LAYER = "aggregate_by_layer"  # per net pair totals, broken down by layers
+    DEFAULT = "full"
+
+    def keeps_entries(self) -> bool:
+        match self:
+            case ResultMode.FULL | ResultMode.DEFAULT:
+                return True
+            case ResultMode.AGGREGATE | ResultMode.AGGREGATE_BY_LAYER:
+                return False
+            case _:
+                raise NotImplementedError()
+
+    def keeps_layer_breakdown(self) -> bool:
+        match self:
+            case ResultMode.FULL | ResultMode.DEFAULT | ResultMode.AGGREGATE_BY_LAYER:
+                return True
+            case ResultMode.AGGREGATE:
+                return False
+            case _:
+                raise NotImplementedError()
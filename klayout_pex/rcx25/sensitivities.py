@@ -0,0 +1,253 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from __future__ import annotations
+from collections import defaultdict
+from dataclasses import dataclass, field
+from typing import *
+
+from klayout_pex.log import (
+    debug,
+)
+from klayout_pex.tech_info import TechInfo
+from klayout_pex.rcx25.c.geometric_moments import GeometricMoments
+from klayout_pex.rcx25.extraction_results import *
+
+import klayout_pex_protobuf.kpex.tech.tech_pb2 as tech_pb2
+
+
+ParameterName = str
+
+
+@dataclass(frozen=True)
+class TechParameter:
+    """
+    One scalar coefficient of the process parasitics, i.e. the field
+        process_parasitics.<section>.<collection>[index].<field_name>
+    of the technology
+    """
+    name: ParameterName       # e.g. overlap_cap[met2/met1]
+    section: str              # capacitance | resistance
+    collection: str           # e.g. overlaps
+    index: int
+    field_name: str           # e.g. capacitance
+    layer_names: FrozenSet[LayerName]
+    value: float
+
+    def scaled_tech(self, tech: tech_pb2.Technology, delta: float) -> tech_pb2.Technology:
+        """
+        :return: copy of tech, where this parameter is changed by delta
+        """
+        scaled = tech_pb2.Technology()
+        scaled.CopyFrom(tech)
+        section = getattr(scaled.process_parasitics, self.section)
+        msg = getattr(section, self.collection)[self.index]
+        setattr(msg, self.field_name, getattr(msg, self.field_name) + delta)
+        return scaled
+
+
+def tech_parameters(tech_info: TechInfo) -> List[TechParameter]:
+    """
+    :return: all coefficients of the process parasitics, the 2.5D engine depends on
+    """
+    params: List[TechParameter] = []
+    cap = tech_info.tech.process_parasitics.capacitance
+    res = tech_info.tech.process_parasitics.resistance
+    substrate = tech_info.internal_substrate_layer_name
+
+    def add(name: str, section: str, collection: str, index: int, field_name: str,
+            layer_names: Iterable[LayerName], value: float):
+        params.append(TechParameter(name=name, section=section, collection=collection, index=index,
+                                    field_name=field_name, layer_names=frozenset(layer_names), value=value))
+
+    for i, sc in enumerate(cap.substrates):
+        add(f"substrate_area_cap[{sc.layer_name}]", 'capacitance', 'substrates', i, 'area_capacitance',
+            (sc.layer_name, substrate), sc.area_capacitance)
+        add(f"substrate_perimeter_cap[{sc.layer_name}]", 'capacitance', 'substrates', i, 'perimeter_capacitance',
+            (sc.layer_name, substrate), sc.perimeter_capacitance)
+    for i, oc in enumerate(cap.overlaps):
+        add(f"overlap_cap[{oc.top_layer_name}/{oc.bottom_layer_name}]", 'capacitance', 'overlaps', i, 'capacitance',
+            (oc.top_layer_name, oc.bottom_layer_name), oc.capacitance)
+    for i, swc in enumerate(cap.sidewalls):
+        add(f"sidewall_cap[{swc.layer_name}]", 'capacitance', 'sidewalls', i, 'capacitance',
+            (swc.layer_name,), swc.capacitance)
+        add(f"sidewall_offset[{swc.layer_name}]", 'capacitance', 'sidewalls', i, 'offset',
+            (swc.layer_name,), swc.offset)
+    for i, soc in enumerate(cap.sideoverlaps):
+        add(f"sideoverlap_cap[{soc.in_layer_name}/{soc.out_layer_name}]", 'capacitance', 'sideoverlaps', i,
+            'capacitance', (soc.in_layer_name, soc.out_layer_name), soc.capacitance)
+
+    for i, lr in enumerate(res.layers):
+        add(f"layer_resistance[{lr.layer_name}]", 'resistance', 'layers', i, 'resistance',
+            (lr.layer_name,), lr.resistance)
+    for i, cr in enumerate(res.contacts):
+        add(f"contact_resistance[{cr.contact_name}/{cr.device_layer_name}]", 'resistance', 'contacts', i,
+            'resistance', (cr.contact_name, cr.device_layer_name), cr.resistance)
+    for i, vr in enumerate(res.vias):
+        add(f"via_resistance[{vr.via_name}]", 'resistance', 'vias', i, 'resistance',
+            (vr.via_name,), vr.resistance)
+
+    return params
+
+
+@dataclass
+class SensitivityResults:
+    """
+    First order sensitivities d(value)/d(parameter) of the extracted net couple values
+    """
+    parameter_by_name: Dict[ParameterName, TechParameter] = field(default_factory=dict)
+    summary: Optional[ExtractionSummary] = None
+
+    # in fF per parameter unit
+    capacitance_derivatives: Dict[NetCoupleKey, Dict[ParameterName, float]] = field(
+        default_factory=lambda: defaultdict(lambda: defaultdict(float))
+    )
+    # in Ω per parameter unit
+    resistance_derivatives: Dict[NetCoupleKey, Dict[ParameterName, float]] = field(
+        default_factory=lambda: defaultdict(lambda: defaultdict(float))
+    )
+
+    def write_csv(self, path: str):
+        """
+        Device names (C1, R1, ...) are those of the nominal netlist CSV
+        """
+        def relative(derivative: float, param_value: float, value: float) -> str:
+            if value == 0.0:
+                return ''
+            return f"{derivative * param_value / value:.6g}"
+
+        with open(path, 'w', encoding='utf-8') as f:
+            f.write('Device;Net1;Net2;Parameter;Parameter Value;Value;Derivative;Relative Sensitivity\n')
+            for prefix, values, derivatives in (
+                ('C', self.summary.capacitances, self.capacitance_derivatives),
+                ('R', self.summary.resistances, self.resistance_derivatives)
+            ):
+                for idx, (key, value) in enumerate(sorted(values.items())):
+                    for param_name, derivative in sorted(derivatives.get(key, {}).items()):
+                        if derivative == 0.0:
+                            continue
+                        param = self.parameter_by_name[param_name]
+                        f.write(f"{prefix}{idx + 1};{key.net1};{key.net2};{param_name};{param.value};"
+                                f"{value:.6g};{derivative:.6g};{relative(derivative, param.value, value)}\n")
+
+
+class SensitivityExtractor:
+    """
+    Computes the sensitivities of a 2.5D extraction result in the same run,
+    without further geometry passes:
+
+        - capacitances: central differences, re-evaluating the recorded geometric moments
+                        of the affected layers only
+        - resistances: element resistances are linear in the layer / contact / via resistance,
+                       so dR/dp = R/p for each element on the layer of p
+    """
+
+    def __init__(self,
+                 tech_info: TechInfo,
+                 relative_step: float = 1e-3,
+                 absolute_step: float = 1e-4):
+        self.tech_info = tech_info
+        self.relative_step = relative_step
+        self.absolute_step = absolute_step  # for parameters with nominal value 0 (e.g. sidewall offsets)
+
+    def step(self, param: TechParameter) -> float:
+        if param.value == 0.0:
+            return self.absolute_step
+        return abs(param.value) * self.relative_step
+
+    def extract(self, results: ExtractionResults) -> SensitivityResults:
+        params = tech_parameters(self.tech_info)
+        sensitivities = SensitivityResults(parameter_by_name={p.name: p for p in params},
+                                           summary=results.summarize())
+
+        for cell_results in results.cell_extraction_results.values():
+            if cell_results.moments is None:
+                raise ValueError(f"No geometric moments were recorded for cell {cell_results.cell_name}")
+            for param in params:
+                if param.section == 'capacitance':
+                    self.add_capacitance_derivatives(cell_results, param, sensitivities)
+            self.add_resistance_derivatives(cell_results, params, sensitivities)
+
+        return sensitivities
+
+    def evaluate_capacitances(self,
+                              cell_name: CellName,
+                              moments: GeometricMoments,
+                              tech: tech_pb2.Technology) -> Dict[NetCoupleKey, float]:
+        results = CellExtractionResults(cell_name=cell_name)
+        moments.evaluate(tech_info=TechInfo(tech=tech, dielectric_filter=None), results=results)
+        return results.summarize().capacitances
+
+    def add_capacitance_derivatives(self,
+                                    cell_results: CellExtractionResults,
+                                    param: TechParameter,
+                                    sensitivities: SensitivityResults):
+        # NOTE: contributions of all other keys cancel out in the difference
+        moments = cell_results.moments.restricted_to_layers(param.layer_names)
+        if not moments.overlap_areas and not moments.sidewall_lengths and not moments.fringe_spans:
+            return
+
+        h = self.step(param)
+        caps_plus = self.evaluate_capacitances(cell_results.cell_name, moments,
+                                               param.scaled_tech(self.tech_info.tech, +h))
+        caps_minus = self.evaluate_capacitances(cell_results.cell_name, moments,
+                                                param.scaled_tech(self.tech_info.tech, -h))
+        for key in caps_plus.keys() | caps_minus.keys():
+            derivative = (caps_plus.get(key, 0.0) - caps_minus.get(key, 0.0)) / (2.0 * h)
+            sensitivities.capacitance_derivatives[key][param.name] += derivative
+
+    def add_resistance_derivatives(self,
+                                   cell_results: CellExtractionResults,
+                                   params: List[TechParameter],
+                                   sensitivities: SensitivityResults):
+        layer_params: Dict[LayerName, TechParameter] = {}
+        via_params: Dict[LayerName, TechParameter] = {}
+        contact_params: Dict[Tuple[LayerName, LayerName], TechParameter] = {}
+        for p in params:
+            match p.collection:
+                case 'layers':
+                    layer_params[next(iter(p.layer_names))] = p
+                case 'vias':
+                    via_params[next(iter(p.layer_names))] = p
+                case 'contacts':
+                    cr = self.tech_info.tech.process_parasitics.resistance.contacts[p.index]
+                    contact_params[(cr.contact_name, cr.device_layer_name)] = p
+
+        unattributed = 0
+        for key, resistance, layer_a, layer_b in cell_results.each_resistor_element():
+            param: Optional[TechParameter] = None
+            if layer_a == layer_b:
+                param = layer_params.get(layer_a, None) or via_params.get(layer_a, None)
+            else:
+                param = via_params.get(layer_a, None) or via_params.get(layer_b, None) \
+                        or contact_params.get((layer_a, layer_b), None) \
+                        or contact_params.get((layer_b, layer_a), None)
+            if param is None or param.value == 0.0:
+                unattributed += 1
+                continue
+            sensitivities.resistance_derivatives[key][param.name] += resistance / param.value
+
+        if unattributed >= 1:
+            debug(f"Cell {cell_results.cell_name}: {unattributed} resistor element(s) "
+                  f"could not be attributed to a resistance parameter")
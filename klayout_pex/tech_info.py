@@ -33,6 +33,7 @@ from .log import (
     warning
 )
 
+from klayout_pex_protobuf.kpex.klayout.r_extractor_tech_pb2 import RExtractorTech as pb_RExtractorTech
 import klayout_pex_protobuf.kpex.tech.tech_pb2 as tech_pb2
 import klayout_pex_protobuf.kpex.tech.process_stack_pb2 as process_stack_pb2
 import klayout_pex_protobuf.kpex.tech.process_parasitics_pb2 as process_parasitics_pb2
@@ -199,6 +200,14 @@ class TechInfo:
         Returns a tuple of the dielectric layer and it's (maximum) height.
         Maximum would be the case where no metal and other dielectrics are present.
         """
+        metal = self.resolved_metal_by_name.get(layer_name, None)
+        if metal is not None:
+            if not metal.simple_dielectric_above:
+                return None, metal.simple_dielectric_height
+            if not self.dielectric_filter.is_included(metal.simple_dielectric_above):
+                return None, 0.0
+            return self.process_stack_layer_by_name[metal.simple_dielectric_above], metal.simple_dielectric_height
+
         found_layer: Optional[process_stack_pb2.ProcessStackInfo.LayerInfo] = None
         diel_lyr: Optional[process_stack_pb2.ProcessStackInfo.LayerInfo] = None
         for lyr in self.tech.process_stack.layers:
@@ -214,6 +223,98 @@ class TechInfo:
                     return diel_lyr, lyr.metal_layer.z - found_layer.metal_layer.z
         return diel_lyr, 5.0   # air TODO
 
+    @cached_property
+    def resolved_process_stack(self) -> Optional[process_stack_pb2.ProcessStackInfo.ResolvedStack]:
+        """
+        Precomputed by gen_tech_pb, None for technology files generated by older versions
+        """
+        if self.tech.process_stack.HasField('resolved'):
+            return self.tech.process_stack.resolved
+        return None
+
+    @cached_property
+    def resolved_metal_by_name(self) -> Dict[str, process_stack_pb2.ProcessStackInfo.ResolvedStack.MetalNeighbours]:
+        rs = self.resolved_process_stack
+        return {} if rs is None else {m.name: m for m in rs.metals}
+
+    @cached_property
+    def resolved_interval_by_name(self) -> Dict[str, process_stack_pb2.ProcessStackInfo.ResolvedStack.Interval]:
+        # NOTE: names are not unique within the stack, the first one wins (like for references)
+        d = {}
+        rs = self.resolved_process_stack
+        if rs is not None:
+            for iv in rs.intervals:
+                d.setdefault(iv.name, iv)
+        return d
+
+    def sidewall_dielectric_shells(self, metal_layer_name: str) \
+            -> List[process_stack_pb2.ProcessStackInfo.ResolvedStack.SidewallShell]:
+        """
+        Sidewall / conformal dielectrics wrapped around the metal, innermost first,
+        up to the first one excluded by the dielectric filter
+        """
+        metal = self.resolved_metal_by_name.get(metal_layer_name, None)
+        if metal is None:
+            return self.derive_sidewall_dielectric_shells(metal_layer_name)
+
+        shells = []
+        for shell in metal.sidewall_shells:
+            if not self.dielectric_filter.is_included(shell.name):
+                break
+            shells.append(shell)
+        return shells
+
+    def derive_sidewall_dielectric_shells(self, metal_layer_name: str) \
+            -> List[process_stack_pb2.ProcessStackInfo.ResolvedStack.SidewallShell]:
+        """
+        Fallback of sidewall_dielectric_shells, for technology files without resolved stack
+        """
+        LT = process_stack_pb2.ProcessStackInfo.LayerType
+        metal_layer = self.process_stack_layer_by_name[metal_layer_name].metal_layer
+        shells = []
+        height = 0.0
+        sidewallee = metal_layer_name
+        while True:
+            sidewall = self.sidewall_dielectric_layer(sidewallee)
+            if not sidewall:
+                break
+            shell = process_stack_pb2.ProcessStackInfo.ResolvedStack.SidewallShell(
+                name=sidewall.name,
+                layer_type=sidewall.layer_type
+            )
+            match sidewall.layer_type:
+                case LT.LAYER_TYPE_SIDEWALL_DIELECTRIC:
+                    sd = sidewall.sidewall_dielectric_layer
+                    height += sd.height_above_metal or metal_layer.thickness
+                    shell.dielectric_k = sd.dielectric_k
+                    shell.width_outside = sd.width_outside_sidewall
+                case LT.LAYER_TYPE_CONFORMAL_DIELECTRIC:
+                    cd = sidewall.conformal_dielectric_layer
+                    height += metal_layer.thickness + cd.thickness_over_metal
+                    shell.dielectric_k = cd.dielectric_k
+                    shell.width_outside = cd.thickness_sidewall
+                    shell.thickness_where_no_metal = cd.thickness_where_no_metal
+            shell.height = height
+            shells.append(shell)
+            sidewallee = sidewall.name
+        return shells
+
+    @cached_property
+    def diffusion_z_interval_by_name(self) -> Dict[str, Tuple[float, float]]:
+        d = {}
+        for lyr in self.process_diffusion_layers:
+            iv = self.resolved_interval_by_name.get(lyr.name, None)
+            if iv is not None:
+                z_bottom, z_top = iv.z_bottom, iv.z_top
+            else:
+                z_bottom, z_top = 0.0, lyr.diffusion_layer.z
+            if z_top <= z_bottom:
+                warning(f"Diffusion layer {lyr.name} has no thickness in the process stack, "
+                        f"assuming 0.1 µm")
+                z_top = z_bottom + 0.1
+            d[lyr.name] = (z_bottom, z_top)
+        return d
+
     @cached_property
     def contact_above_metal_layer_name(self) -> Dict[str, process_stack_pb2.ProcessStackInfo.Contact]:
         d = {}
@@ -295,6 +396,26 @@ class TechInfo:
     def via_resistance_by_layer_name(self) -> Dict[str, process_parasitics_pb2.ResistanceInfo.ViaResistance]:
         return {r.via_name: r for r in self.tech.process_parasitics.resistance.vias}
 
+    @cached_property
+    def precomputed_r_extractor_tech(self) -> Optional[pb_RExtractorTech]:
+        """
+        Precomputed by gen_tech_pb, None for technology files generated by older versions
+        """
+        resistance = self.tech.process_parasitics.resistance
+        if resistance.HasField('r_extractor_tech'):
+            return resistance.r_extractor_tech
+        return None
+
+    @cached_property
+    def precomputed_r_conductor_by_lvs_layer_name(self) -> Dict[LVSLayerName, pb_RExtractorTech.Conductor]:
+        rex_tech = self.precomputed_r_extractor_tech
+        return {} if rex_tech is None else {c.layer.lvs_layer_name: c for c in rex_tech.conductors}
+
+    @cached_property
+    def precomputed_r_via_by_lvs_layer_name(self) -> Dict[LVSLayerName, pb_RExtractorTech.Via]:
+        rex_tech = self.precomputed_r_extractor_tech
+        return {} if rex_tech is None else {v.layer.lvs_layer_name: v for v in rex_tech.vias}
+
     @staticmethod
     def milliohm_to_ohm(milliohm: float) -> float:
         # NOTE: tech_pb2 has mΩ/µm^2
@@ -359,6 +480,28 @@ class TechInfo:
                     d[k1][k2] = v
         return d
 
+    @cached_property
+    def fringe_fraction_table_by_layer_names(self) \
+            -> Dict[Tuple[str, str], process_parasitics_pb2.CapacitanceInfo.FringeFractionTable]:
+        """
+        usage: dict[(top_layer_name, bottom_layer_name)], same keys as overlap_cap_by_layer_names
+
+        Precomputed by gen_tech_pb, empty for technology files generated by older versions
+        """
+        return {(t.top_layer_name, t.bottom_layer_name): t
+                for t in self.tech.process_parasitics.capacitance.fringe_fractions}
+
+    @cached_property
+    def cross_section_table_by_layer_names(self) \
+            -> Dict[Tuple[str, str, str], process_parasitics_pb2.CapacitanceInfo.CrossSectionTable]:
+        """
+        usage: dict[(layer_name, below_layer_name, above_layer_name)]
+
+        Generated by kpex_cross_sections, empty otherwise
+        """
+        return {(t.layer_name, t.below_layer_name, t.above_layer_name): t
+                for t in self.tech.process_parasitics.capacitance.cross_sections}
+
     @cached_property
     def sidewall_cap_by_layer_name(self) -> Dict[str, process_parasitics_pb2.CapacitanceInfo.SidewallCapacitance]:
         return {sc.layer_name: sc for sc in self.tech.process_parasitics.capacitance.sidewalls}
@@ -397,7 +540,10 @@ class TechInfo:
 
         for k1, ve in d2.items():
             for k2, v in ve.items():
-                d[k1][k2] = v
+                if k1 not in d:
+                    d[k1] = {k2: v}
+                else:
+                    d[k1][k2] = v
 
         return d
 
@@ -0,0 +1,87 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from __future__ import annotations
+from typing import *
+
+from google.protobuf.message import Message
+
+# Stream of length-delimited protobuf messages:
+#     <varint size><message bytes><varint size><message bytes>...
+# This is the same framing as used by the C++ functions
+# google::protobuf::util::SerializeDelimitedToOstream / ParseDelimitedFromZeroCopyStream,
+# so streams can be appended to (e.g. one message per tile) and read message by message.
+
+M = TypeVar('M', bound=Message)
+
+
+def _encode_varint(value: int) -> bytes:
+    out = bytearray()
+    while True:
+        bits = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(bits | 0x80)
+        else:
+            out.append(bits)
+            return bytes(out)
+
+
+def _read_varint(stream: BinaryIO) -> Optional[int]:
+    """
+    :return: decoded value, or None at a clean end of stream
+    """
+    result = 0
+    shift = 0
+    while True:
+        b = stream.read(1)
+        if not b:
+            if shift == 0:
+                return None
+            raise EOFError("Truncated varint in delimited protobuf stream")
+        byte = b[0]
+        result |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return result
+        shift += 7
+        if shift >= 64:
+            raise ValueError("Malformed varint in delimited protobuf stream")
+
+
+def write_delimited(stream: BinaryIO, message: Message):
+    data = message.SerializeToString()
+    stream.write(_encode_varint(len(data)))
+    stream.write(data)
+
+
+def read_delimited(stream: BinaryIO, message_type: Type[M]) -> Iterator[M]:
+    while True:
+        size = _read_varint(stream)
+        if size is None:
+            return
+        data = stream.read(size)
+        if len(data) != size:
+            raise EOFError(f"Truncated message in delimited protobuf stream "
+                           f"(expected {size} bytes, got {len(data)})")
+        yield message_type.FromString(data)
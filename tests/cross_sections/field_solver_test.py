@@ -0,0 +1,165 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from __future__ import annotations
+
+import allure
+import unittest
+
+import numpy as np
+
+from klayout_pex.cross_sections.cross_section_builder import CrossSectionBuilder
+from klayout_pex.cross_sections.field_solver import *
+from klayout_pex.cross_sections.table_generator import CrossSectionTableGenerator
+from klayout_pex.tech_info import TechInfo
+import klayout_pex_protobuf.kpex.tech.process_stack_pb2 as process_stack_pb2
+import klayout_pex_protobuf.kpex.tech.tech_pb2 as tech_pb2
+
+LT = process_stack_pb2.ProcessStackInfo.LayerType
+
+
+def two_wires(spacing: float, k: float = 3.9) -> Tuple[CrossSection, int, int]:
+    cs = CrossSection(domain=Rect(-10.0, 0.0, 10.0, 10.0), background_k=k)
+    cs.add_conductor(Rect(-10.0, 0.0, 10.0, 0.0))  # ground plane
+    w1 = cs.add_conductor(Rect(-0.5 * spacing - 0.4, 1.0, -0.5 * spacing, 1.36))
+    w2 = cs.add_conductor(Rect(0.5 * spacing, 1.0, 0.5 * spacing + 0.4, 1.36))
+    return cs, w1, w2
+
+
+def build_tech() -> tech_pb2.Technology:
+    tech = tech_pb2.Technology(name='test')
+    tech.process_parasitics.side_halo = 8.0
+    layers = tech.process_stack.layers
+    resolved = tech.process_stack.resolved
+
+    fox = layers.add(name='fox', layer_type=LT.LAYER_TYPE_FIELD_OXIDE)
+    fox.field_oxide_layer.dielectric_k = 3.9
+    resolved.intervals.add(name='fox', layer_type=LT.LAYER_TYPE_FIELD_OXIDE, z_bottom=0.0, z_top=1.0)
+
+    for idx, (name, z) in enumerate((('m1', 1.0), ('m2', 2.5))):
+        m = layers.add(name=name, layer_type=LT.LAYER_TYPE_METAL)
+        m.metal_layer.z, m.metal_layer.thickness = z, 0.5
+        resolved.intervals.add(name=name, layer_type=LT.LAYER_TYPE_METAL, z_bottom=z, z_top=z + 0.5)
+        cl = tech.lvs_computed_layers.add(original_layer_name=name)
+        cl.layer_info.name = name
+        cl.layer_info.drw_gds_pair.layer = idx + 1
+        tech.process_parasitics.capacitance.sidewalls.add(layer_name=name, capacitance=50.0, offset=0.2)
+
+    ild = layers.add(name='ild', layer_type=LT.LAYER_TYPE_SIMPLE_DIELECTRIC)
+    ild.simple_dielectric_layer.dielectric_k = 4.0
+    ild.simple_dielectric_layer.reference = 'fox'
+    resolved.intervals.add(name='ild', layer_type=LT.LAYER_TYPE_SIMPLE_DIELECTRIC, z_bottom=1.0, z_top=5.0)
+    return tech
+
+
+@allure.parent_suite("Unit Tests")
+@allure.tag("Capacitance", "Field Solver")
+class FieldSolverTest(unittest.TestCase):
+    def test_graded_axis(self):
+        axis = graded_axis(0.0, 10.0, [0.3, 2.0, 20.0], h_min=0.01, h_max=0.5)
+        self.assertEqual(0.0, axis[0])
+        self.assertEqual(10.0, axis[-1])
+        self.assertIn(0.3, axis)
+        self.assertIn(2.0, axis)
+        steps = np.diff(axis)
+        self.assertTrue(np.all(steps > 0.0))
+        self.assertLessEqual(steps.max(), 1.0)
+        self.assertAlmostEqual(0.01, steps[0])
+
+    def test_parallel_plates_layered_dielectric(self):
+        # NOTE: plates spanning the whole domain have no fringe, so the discretization is exact
+        cs = CrossSection(domain=Rect(0.0, 0.0, 10.0, 1.0), background_k=1.0)
+        cs.add_dielectric(Rect(0.0, 0.0, 10.0, 0.3), 3.9)
+        bottom = cs.add_conductor(Rect(0.0, 0.0, 10.0, 0.0))
+        top = cs.add_conductor(Rect(0.0, 1.0, 10.0, 1.0))
+        solver = FieldSolver(cross_section=cs, h_min=0.05, h_max=0.5)
+        expected = EPSILON_0 * 10.0 / (0.3 / 3.9 + 0.7 / 1.0)
+        self.assertAlmostEqual(expected, solver.coupling(bottom, top), delta=1e-6 * expected)
+
+    def test_maxwell_matrix_symmetric(self):
+        cs, w1, w2 = two_wires(spacing=0.2)
+        solver = FieldSolver(cross_section=cs, h_min=0.02, h_max=0.5)
+        q1 = solver.charges(w1)
+        q2 = solver.charges(w2)
+        self.assertAlmostEqual(q1[w2], q2[w1], delta=1e-6 * abs(q1[w2]))
+        self.assertAlmostEqual(q1[w1], q2[w2], delta=1e-6 * q1[w1])
+        # NOTE: all field lines end on a conductor (charge neutrality)
+        self.assertAlmostEqual(0.0, float(q1.sum()), delta=1e-6 * q1[w1])
+
+    def test_coupling_decreases_with_spacing(self):
+        couplings = []
+        for spacing in (0.1, 0.2, 0.5, 1.0, 2.0):
+            cs, w1, w2 = two_wires(spacing=spacing)
+            couplings.append(FieldSolver(cross_section=cs, h_min=0.02, h_max=0.5).coupling(w1, w2))
+        self.assertTrue(all(c > 0.0 for c in couplings))
+        self.assertEqual(sorted(couplings, reverse=True), couplings)
+        # NOTE: at small spacing, the parallel plate part of the sidewalls dominates
+        self.assertGreater(couplings[0], EPSILON_0 * 3.9 * 0.36 / 0.1)
+
+    def test_coupling_scales_with_k(self):
+        cs, w1, w2 = two_wires(spacing=0.3, k=1.0)
+        c1 = FieldSolver(cross_section=cs, h_min=0.02, h_max=0.5).coupling(w1, w2)
+        cs, w1, w2 = two_wires(spacing=0.3, k=4.0)
+        c4 = FieldSolver(cross_section=cs, h_min=0.02, h_max=0.5).coupling(w1, w2)
+        self.assertAlmostEqual(4.0 * c1, c4, delta=1e-6 * c4)
+
+
+@allure.parent_suite("Unit Tests")
+@allure.tag("Capacitance", "Field Solver")
+class CrossSectionTableGeneratorTest(unittest.TestCase):
+    @property
+    def tech_info(self) -> TechInfo:
+        return TechInfo(tech=build_tech(), dielectric_filter=None)
+
+    def test_routing_layers(self):
+        builder = CrossSectionBuilder(tech_info=self.tech_info)
+        self.assertEqual(['m1', 'm2'], [rl.name for rl in builder.routing_layers])
+        self.assertEqual([(1.0, 3.9), (5.0, 4.0)], [(z_top, k) for _, z_top, k in builder.dielectric_bands])
+
+    def test_environments(self):
+        generator = CrossSectionTableGenerator(tech_info=self.tech_info)
+        self.assertEqual([('', ''), ('', 'm2')], generator.environments('m1'))
+        self.assertEqual([('', ''), ('m1', '')], generator.environments('m2'))
+
+    def test_table(self):
+        generator = CrossSectionTableGenerator(tech_info=self.tech_info,
+                                               width_factors=(1.0, 2.0),
+                                               spacing_count=3,
+                                               resolution=4.0)
+        t = generator.table(layer_name='m1', below_layer_name='', above_layer_name='')
+        self.assertEqual([0.5, 1.0], list(t.widths))
+        self.assertEqual(3, len(t.spacings))
+        self.assertAlmostEqual(8.0, t.spacings[-1])
+        self.assertEqual(6, len(t.coupling))
+        for row in np.asarray(t.coupling).reshape(2, 3):
+            self.assertTrue(np.all(np.diff(row) < 0.0))
+
+        # NOTE: the plane above shields part of the coupling
+        shielded = generator.coupling(layer_name='m1', width=0.5, spacing=t.spacings[1],
+                                      below_layer_name='', above_layer_name='m2')
+        self.assertLess(shielded, t.coupling[1])
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,185 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+import allure
+import unittest
+
+import klayout.db as kdb
+
+from klayout_pex.klayout.geometry_cache import GeometryCache, LayerGeometry
+from klayout_pex.klayout.lvsdb_extractor import (
+    KLayoutExtractedLayerInfo,
+    KLayoutExtractionContext,
+    KLayoutMergedExtractedLayerInfo,
+)
+
+
+class TestLayout:
+    """
+    Hierarchical layout with net annotated shapes, like the annotated layout of KLayoutExtractionContext
+
+      layer li1a (TOP): A (0,0;100,100), B (50,0;150,100)
+      layer li1b (TOP): A (100,0;200,100), touching the first A box
+      layer li1a (SUB, placed at x=1000): A (0,0;100,100)
+      layer mcon (TOP): C (0,0;20,20)
+    """
+
+    def __init__(self):
+        self.layout = kdb.Layout()
+        self.layout.dbu = 0.001
+        self.top = self.layout.create_cell('TOP')
+        sub = self.layout.create_cell('SUB')
+        self.top.insert(kdb.CellInstArray(sub.cell_index(), kdb.Trans(kdb.Vector(1000, 0))))
+
+        self.li1a = self.layout.layer()
+        self.li1b = self.layout.layer()
+        self.mcon = self.layout.layer()
+
+        self.insert(self.top, self.li1a, kdb.Box(0, 0, 100, 100), 'A')
+        self.insert(self.top, self.li1a, kdb.Box(50, 0, 150, 100), 'B')
+        self.insert(sub, self.li1a, kdb.Box(0, 0, 100, 100), 'A')
+        self.insert(self.top, self.li1b, kdb.Box(100, 0, 200, 100), 'A')
+        self.insert(self.top, self.mcon, kdb.Box(0, 0, 20, 20), 'C')
+
+    def insert(self, cell: kdb.Cell, layer: int, box: kdb.Box, net: str):
+        cell.shapes(layer).insert(box, self.layout.properties_id({'net': net}))
+
+    def region(self, layer: int) -> kdb.Region:
+        # NOTE: same as KLayoutExtractionContext.nonempty_extracted_layers
+        region = kdb.Region(self.top.begin_shapes_rec(layer))
+        region.enable_properties()
+        return region
+
+
+@allure.parent_suite("Unit Tests")
+@allure.tag("Geometry", "KLayout")
+class GeometryCacheTest(unittest.TestCase):
+    def setUp(self):
+        self.test_layout = TestLayout()
+        self.regions = {
+            (68, 20): [self.test_layout.region(self.test_layout.li1a),
+                       self.test_layout.region(self.test_layout.li1b)],
+            (67, 44): [self.test_layout.region(self.test_layout.mcon)],
+        }
+        self.requests = 0
+
+        def source_regions_of_layer(gds_pair):
+            self.requests += 1
+            return self.regions.get(gds_pair, None)
+
+        self.cache = GeometryCache(source_regions_of_layer=source_regions_of_layer)
+
+    def test_unknown_layer(self):
+        self.assertIsNone(self.cache.layer((1, 0)))
+
+    def test_entry_is_shared(self):
+        g1 = self.cache.layer((67, 44))
+        g2 = self.cache.layer((67, 44))
+        self.assertIsInstance(g1, LayerGeometry)
+        self.assertIs(g1, g2)
+        self.assertIs(self.regions[(67, 44)][0], g1.region)
+        self.assertIsNot(g1, self.cache.layer((68, 20)))
+        # NOTE: a cache hit does not look at the source regions again
+        self.assertEqual(2, self.requests)
+
+    def test_flatten_multiple_sources(self):
+        g = self.cache.layer((68, 20))
+        self.assertEqual(4, g.region.count())
+        self.assertEqual(kdb.Box(0, 0, 1100, 100), g.region.bbox())
+        self.assertEqual({'A', 'B'}, {p.property('net') for p in g.polygons})
+        self.assertIn(kdb.Box(1000, 0, 1100, 100), g.bboxes)
+
+    def test_merged_keeps_nets_apart(self):
+        g = self.cache.layer((68, 20))
+        merged = sorted((p.property('net'), p.bbox().left, p.bbox().right) for p in g.merged.each())
+        # the touching A boxes of both sources are merged, the overlapping B box is not merged into them
+        self.assertEqual([('A', 0, 200), ('A', 1000, 1100), ('B', 50, 150)], merged)
+
+    def test_shapes_by_net(self):
+        g = self.cache.layer((68, 20))
+        self.assertEqual({'A', 'B'}, set(g.shapes_by_net.keys()))
+        self.assertEqual(3, g.shapes_by_net['A'].count())
+        self.assertEqual(3 * 100 * 100, g.shapes_by_net['A'].area())
+        self.assertEqual(kdb.Box(50, 0, 150, 100), g.shapes_by_net['B'].bbox())
+
+    def test_rectangles(self):
+        g = self.cache.layer((68, 20))
+        self.assertTrue(g.is_rectilinear)
+        self.assertEqual(len(g.polygons), len(g.rectangles))
+
+    def test_explicit_invalidation(self):
+        g1 = self.cache.layer((68, 20))
+        g2 = self.cache.layer((67, 44))
+
+        # NOTE: changes of the source regions are not detected, until the layer is invalidated
+        self.regions[(68, 20)] = [self.test_layout.region(self.test_layout.li1a)]
+        self.assertIs(g1, self.cache.layer((68, 20)))
+
+        self.cache.invalidate((68, 20))
+        g3 = self.cache.layer((68, 20))
+        self.assertIsNot(g1, g3)
+        self.assertEqual(3, g3.region.count())
+        self.assertIs(g2, self.cache.layer((67, 44)))
+
+        self.cache.invalidate()
+        self.assertIsNot(g2, self.cache.layer((67, 44)))
+
+    def test_removed_layer(self):
+        self.cache.layer((67, 44))
+        del self.regions[(67, 44)]
+        self.cache.invalidate((67, 44))
+        self.assertIsNone(self.cache.layer((67, 44)))
+        self.assertNotIn((67, 44), self.cache.entries)
+
+
+@allure.parent_suite("Unit Tests")
+@allure.tag("Geometry", "KLayout")
+class ExtractionContextGeometryTest(unittest.TestCase):
+    @staticmethod
+    def extracted_layers(*regions: kdb.Region) -> dict:
+        gds_pair = (68, 20)
+        source_layers = [KLayoutExtractedLayerInfo(index=idx, lvs_layer_name=f"li1_{idx}",
+                                                   gds_pair=gds_pair, region=region)
+                         for idx, region in enumerate(regions)]
+        return {gds_pair: KLayoutMergedExtractedLayerInfo(source_layers=source_layers, gds_pair=gds_pair)}
+
+    def test_rebuilding_extracted_layers_invalidates_geometry(self):
+        test_layout = TestLayout()
+        context = KLayoutExtractionContext(
+            lvsdb=None, tech=None, dbu=test_layout.layout.dbu,
+            layer_index_map={}, lvsdb_regions={}, cell_mapping=None,
+            annotated_top_cell=test_layout.top, annotated_layout=test_layout.layout,
+            extracted_layers=self.extracted_layers(test_layout.region(test_layout.li1a),
+                                                   test_layout.region(test_layout.li1b)),
+            unnamed_layers=[]
+        )
+
+        self.assertEqual(3, context.shapes_of_net((68, 20), 'A').count())
+        self.assertEqual(4, context.shapes_of_layer((68, 20)).count())
+
+        context.extracted_layers = self.extracted_layers(test_layout.region(test_layout.li1a))
+        self.assertEqual(2, context.shapes_of_net((68, 20), 'A').count())
+        self.assertEqual(3, context.shapes_of_layer((68, 20)).count())
+
+        context.extracted_layers = {}
+        self.assertIsNone(context.shapes_of_net((68, 20), 'A'))
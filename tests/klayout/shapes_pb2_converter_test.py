@@ -27,7 +27,12 @@ import unittest
 
 import klayout.db as kdb
 import klayout_pex_protobuf.kpex.geometry.shapes_pb2 as shapes_pb2
-from klayout_pex.klayout.shapes_pb2_converter import ShapesConverter
+from klayout_pex.klayout.shapes_pb2_converter import (
+    NativeShapesConverter,
+    ShapesConverter,
+    shapes_converter,
+)
+import klayout_pex.native as native
 
 from klayout_pex.log import (
     LogLevel,
@@ -187,3 +192,51 @@ class ShapesConverterTest(unittest.TestCase):
         self.assertEqual(p2.y, pt_kly[2].y)
         self.assertEqual(p3.x, pt_kly[3].x)
         self.assertEqual(p3.y, pt_kly[3].y)
+
+    def test_shapes_converter(self):
+        conv = shapes_converter(self.dbu)
+        self.assertIsInstance(conv, ShapesConverter)
+        self.assertEqual(native.native_available(), isinstance(conv, NativeShapesConverter))
+
+
+@allure.parent_suite("Unit Tests")
+@allure.tag("Geometry", "Shapes", "KLayout", "Native")
+@unittest.skipUnless(native.native_available(), "native extension not built (KPEX_BUILD_PYTHON_EXTENSION)")
+class NativeShapesConverterTest(unittest.TestCase):
+    def setUp(self):
+        self.dbu = 0.001
+        self.region = kdb.Region()
+        self.region.insert(kdb.PolygonWithProperties(kdb.Polygon(kdb.Box(-100, -50, 750, 300)), {'net': 'VDD'}))
+        self.region.insert(kdb.Polygon([kdb.Point(1000, 0), kdb.Point(1000, 400),
+                                        kdb.Point(1200, 400), kdb.Point(1200, 200),
+                                        kdb.Point(1600, 200), kdb.Point(1600, 0)]))
+
+    def test_klayout_region_to_pb(self):
+        expected = shapes_pb2.Region()
+        ShapesConverter(self.dbu).klayout_region_to_pb(self.region, expected)
+        obtained = shapes_pb2.Region()
+        NativeShapesConverter(self.dbu).klayout_region_to_pb(self.region, obtained)
+        self.assertEqual(expected, obtained)
+
+    def test_klayout_polygon_to_pb(self):
+        pg_kly = kdb.PolygonWithProperties(kdb.Polygon(kdb.Box(10, 20, 750, 30)), {'net': 'VSS'})
+        expected = shapes_pb2.Shape()
+        ShapesConverter(self.dbu).klayout_polygon_to_pb(pg_kly, expected)
+        obtained = shapes_pb2.Shape()
+        NativeShapesConverter(self.dbu).klayout_polygon_to_pb(pg_kly, obtained)
+        self.assertEqual(expected, obtained)
+
+    def test_klayout_region(self):
+        r_pb = shapes_pb2.Region()
+        ShapesConverter(self.dbu).klayout_region_to_pb(self.region, r_pb)
+        sh_pb = r_pb.shapes.add()
+        ShapesConverter(self.dbu).klayout_box_to_pb(kdb.BoxWithProperties(kdb.Box(0, 0, 140, 140), {'net': 'A'}),
+                                                    sh_pb)
+
+        expected = ShapesConverter(self.dbu).klayout_region(r_pb)
+        obtained = NativeShapesConverter(self.dbu).klayout_region(r_pb)
+        self.assertEqual(expected.count(), obtained.count())
+        self.assertEqual(sorted(str(p) for p in expected.each()),
+                         sorted(str(p) for p in obtained.each()))
+        self.assertEqual(sorted(str(p.property('net')) for p in expected.each()),
+                         sorted(str(p.property('net')) for p in obtained.each()))
@@ -0,0 +1,91 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+import allure
+import unittest
+
+from klayout_pex.klayout.via_arrays import (
+    cluster_boxes,
+    cut_count,
+    cuts_per_extent,
+    envelope,
+    equivalent_box,
+    find_via_arrays,
+    is_regular_array,
+)
+import klayout_pex_protobuf.kpex.tech.process_stack_pb2 as process_stack_pb2
+
+DBU = 0.001
+
+
+def via1() -> process_stack_pb2.ProcessStackInfo.Contact:
+    # sky130A via: 0.15 cuts, 0.17 spacing, 0.055 border
+    return process_stack_pb2.ProcessStackInfo.Contact(name='via1', width=0.15, spacing=0.17, border=0.055)
+
+
+def cut_grid(nx: int, ny: int, x0: int = 0, y0: int = 0, width: int = 150, pitch: int = 320):
+    return [(x0 + i * pitch, y0 + j * pitch, x0 + i * pitch + width, y0 + j * pitch + width)
+            for j in range(ny) for i in range(nx)]
+
+
+@allure.parent_suite("Unit Tests")
+class ViaArraysTest(unittest.TestCase):
+    def test_cuts_per_extent(self):
+        c = via1()
+        self.assertEqual(1, cuts_per_extent(0.15, c))
+        self.assertEqual(1, cuts_per_extent(0.26, c))
+        # 0.11 border + 2 * 0.15 + 0.17 spacing
+        self.assertEqual(2, cuts_per_extent(0.58, c))
+        self.assertEqual(3, cuts_per_extent(0.90, c))
+
+    def test_cut_count_of_drawn_via(self):
+        self.assertEqual(6, cut_count((0, 0, 900, 580), via1(), DBU))
+
+    def test_cluster_boxes(self):
+        boxes = cut_grid(3, 3) + cut_grid(2, 1, x0=5000)
+        clusters = sorted(cluster_boxes(boxes, max_gap=320), key=len)
+        self.assertEqual([2, 9], [len(c) for c in clusters])
+        self.assertEqual({9, 10}, set(clusters[0]))
+
+    def test_is_regular_array(self):
+        self.assertTrue(is_regular_array(cut_grid(4, 2)))
+        self.assertFalse(is_regular_array(cut_grid(3, 3)[:-1]))  # incomplete grid
+        self.assertFalse(is_regular_array(cut_grid(2, 1) + [(1000, 0, 1150, 150)]))  # irregular pitch
+
+    def test_find_via_arrays(self):
+        boxes = cut_grid(3, 3) + cut_grid(1, 1, x0=5000)
+        arrays = find_via_arrays(boxes, via1(), DBU, min_cuts=4)
+        self.assertEqual(1, len(arrays))
+        self.assertEqual(9, arrays[0].cut_count)
+        self.assertEqual((0, 0, 790, 790), arrays[0].envelope)
+        self.assertEqual(envelope(cut_grid(3, 3)), arrays[0].envelope)
+
+    def test_equivalent_box_keeps_area_and_center(self):
+        env = (0, 0, 790, 790)
+        box = equivalent_box(env, 9 * 150 * 150)
+        left, bottom, right, top = box
+        self.assertEqual(450, right - left)
+        self.assertEqual(450, top - bottom)
+        self.assertEqual((395, 395), ((left + right) // 2, (bottom + top) // 2))
+        # never larger than the box itself
+        self.assertEqual(env, equivalent_box(env, 1e12))
@@ -0,0 +1,97 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+import allure
+import unittest
+
+import klayout.db as kdb
+import klayout_pex_protobuf.kpex.geometry.shapes_pb2 as shapes_pb2
+import klayout_pex_protobuf.kpex.request.pex_request_pb2 as pex_request_pb2
+from klayout_pex.klayout.shapes_pb2_converter import ShapesConverter
+import klayout_pex.native as native
+
+
+def sample_region() -> kdb.Region:
+    region = kdb.Region()
+    region.insert(kdb.PolygonWithProperties(kdb.Polygon(kdb.Box(-100, -50, 750, 300)), {'net': 'VDD'}))
+    region.insert(kdb.PolygonWithProperties(kdb.Polygon([kdb.Point(1000, 0), kdb.Point(1000, 400),
+                                                         kdb.Point(1200, 400), kdb.Point(1200, 200),
+                                                         kdb.Point(1600, 200), kdb.Point(1600, 0)]),
+                                            {'net': 'VSS'}))
+    region.insert(kdb.Polygon(kdb.Box(5000, 5000, 5140, 5140)))
+    return region
+
+
+@allure.parent_suite("Unit Tests")
+@allure.tag("Native", "Protobuf", "KLayout")
+@unittest.skipUnless(native.native_available(), "native extension not built (KPEX_BUILD_PYTHON_EXTENSION)")
+class NativeExtensionTest(unittest.TestCase):
+    def test_protobuf_version(self):
+        self.assertRegex(native.protobuf_version(), r'^\d+\.\d+\.\d+$')
+
+    def test_region_to_pb__same_as_shapes_converter(self):
+        region = sample_region()
+
+        expected = shapes_pb2.Region()
+        ShapesConverter(dbu=0.001).klayout_region_to_pb(region, expected)
+
+        obtained = shapes_pb2.Region()
+        native.region_to_pb(region, obtained)
+
+        self.assertEqual(expected, obtained)
+        self.assertEqual(3, len(obtained.shapes))
+
+    def test_region_to_pb__appends_to_nested_message(self):
+        request = pex_request_pb2.RNetExtractionRequest()
+        region_pb = request.region_by_layer.add().region
+        native.region_to_pb(sample_region(), region_pb)
+        native.region_to_pb(sample_region(), region_pb)
+        self.assertEqual(6, len(request.region_by_layer[0].region.shapes))
+
+    def test_region_to_pb__empty(self):
+        region_pb = shapes_pb2.Region()
+        native.region_to_pb(kdb.Region(), region_pb)
+        self.assertEqual(0, len(region_pb.shapes))
+
+    def test_message_stats(self):
+        region_pb = shapes_pb2.Region()
+        native.region_to_pb(sample_region(), region_pb)
+        stats = native.message_stats(region_pb)
+        self.assertIn('kpex.geometry.Region', stats)
+        self.assertIn('shapes.polygon.hull_points', stats)
+
+    def test_message_stats__malformed(self):
+        with self.assertRaises(ValueError):
+            native._kpex_native.message_stats('kpex.geometry.Region', b'\xff\xff\xff')
+        with self.assertRaises(ValueError):
+            native._kpex_native.message_stats('NoSuchMessage', b'')
+
+
+@allure.parent_suite("Unit Tests")
+@allure.tag("Native", "Protobuf")
+class NativeFallbackTest(unittest.TestCase):
+    @unittest.skipIf(native.native_available(), "native extension is built")
+    def test_require_native(self):
+        with self.assertRaises(RuntimeError):
+            native.region_to_pb([], shapes_pb2.Region())
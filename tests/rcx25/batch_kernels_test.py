@@ -0,0 +1,101 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+import allure
+from collections import defaultdict
+import math
+import unittest
+
+from klayout_pex.rcx25.c.batch_kernels import *
+from klayout_pex.rcx25.c.fringe_halo import FRINGE_ALPHA_SCALE_FACTOR
+from tech_info_test_helpers import build_tech_info
+
+
+def scalar_fringe_cap(overlap_cap: float,
+                      sideoverlap_cap: float,
+                      length_um: float,
+                      near_um: float,
+                      far_um: float,
+                      side_halo: float,
+                      scale_ratio_to_fit_halo: bool) -> float:
+    # same formula as PEXEdgeNeighborhoodVisitor.fringe_cap
+    alpha_c = overlap_cap * FRINGE_ALPHA_SCALE_FACTOR
+    cnear = (2.0 / math.pi) * math.atan(alpha_c * near_um)
+    cfar = (2.0 / math.pi) * math.atan(alpha_c * far_um)
+    if scale_ratio_to_fit_halo:
+        full_halo_ratio = (2.0 / math.pi) * math.atan(alpha_c * side_halo)
+        if full_halo_ratio < 1.0:
+            cnear /= full_halo_ratio
+            cfar /= full_halo_ratio
+    return (cfar - cnear) * length_um * sideoverlap_cap / 1000.0
+
+
+@allure.parent_suite("Unit Tests")
+class BatchKernelsTest(unittest.TestCase):
+    def test_fringe_batch_matches_scalar_formula(self):
+        tech_info = build_tech_info(overlaps={('m2', 'm1'): 38.0, ('m2', 'poly'): 110.0},
+                                    sideoverlaps={('m2', 'm1'): 41.0, ('m2', 'poly'): 58.0})
+        ovl = tech_info.overlap_cap_by_layer_names['m2']
+        sovl = tech_info.side_overlap_cap_by_layer_names['m2']
+
+        records = [
+            ('m1', 'A', 'B', 2.0, 0.0, 0.5),
+            ('m1', 'A', 'B', 1.5, 0.2, 3.0),
+            ('poly', 'A', 'C', 0.8, 0.1, 1.0),
+            ('poly', 'A', 'C', 0.001, 0.1, 0.2),  # below threshold
+        ]
+
+        for scale in (False, True):
+            batch = FringeBatch(side_halo=8.0, scale_ratio_to_fit_halo=scale)
+            expected: Dict[SideOverlapKey, float] = defaultdict(float)
+            for outside_layer, net1, net2, length, near, far in records:
+                key = SideOverlapKey(layer_inside='m2', net_inside=net1,
+                                     layer_outside=outside_layer, net_outside=net2)
+                batch.add(inside_layer_name='m2', outside_layer_name=outside_layer,
+                          overlap_cap_spec=ovl[outside_layer], sideoverlap_cap_spec=sovl[outside_layer],
+                          key=key, length_um=length, distance_near_um=near, distance_far_um=far)
+                cap = scalar_fringe_cap(ovl[outside_layer].capacitance, sovl[outside_layer].capacitance,
+                                        length, near, far, side_halo=8.0, scale_ratio_to_fit_halo=scale)
+                if cap > FRINGE_CAP_THRESHOLD:
+                    expected[key] += cap
+
+            results = CellExtractionResults(cell_name='Cell')
+            batch.flush(results)
+            obtained = results.sideoverlap_cap_sums()
+            self.assertEqual(set(expected.keys()), set(obtained.keys()))
+            for key, cap in expected.items():
+                self.assertAlmostEqual(cap, obtained[key], places=12)
+
+    def test_sidewall_batch_matches_scalar_formula(self):
+        spec = build_tech_info(sidewalls={'m1': (45.0, 0.1)}).sidewall_cap_by_layer_name['m1']
+        batch = SidewallBatch()
+        key = SidewallKey(layer='m1', net1='A', net2='B')
+        expected = 0.0
+        for length, distance in ((1.0, 0.2), (3.0, 0.5), (0.5, 2.0)):
+            batch.add(layer_name='m1', sidewall_cap_spec=spec, key=key, length_um=length, distance_um=distance)
+            expected += length * spec.capacitance / (distance + spec.offset) / 2.0 / 1000.0
+
+        results = CellExtractionResults(cell_name='Cell')
+        batch.flush(results)
+        self.assertAlmostEqual(expected, results.sidewall_cap_sums()[key], places=12)
+        self.assertEqual(1, len(results.sidewall_table[key]))
@@ -0,0 +1,58 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+import allure
+import unittest
+
+from klayout_pex.rcx25.c.box_kernels import *
+
+
+@allure.parent_suite("Unit Tests")
+class BoxKernelsTest(unittest.TestCase):
+    def test_merge_strips(self):
+        # L-shape, decomposed into horizontal strips
+        strips = [(0, 0, 30, 10), (0, 10, 10, 20), (0, 20, 10, 40)]
+        self.assertEqual([(0, 10, 10, 40), (0, 0, 30, 10)], merge_strips(strips))
+
+    def test_fringe_spans_are_clipped_to_the_interval(self):
+        boxes = [(0, 0, 30, 10), (0, 10, 10, 40)]
+        self.assertEqual([(25, 0, 10), (5, 10, 40)], fringe_spans(boxes, 5, 100))
+        self.assertEqual([(10, 0, 10)], fringe_spans(boxes, 20, 100))
+        # negative distances are clamped, empty spans are dropped
+        self.assertEqual([(10, 0, 5)], fringe_spans([(0, -5, 10, 5), (0, -5, 10, -1)], 0, 10))
+
+    def test_lower_envelope(self):
+        # a step: near at 10 for x in [0, 20], near at 30 for x in [20, 50]
+        boxes = [(0, 10, 20, 50), (20, 30, 50, 50)]
+        self.assertEqual([(0, 20, 10), (20, 50, 30)], lower_envelope(boxes, 0, 50))
+        # uncovered parts are omitted
+        self.assertEqual([(30, 50, 30)], lower_envelope([(30, 30, 60, 50)], 0, 50))
+        # same distance is joined
+        self.assertEqual([(0, 40, 10)], lower_envelope([(0, 10, 20, 50), (20, 10, 40, 15)], 0, 40))
+
+    def test_covered_area(self):
+        # overlapping boxes are counted once, and clipped to the window
+        boxes = [(-10, -10, 60, 5), (0, 0, 30, 20), (20, 10, 100, 30)]
+        self.assertEqual(50 * 5 + 30 * 15 + 20 * 10, covered_area(boxes, 0, 50, 0, 20))
+        self.assertEqual(0, covered_area([(0, 30, 50, 40)], 0, 50, 0, 20))
+        self.assertEqual(1000, covered_area([(0, 0, 25, 20), (25, 0, 50, 20)], 0, 50, 0, 20))
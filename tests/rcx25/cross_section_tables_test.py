@@ -0,0 +1,182 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+
+from __future__ import annotations
+
+import allure
+import unittest
+from types import SimpleNamespace
+from typing import *
+
+from klayout_pex.rcx25.c.batch_kernels import SidewallBatch
+from klayout_pex.rcx25.c.cap_formulas import sidewall_cap_femto
+from klayout_pex.rcx25.c.cross_section_tables import (
+    CROSS_SECTION_COVERAGE,
+    CrossSectionTable,
+    CrossSectionTables,
+    coupling_cap_femto,
+)
+from klayout_pex.rcx25.c.sidewall_and_fringe_extractor import SidewallAndFringeExtractor
+from klayout_pex.rcx25.extraction_results import SidewallKey
+from klayout_pex.tech_info import TechInfo
+from klayout_pex_protobuf.kpex.tech.process_parasitics_pb2 import CapacitanceInfo
+import klayout_pex_protobuf.kpex.tech.tech_pb2 as tech_pb2
+
+
+def box(left: int, bottom: int, right: int, top: int) -> SimpleNamespace:
+    # NOTE: stand-in for kdb.PolygonWithProperties (a box in the rotated edge neighborhood)
+    return SimpleNamespace(is_box=lambda: True,
+                           bbox=lambda: SimpleNamespace(left=left, bottom=bottom, right=right, top=top))
+
+
+def make_table(layer_name: str = 'm1',
+               below_layer_name: str = '',
+               above_layer_name: str = '',
+               scale: float = 1.0) -> CapacitanceInfo.CrossSectionTable:
+    # coupling = scale · (10 + width) / spacing
+    t = CapacitanceInfo.CrossSectionTable(layer_name=layer_name,
+                                          below_layer_name=below_layer_name,
+                                          above_layer_name=above_layer_name)
+    t.widths.extend([0.2, 0.4, 0.8])
+    t.spacings.extend([0.1, 0.2, 0.4, 0.8, 1.6])
+    for w in t.widths:
+        for s in t.spacings:
+            t.coupling.append(scale * (10.0 + w) / s)
+    return t
+
+
+@allure.parent_suite("Unit Tests")
+@allure.tag("Capacitance", "Sidewall")
+class CrossSectionTablesTest(unittest.TestCase):
+    def test_exact_at_samples(self):
+        pb = make_table()
+        table = CrossSectionTable(table=pb)
+        n = len(pb.spacings)
+        for i, w in enumerate(pb.widths):
+            for j, s in enumerate(pb.spacings):
+                self.assertAlmostEqual(pb.coupling[i * n + j], table.coupling(width_um=w, spacing_um=s), places=9)
+
+    def test_power_law_in_spacing(self):
+        # NOTE: log-log interpolation is exact for c ~ 1/s, also when extrapolating
+        table = CrossSectionTable(table=make_table())
+        for s in (0.05, 0.15, 0.3, 1.0, 3.0):
+            self.assertAlmostEqual(10.2 / s, table.coupling(width_um=0.2, spacing_um=s), places=9)
+
+    def test_width(self):
+        table = CrossSectionTable(table=make_table())
+        self.assertAlmostEqual(10.2 / 0.4, table.coupling(width_um=0.1, spacing_um=0.4), places=9)
+        self.assertAlmostEqual(10.8 / 0.4, table.coupling(width_um=5.0, spacing_um=0.4), places=9)
+        c = table.coupling(width_um=0.3, spacing_um=0.4)
+        self.assertGreater(c, 10.2 / 0.4)
+        self.assertLess(c, 10.4 / 0.4)
+
+    def test_zero_coupling(self):
+        pb = make_table()
+        pb.coupling[4] = 0.0
+        table = CrossSectionTable(table=pb)
+        self.assertAlmostEqual(0.0, table.coupling(width_um=0.2, spacing_um=1.6), places=6)
+        self.assertGreater(table.coupling(width_um=0.2, spacing_um=0.8), 0.0)
+
+    def test_sidewall_cap_femto(self):
+        table = CrossSectionTable(table=make_table())
+        # NOTE: same convention as the formula (half per edge)
+        self.assertAlmostEqual(2.0 * 10.2 / 0.4 / 2.0 / 1000.0,
+                               table.sidewall_cap_femto(length_um=2.0, width_um=0.2, distance_um=0.4),
+                               places=12)
+
+    def make_tables(self) -> CrossSectionTables:
+        tech = tech_pb2.Technology(name='test')
+        tech.process_parasitics.capacitance.cross_sections.extend([
+            make_table(scale=1.0),
+            make_table(below_layer_name='m0', scale=2.0),
+            make_table(above_layer_name='m2', scale=3.0),
+        ])
+        return CrossSectionTables(tech_info=TechInfo(tech=tech, dielectric_filter=None))
+
+    def test_environment_exact_match(self):
+        tables = self.make_tables()
+
+        def scale(below: str, above: str) -> Optional[float]:
+            t = tables.table(layer_name='m1', below_layer_name=below, above_layer_name=above)
+            return None if t is None else t.coupling(width_um=0.2, spacing_um=0.1) / 102.0
+
+        self.assertAlmostEqual(1.0, scale('', ''))
+        self.assertAlmostEqual(2.0, scale('m0', ''))
+        self.assertAlmostEqual(3.0, scale('', 'm2'))
+        # NOTE: environments without a table use the sidewall formula
+        self.assertIsNone(scale('m0', 'm2'))
+        self.assertIsNone(scale('mx', ''))
+        self.assertIsNone(tables.table(layer_name='m2', below_layer_name='', above_layer_name=''))
+
+    def test_gap_classification(self):
+        tables = self.make_tables()
+        all_layer_names = ['VSUBS', 'm0', 'm1', 'm2']
+        visitor = SimpleNamespace(all_layer_names=all_layer_names,
+                                  inside_layer_index=2,
+                                  inside_layer_name='m1',
+                                  tech_info=SimpleNamespace(internal_substrate_layer_name='VSUBS'),
+                                  cross_section_tables=tables)
+
+        def scale(polygons_by_child: Dict[int, List[SimpleNamespace]]) -> Optional[float]:
+            t = SidewallAndFringeExtractor.PEXEdgeNeighborhoodVisitor.cross_section_table(
+                visitor, polygons_by_child=polygons_by_child, edge_interval=(0, 1000), gap_dbu=200
+            )
+            return None if t is None else t.coupling(width_um=0.2, spacing_um=0.1) / 102.0
+
+        # the substrate, the sidewall neighbour and shapes beyond the gap don't count
+        self.assertAlmostEqual(1.0, scale({0: [box(-100, -100, 1100, 5000)],
+                                           2: [box(0, 200, 1000, 400)],
+                                           1: [box(0, 250, 1000, 900)]}))
+        # planes covering the gap
+        self.assertAlmostEqual(2.0, scale({1: [box(-100, -300, 1100, 900)]}))
+        self.assertAlmostEqual(2.0, scale({1: [box(0, -50, 600, 300), box(600, -50, 1000, 300)]}))
+        self.assertAlmostEqual(3.0, scale({3: [box(0, 0, 1000, 200)]}))
+        # partially covered gap
+        uncovered = int(1000 * (1.0 - CROSS_SECTION_COVERAGE)) + 10
+        self.assertIsNone(scale({1: [box(uncovered, -300, 1100, 900)]}))
+        self.assertIsNone(scale({1: [box(-100, -300, 1100, 100)]}))
+        # no table for this environment
+        self.assertIsNone(scale({1: [box(0, 0, 1000, 200)], 3: [box(0, 0, 1000, 200)]}))
+
+    def test_no_tables(self):
+        tables = CrossSectionTables(tech_info=TechInfo(tech=tech_pb2.Technology(name='test'),
+                                                       dielectric_filter=None))
+        self.assertIsNone(tables.table(layer_name='m1', below_layer_name='', above_layer_name=''))
+
+    def test_batch(self):
+        spec = CapacitanceInfo.SidewallCapacitance(layer_name='m1', capacitance=44.0, offset=0.25)
+        key = SidewallKey(layer='m1', net1='A', net2='B')
+        batch = SidewallBatch()
+        batch.add(layer_name='m1', sidewall_cap_spec=spec, key=key, length_um=2.0, distance_um=0.3)
+        batch.add(layer_name='m1', sidewall_cap_spec=spec, key=key, length_um=3.0, distance_um=0.5,
+                  coupling=80.0)
+        sums, counts = batch.evaluate()
+        expected = sidewall_cap_femto(length_um=2.0, distance_um=0.3, sidewall_cap_spec=spec) + \
+                   coupling_cap_femto(length_um=3.0, coupling=80.0)
+        self.assertAlmostEqual(expected, float(sums[0]), places=12)
+        self.assertEqual(2, int(counts[0]))
+
+
+if __name__ == '__main__':
+    unittest.main()
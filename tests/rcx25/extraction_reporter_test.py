@@ -0,0 +1,67 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+import allure
+import unittest
+
+from klayout_pex.rcx25.extraction_reporter import ExtractionReporter
+from klayout_pex.rcx25.extraction_results import *
+from klayout_pex.rcx25.report_level import ReportLevel
+
+
+@allure.parent_suite("Unit Tests")
+class ExtractionReporterTest(unittest.TestCase):
+    def key(self) -> SidewallKey:
+        return SidewallKey(layer='m1', net1='A', net2='B')
+
+    def test_full_accepts_everything(self):
+        reporter = ExtractionReporter(cell_name='Cell', dbu=0.001, report_level=ReportLevel.FULL)
+        self.assertTrue(all(reporter.accept('sidewall', self.key(), 1.0) for _ in range(10)))
+        self.assertEqual(0, len(reporter.summary_totals))
+
+    def test_off_accepts_nothing(self):
+        reporter = ExtractionReporter(cell_name='Cell', dbu=0.001, report_level=ReportLevel.OFF)
+        self.assertFalse(any(reporter.accept('sidewall', self.key(), 1.0) for _ in range(10)))
+        self.assertFalse(reporter.sample('rex_result_network'))
+        self.assertEqual(0, len(reporter.summary_totals))
+
+    def test_summary_counts_but_accepts_nothing(self):
+        reporter = ExtractionReporter(cell_name='Cell', dbu=0.001, report_level=ReportLevel.SUMMARY)
+        self.assertFalse(any(reporter.accept('sidewall', self.key(), 1.0) for _ in range(10)))
+        total = reporter.summary_totals[('sidewall', repr(self.key()))]
+        self.assertEqual(CapTotal(cap_value=10.0, count=10), total)
+
+    def test_sampled(self):
+        reporter = ExtractionReporter(cell_name='Cell', dbu=0.001,
+                                      report_level=ReportLevel.SAMPLED, sampling_rate=4)
+        accepted = [reporter.accept('sidewall', self.key(), 1.0) for _ in range(10)]
+        self.assertEqual([True, False, False, False, True, False, False, False, True, False], accepted)
+        self.assertEqual(10, reporter.summary_totals[('sidewall', repr(self.key()))].count)
+
+        # the first item of every category is always kept
+        self.assertTrue(reporter.accept('overlap', self.key(), 1.0))
+
+    def test_sampled_rate_1(self):
+        reporter = ExtractionReporter(cell_name='Cell', dbu=0.001,
+                                      report_level=ReportLevel.SAMPLED, sampling_rate=1)
+        self.assertTrue(all(reporter.accept('sidewall', self.key(), 1.0) for _ in range(10)))
@@ -177,3 +177,71 @@ class CellExtractionResultsTest(unittest.TestCase):
         obtained_cap_value = summary.capacitances[NetCoupleKey('net1', 'net3').normed()]
         expected_cap_value = c2.cap_value
         self.assertEqual(expected_cap_value, obtained_cap_value)
+
+    def test_pb_roundtrip(self):
+        results = CellExtractionResults(cell_name='Cell')
+        ovk = OverlapKey(layer_top='m2', net_top='net2', layer_bot='m1', net_bot='net1')
+        swk = SidewallKey(layer='m1', net1='net1', net2='net3')
+        sok = SideOverlapKey(layer_inside='m2', net_inside='net2', layer_outside='m1', net_outside='net3')
+        for v in (1.0, 2.0):
+            results.add_overlap_cap(OverlapCap(key=ovk, cap_value=v,
+                                               shielded_area=0.0, unshielded_area=0.0, tech_spec=None))
+            results.add_sidewall_cap(SidewallCap(key=swk, cap_value=v,
+                                                 distance=0.0, length=0.0, tech_spec=None))
+            results.add_sideoverlap_cap(SideOverlapCap(key=sok, cap_value=v))
+
+        cell_result = results.cell_result_pb()
+        self.assertEqual('Cell', cell_result.c_result.cell_name)
+        self.assertEqual(1, len(cell_result.c_result.overlaps))
+        self.assertEqual(3.0, cell_result.c_result.overlaps[0].capacitance)
+        self.assertEqual(3, len(cell_result.c_result.net_couples))
+
+        restored = CellExtractionResults.from_pb(cell_result)
+        self.assertEqual(results.summarize(), restored.summarize())
+
+    def test_merge(self):
+        key = SidewallKey(layer='m1', net1='net1', net2='net2')
+        tile1 = CellExtractionResults(cell_name='Cell')
+        tile1.add_sidewall_cap(SidewallCap(key=key, cap_value=1.0, distance=0.0, length=0.0, tech_spec=None))
+        tile2 = CellExtractionResults(cell_name='Cell')
+        tile2.add_sidewall_cap(SidewallCap(key=key, cap_value=2.0, distance=0.0, length=0.0, tech_spec=None))
+
+        tile1.merge(tile2)
+        summary = tile1.summarize()
+        self.assertEqual(3.0, summary.capacitances[NetCoupleKey('net1', 'net2')])
+
+    def test_aggregate_modes_summarize_like_full(self):
+        def add_caps(results: CellExtractionResults):
+            ovk = OverlapKey(layer_top='m2', net_top='net2', layer_bot='m1', net_bot='net1')
+            swk = SidewallKey(layer='m1', net1='net3', net2='net1')
+            sok = SideOverlapKey(layer_inside='m2', net_inside='net2', layer_outside='m1', net_outside='net1')
+            for v in (1.0, 2.0, 4.0):
+                results.add_overlap_cap(OverlapCap(key=ovk, cap_value=v,
+                                                   shielded_area=0.0, unshielded_area=0.0, tech_spec=None))
+                results.add_sidewall_cap(SidewallCap(key=swk, cap_value=v,
+                                                     distance=0.0, length=0.0, tech_spec=None))
+                results.add_sideoverlap_cap(SideOverlapCap(key=sok, cap_value=v))
+
+        full = CellExtractionResults(cell_name='Cell')
+        add_caps(full)
+        expected = full.summarize()
+
+        for mode in (ResultMode.AGGREGATE, ResultMode.AGGREGATE_BY_LAYER):
+            aggregated = CellExtractionResults(cell_name='Cell', result_mode=mode)
+            add_caps(aggregated)
+            self.assertEqual(0, len(aggregated.overlap_table))
+            self.assertEqual(0, len(aggregated.sidewall_table))
+            self.assertEqual(0, len(aggregated.sideoverlap_table))
+            self.assertEqual(dict(expected.capacitances), dict(aggregated.summarize().capacitances))
+
+            restored = CellExtractionResults.from_pb(aggregated.cell_result_pb())
+            self.assertEqual(dict(expected.capacitances), dict(restored.summarize().capacitances))
+
+        by_layer = CellExtractionResults(cell_name='Cell', result_mode=ResultMode.AGGREGATE_BY_LAYER)
+        add_caps(by_layer)
+        total = by_layer.overlap_totals[OverlapKey(layer_top='m2', net_top='net2', layer_bot='m1', net_bot='net1')]
+        self.assertEqual(CapTotal(cap_value=7.0, count=3), total)
+
+        aggregated = CellExtractionResults(cell_name='Cell', result_mode=ResultMode.AGGREGATE)
+        add_caps(aggregated)
+        self.assertEqual(0, len(aggregated.overlap_totals))
@@ -0,0 +1,81 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+import allure
+import math
+import unittest
+
+from klayout_pex.rcx25.c.fringe_halo import *
+from klayout_pex.tech_info import TechInfo
+from tech_info_test_helpers import build_tech_info
+
+
+def stack_tech_info() -> TechInfo:
+    # stack (bottom to top): VSUBS, m1, m2
+    return build_tech_info(substrates={'m1': (40.0, 1.0), 'm2': (5.0, 1.0)},
+                           overlaps={('m2', 'm1'): 100.0},
+                           sideoverlaps={('m1', 'm2'): 1.0, ('m2', 'm1'): 1.0},
+                           side_halo=8.0)
+
+
+@allure.parent_suite("Unit Tests")
+class FringeHaloTest(unittest.TestCase):
+    def test_distance_is_inverse_of_fraction(self):
+        for alpha_c in (0.1, 0.8, 2.0):
+            for tolerance in (0.2, 0.05, 0.01):
+                d = fringe_halo_distance(alpha_c=alpha_c, tolerance=tolerance)
+                self.assertAlmostEqual(tolerance, fringe_fraction_beyond(alpha_c=alpha_c, distance_um=d))
+
+    def test_distance_edge_cases(self):
+        self.assertEqual(math.inf, fringe_halo_distance(alpha_c=1.0, tolerance=0.0))
+        self.assertEqual(0.0, fringe_halo_distance(alpha_c=1.0, tolerance=1.0))
+        self.assertEqual(1.0, fringe_fraction_beyond(alpha_c=1.0, distance_um=0.0))
+
+    def test_halo_per_layer(self):
+        halo = AdaptiveFringeHalo(all_layer_names=['VSUBS', 'm1', 'm2'],
+                                  tech_info=stack_tech_info(),
+                                  tolerance=0.1)
+
+        # no fringe from the substrate, keep the side halo
+        self.assertEqual(8.0, halo.halo_by_layer_index[0].halo_um)
+        self.assertEqual(0.0, halo.halo_by_layer_index[0].truncation_bound)
+
+        # m1: pairs m1/VSUBS (40) and m2/m1 (100), the weaker coupling saturates later
+        expected = fringe_halo_distance(alpha_c=40.0 * FRINGE_ALPHA_SCALE_FACTOR, tolerance=0.1)
+        self.assertAlmostEqual(expected, halo.halo_by_layer_index[1].halo_um)
+        self.assertAlmostEqual(0.1, halo.halo_by_layer_index[1].truncation_bound)
+
+        # m2: pair m2/VSUBS (5) would need more than the side halo, so the halo is capped
+        self.assertEqual(8.0, halo.halo_by_layer_index[2].halo_um)
+        self.assertGreater(halo.halo_by_layer_index[2].truncation_bound, 0.1)
+
+    def test_separate_fringe_pass(self):
+        # no smaller fringe halo
+        self.assertFalse(separate_fringe_pass(side_halo_um=8.0, fringe_halo_um=8.0,
+                                              inside_shape_count=10, child_shape_count=1000))
+        # sparse upper metal: the sidewall pass is cheap, the fringe pass saves
+        self.assertTrue(separate_fringe_pass(side_halo_um=8.0, fringe_halo_um=4.0,
+                                             inside_shape_count=100, child_shape_count=1000))
+        # dense lower layer: the additional sidewall pass costs more than the fringe pass saves
+        self.assertFalse(separate_fringe_pass(side_halo_um=8.0, fringe_halo_um=6.0,
+                                              inside_shape_count=400, child_shape_count=1000))
@@ -0,0 +1,160 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+import allure
+import math
+import time
+import unittest
+from types import SimpleNamespace
+
+import numpy as np
+import pytest
+
+from klayout_pex.rcx25.c.batch_kernels import FringeBatch
+from klayout_pex.rcx25.c.fringe_halo import FRINGE_ALPHA_SCALE_FACTOR, fringe_halo_distance
+from klayout_pex.rcx25.c.fringe_tables import *
+from klayout_pex.rcx25.extraction_results import CellExtractionResults, SideOverlapKey
+
+
+def make_table(alpha: float,
+               first_step_dbu: int,
+               samples_per_segment: int = 32,
+               side_halo: float = 8.0,
+               dbu: float = 0.001) -> CapacitanceInfo.FringeFractionTable:
+    # same sample layout as written by gen_tech_pb (see cxx/gen_tech_pb/fringe_tables.cpp)
+    end_dbu = side_halo / dbu + 1.0
+    t = CapacitanceInfo.FringeFractionTable(top_layer_name='m2', bottom_layer_name='m1',
+                                            alpha=alpha, dbu=dbu,
+                                            first_step_dbu=first_step_dbu,
+                                            samples_per_segment=samples_per_segment)
+    start = 0
+    step = first_step_dbu
+    while start <= end_dbu:
+        for i in range(samples_per_segment):
+            t.fractions.append(fringe_fraction(alpha, (start + i * step) * dbu))
+        start += samples_per_segment * step
+        step *= 2
+    t.fractions.append(fringe_fraction(alpha, start * dbu))
+    return t
+
+
+def overlap_spec(capacitance: float) -> CapacitanceInfo.OverlapCapacitance:
+    return CapacitanceInfo.OverlapCapacitance(top_layer_name='m2', bottom_layer_name='m1',
+                                              capacitance=capacitance)
+
+
+@allure.parent_suite("Unit Tests")
+@allure.tag("Capacitance", "Fringe")
+class FringeTablesTest(unittest.TestCase):
+    def test_exact_at_samples(self):
+        table = FringeFractionTable(make_table(alpha=0.8, first_step_dbu=21))
+        np.testing.assert_array_equal(table.sample_fractions, table.fractions_of(table.sample_distances_dbu))
+
+    def test_interpolation_error(self):
+        # layouts chosen by gen_tech_pb (tolerance 1e-4)
+        for alpha, first_step_dbu, samples_per_segment in ((0.0647, 680, 16), (0.5107, 43, 32), (2.6772, 8, 32)):
+            table = FringeFractionTable(make_table(alpha=alpha, first_step_dbu=first_step_dbu,
+                                                   samples_per_segment=samples_per_segment))
+            distances = np.arange(0, 8002, 3, dtype=np.float64)
+            expected = (2.0 / math.pi) * np.arctan(alpha * distances * 0.001)
+            vectorized = table.fractions_of(distances)
+            self.assertLess(np.max(np.abs(vectorized - expected)), 1e-4)
+
+    def test_beyond_table_uses_formula(self):
+        table = FringeFractionTable(make_table(alpha=0.8, first_step_dbu=21))
+        d = table.end_dbu + 1000.0
+        f = table.fractions_of(np.array([0.0, d]))
+        self.assertEqual(fringe_fraction(0.8, d * 0.001), f[1])
+        self.assertEqual(0.0, f[0])
+
+    def test_distance_is_inverse_of_fraction(self):
+        table = FringeFractionTable(make_table(alpha=0.8, first_step_dbu=21))
+        for d in (0.0, 13.0, 250.0, 4000.0, 7999.0):
+            f = table.fractions_of(np.array([d]))[0]
+            self.assertAlmostEqual(d, table.distance_for_fraction(f), delta=1e-6)
+        for tolerance in (0.2, 0.1, 0.05):
+            self.assertAlmostEqual(fringe_halo_distance(alpha_c=0.8, tolerance=tolerance),
+                                   table.halo_distance_um(tolerance=tolerance), delta=1e-3)
+
+    def test_tables_require_same_dbu(self):
+        tech_info = SimpleNamespace(fringe_fraction_table_by_layer_names={
+            ('m2', 'm1'): make_table(alpha=0.8, first_step_dbu=21)
+        })
+        self.assertIsNotNone(FringeFractionTables(tech_info=tech_info, dbu=0.001).table(overlap_spec(40.0)))
+        self.assertIsNone(FringeFractionTables(tech_info=tech_info, dbu=0.005).table(overlap_spec(40.0)))
+        self.assertIsNone(FringeFractionTables(tech_info=SimpleNamespace(fringe_fraction_table_by_layer_names={}),
+                                               dbu=0.001).table(overlap_spec(40.0)))
+
+    def test_fringe_batch_with_tables(self):
+        ovl = overlap_spec(40.0)
+        sovl = SimpleNamespace(capacitance=41.0)
+        alpha = 40.0 * FRINGE_ALPHA_SCALE_FACTOR
+        tech_info = SimpleNamespace(fringe_fraction_table_by_layer_names={
+            ('m2', 'm1'): make_table(alpha=alpha, first_step_dbu=43)
+        })
+        tables = FringeFractionTables(tech_info=tech_info, dbu=0.001)
+
+        key = SideOverlapKey(layer_inside='m2', net_inside='A', layer_outside='m1', net_outside='B')
+        sums = []
+        for fringe_tables in (None, tables):
+            batch = FringeBatch(side_halo=8.0, scale_ratio_to_fit_halo=True, fringe_tables=fringe_tables)
+            for length, near, far in ((2.0, 0.0, 0.5), (1.5, 0.2, 3.0), (0.8, 0.1, 8.001)):
+                batch.add(inside_layer_name='m2', outside_layer_name='m1',
+                          overlap_cap_spec=ovl, sideoverlap_cap_spec=sovl,
+                          key=key, length_um=length, distance_near_um=near, distance_far_um=far)
+            results = CellExtractionResults(cell_name='Cell')
+            batch.flush(results)
+            sums.append(results.sideoverlap_cap_sums()[key])
+        self.assertAlmostEqual(sums[0], sums[1], delta=sums[0] * 1e-3)
+
+    @pytest.mark.slow
+    def test_benchmark_stack_against_formula(self):
+        # layouts chosen by gen_tech_pb (tolerance 1e-4), see test_interpolation_error
+        layouts = ((0.0647, 680, 16), (0.5107, 43, 32), (2.6772, 8, 32))
+        tables = [FringeFractionTable(make_table(alpha=alpha, first_step_dbu=first_step_dbu,
+                                                 samples_per_segment=samples_per_segment))
+                  for alpha, first_step_dbu, samples_per_segment in layouts]
+        alpha_c = np.array([alpha for alpha, _, _ in layouts])
+        stack = FringeFractionTableStack(tables=tables, alpha_c=alpha_c)
+
+        rng = np.random.default_rng(seed=1)
+        record_count = 1_000_000
+        pairs = rng.integers(0, len(tables), record_count)
+        distance_um = rng.uniform(0.0, 8.0, record_count)
+
+        def best_of(rounds: int, f: Callable[[], np.ndarray]) -> Tuple[float, np.ndarray]:
+            durations = []
+            for _ in range(rounds):
+                start = time.perf_counter()
+                result = f()
+                durations.append(time.perf_counter() - start)
+            return min(durations), result
+
+        formula_s, expected = best_of(5, lambda: (2.0 / math.pi) * np.arctan(alpha_c[pairs] * distance_um))
+        stack_s, tabulated = best_of(5, lambda: stack.fractions_of(pairs, distance_um))
+
+        report = (f"{record_count} records, {len(tables)} layer pairs:\n"
+                  f"  formula (np.arctan): {formula_s * 1000.0:.1f} ms\n"
+                  f"  table stack:         {stack_s * 1000.0:.1f} ms\n")
+        allure.attach(report, name='fringe_tables_benchmark.txt', attachment_type=allure.attachment_type.TEXT)
+        self.assertLess(np.max(np.abs(tabulated - expected)), 1e-4)
@@ -0,0 +1,135 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+import allure
+import math
+import unittest
+
+from klayout_pex.rcx25.c.cap_formulas import fringe_cap_femto, sidewall_cap_femto
+from klayout_pex.rcx25.c.fringe_halo import fringe_alpha
+from klayout_pex.rcx25.c.geometric_moments import GeometricMoments, evaluate_moments
+from klayout_pex.rcx25.extraction_results import *
+from klayout_pex.tech_info import TechInfo
+from tech_info_test_helpers import build_tech_info
+
+
+def scaled_tech_info(scale: float = 1.0) -> TechInfo:
+    return build_tech_info(overlaps={('m2', 'm1'): 40.0 * scale},
+                           sidewalls={'m1': (50.0 * scale, 0.1)},
+                           sideoverlaps={('m1', 'm2'): 30.0 * scale})
+
+
+def record_moments() -> GeometricMoments:
+    m = GeometricMoments(scale_ratio_to_fit_halo=True)
+    m.add_overlap(OverlapKey(layer_top='m2', net_top='A', layer_bot='m1', net_bot='B'), 2.0)
+    m.add_overlap(OverlapKey(layer_top='m2', net_top='A', layer_bot='m1', net_bot='B'), 0.5)
+    swk = SidewallKey(layer='m1', net1='A', net2='B')
+    m.add_sidewall(swk, length_um=1.0, distance_um=0.2)
+    m.add_sidewall(swk, length_um=3.0, distance_um=0.2)
+    m.add_sidewall(swk, length_um=2.0, distance_um=0.4)
+    sok = SideOverlapKey(layer_inside='m1', net_inside='A', layer_outside='m2', net_outside='B')
+    m.add_fringe(sok, length_um=1.0, distance_near_um=0.0, distance_far_um=0.5, halo_um=8.0)
+    m.add_fringe(sok, length_um=1.0, distance_near_um=0.0, distance_far_um=0.5, halo_um=8.0)
+    m.add_fringe(sok, length_um=0.001, distance_near_um=7.0, distance_far_um=7.5, halo_um=8.0)  # below threshold
+    return m
+
+
+@allure.parent_suite("Unit Tests")
+class GeometricMomentsTest(unittest.TestCase):
+    def test_recording_compresses(self):
+        m = record_moments()
+        self.assertEqual({0.2: 4.0, 0.4: 2.0}, dict(m.sidewall_lengths[SidewallKey('m1', 'A', 'B')]))
+        spans = m.fringe_spans[SideOverlapKey('m1', 'A', 'm2', 'B')]
+        self.assertEqual(2, spans[(1.0, 0.0, 0.5)])
+        self.assertEqual({'m1': 8.0}, m.fringe_halo_by_layer)
+
+    def test_evaluate_matches_direct_formulas(self):
+        tech_info = scaled_tech_info()
+        results = CellExtractionResults(cell_name='Cell')
+        record_moments().evaluate(tech_info=tech_info, results=results)
+
+        overlap = results.overlap_cap_sums()[OverlapKey('m2', 'A', 'm1', 'B')]
+        self.assertAlmostEqual(2.5 * 40.0 / 1000.0, overlap)
+
+        swspec = tech_info.sidewall_cap_by_layer_name['m1']
+        expected_sidewall = sidewall_cap_femto(4.0, 0.2, swspec) + sidewall_cap_femto(2.0, 0.4, swspec)
+        self.assertAlmostEqual(expected_sidewall, results.sidewall_cap_sums()[SidewallKey('m1', 'A', 'B')])
+
+        alpha_c = fringe_alpha(tech_info.overlap_cap_by_layer_names['m2']['m1'])
+        soc_spec = tech_info.side_overlap_cap_by_layer_names['m1']['m2']
+        expected_fringe = 2 * fringe_cap_femto(1.0, 0.0, 0.5, alpha_c, soc_spec, 8.0)
+        sok = SideOverlapKey('m1', 'A', 'm2', 'B')
+        self.assertAlmostEqual(expected_fringe, results.sideoverlap_cap_sums()[sok])
+        # the tiny far away span stays below the threshold
+        self.assertEqual(1, len(results.sideoverlap_table[sok]))
+
+    def test_scaled_coefficients(self):
+        nominal = CellExtractionResults(cell_name='Cell')
+        record_moments().evaluate(tech_info=scaled_tech_info(), results=nominal)
+        scaled = CellExtractionResults(cell_name='Cell')
+        record_moments().evaluate(tech_info=scaled_tech_info(scale=1.1), results=scaled)
+
+        key = NetCoupleKey('A', 'B')
+        overlap_key = OverlapKey('m2', 'A', 'm1', 'B')
+        self.assertAlmostEqual(nominal.overlap_cap_sums()[overlap_key] * 1.1,
+                               scaled.overlap_cap_sums()[overlap_key])
+        self.assertGreater(scaled.summarize().capacitances[key], nominal.summarize().capacitances[key])
+
+    def test_merge(self):
+        m = record_moments()
+        m.merge(record_moments())
+        self.assertEqual(5.0, m.overlap_areas[OverlapKey('m2', 'A', 'm1', 'B')])
+        self.assertEqual(8.0, m.sidewall_lengths[SidewallKey('m1', 'A', 'B')][0.2])
+        self.assertEqual(4, m.fringe_spans[SideOverlapKey('m1', 'A', 'm2', 'B')][(1.0, 0.0, 0.5)])
+
+    def test_evaluate_moments_requires_moments(self):
+        nominal = ExtractionResults()
+        nominal.cell_extraction_results['Cell'] = CellExtractionResults(cell_name='Cell')
+        with self.assertRaises(ValueError):
+            evaluate_moments(nominal_results=nominal, tech_info=scaled_tech_info())
+
+    def test_pb_roundtrip(self):
+        m = record_moments()
+        cell_results = CellExtractionResults(cell_name='Cell', moments=m)
+        m.evaluate(tech_info=scaled_tech_info(), results=cell_results)
+
+        obtained = CellExtractionResults.from_pb(cell_results.cell_result_pb()).moments
+        self.assertIsNotNone(obtained)
+        self.assertEqual(m.scale_ratio_to_fit_halo, obtained.scale_ratio_to_fit_halo)
+        self.assertEqual(dict(m.overlap_areas), dict(obtained.overlap_areas))
+        self.assertEqual({k: dict(v) for k, v in m.sidewall_lengths.items()},
+                         {k: dict(v) for k, v in obtained.sidewall_lengths.items()})
+        self.assertEqual({k: dict(v) for k, v in m.fringe_spans.items()},
+                         {k: dict(v) for k, v in obtained.fringe_spans.items()})
+        self.assertEqual(m.fringe_halo_by_layer, obtained.fringe_halo_by_layer)
+
+        # re-evaluation from the stored moments reproduces the capacitances
+        re_evaluated = CellExtractionResults(cell_name='Cell')
+        obtained.evaluate(tech_info=scaled_tech_info(), results=re_evaluated)
+        self.assertEqual(dict(cell_results.summarize().capacitances),
+                         dict(re_evaluated.summarize().capacitances))
+
+    def test_pb_without_moments(self):
+        cell_results = CellExtractionResults(cell_name='Cell')
+        self.assertFalse(cell_results.c_result_pb().HasField('moments'))
+        self.assertIsNone(CellExtractionResults.from_pb(cell_results.cell_result_pb()).moments)
@@ -0,0 +1,64 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+import allure
+import unittest
+
+from klayout_pex.rcx25.c.interval_shield import IntervalSet
+
+
+@allure.parent_suite("Unit Tests")
+class IntervalSetTest(unittest.TestCase):
+    def test_add_merges_overlapping_and_touching(self):
+        s = IntervalSet()
+        s.add(10, 20)
+        s.add(30, 40)
+        self.assertEqual([(10, 20), (30, 40)], s.intervals())
+        s.add(20, 25)  # touching
+        self.assertEqual([(10, 25), (30, 40)], s.intervals())
+        s.add(0, 5)
+        s.add(22, 31)  # bridges two intervals
+        self.assertEqual([(0, 5), (10, 40)], s.intervals())
+        s.add(7, 7)  # empty
+        self.assertEqual(2, len(s))
+
+    def test_subtract_from(self):
+        s = IntervalSet()
+        self.assertEqual([(0, 100)], s.subtract_from(0, 100))
+
+        s.add(10, 20)
+        s.add(40, 60)
+        self.assertEqual([(0, 10), (20, 40), (60, 100)], s.subtract_from(0, 100))
+        self.assertEqual([(20, 40)], s.subtract_from(15, 50))
+        self.assertEqual([], s.subtract_from(42, 58))
+        self.assertEqual([(60, 70)], s.subtract_from(50, 70))
+
+    def test_update_and_copy(self):
+        a = IntervalSet()
+        a.add(0, 10)
+        b = a.copy()
+        other = IntervalSet()
+        other.add(5, 20)
+        b.update(other)
+        self.assertEqual([(0, 10)], a.intervals())
+        self.assertEqual([(0, 20)], b.intervals())
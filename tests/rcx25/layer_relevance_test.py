@@ -0,0 +1,85 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+import allure
+import unittest
+
+from klayout_pex.rcx25.c.layer_relevance import LayerRelevance
+from tech_info_test_helpers import build_tech_info
+
+
+# stack (bottom to top): VSUBS, poly, m1, m2, m3
+# m3 only overlaps m2, and there is no spec at all for m2 -> VSUBS
+LAYER_NAMES = ['VSUBS', 'poly', 'm1', 'm2', 'm3']
+SUBSTRATES = {'poly': (1.0, 1.0), 'm1': (1.0, 1.0)}
+OVERLAPS = {('m1', 'poly'): 1.0, ('m2', 'poly'): 1.0, ('m2', 'm1'): 1.0, ('m3', 'm2'): 1.0}
+SIDEWALLS = {'poly': (1.0, 0.0), 'm1': (1.0, 0.0), 'm2': (1.0, 0.0), 'm3': (1.0, 0.0)}
+SIDEOVERLAPS = {('poly', 'm1'): 1.0, ('m1', 'poly'): 1.0, ('m1', 'm2'): 1.0,
+                ('m3', 'm2'): 1.0, ('m3', 'm1'): 1.0}  # m3/m1 has no overlap spec, so no fringe
+
+
+def layer_relevance(substrates: dict = None,
+                    overlaps: dict = None,
+                    sideoverlaps: dict = None) -> LayerRelevance:
+    tech_info = build_tech_info(substrates={**SUBSTRATES, **(substrates or {})},
+                                overlaps={**OVERLAPS, **(overlaps or {})},
+                                sidewalls=SIDEWALLS,
+                                sideoverlaps={**SIDEOVERLAPS, **(sideoverlaps or {})})
+    return LayerRelevance(all_layer_names=LAYER_NAMES, tech_info=tech_info)
+
+
+@allure.parent_suite("Unit Tests")
+class LayerRelevanceTest(unittest.TestCase):
+    def setUp(self):
+        self.relevance = layer_relevance()
+
+    def test_overlap_layers(self):
+        ovl = self.relevance.overlap_layer_indices
+        self.assertEqual([1, 2], ovl[0])      # m2/m3 have no spec above VSUBS
+        self.assertEqual([2, 3], ovl[1])
+        self.assertEqual([3], ovl[2])         # m3 has no spec for m1
+        self.assertEqual([4], ovl[3])
+        self.assertEqual([], ovl[4])
+
+    def test_overlap_keeps_terminating_layers(self):
+        relevance = layer_relevance(substrates={'m3': (1.0, 0.0)})
+        # m2 has no spec for VSUBS, but stops the search (other net polygon)
+        self.assertEqual([1, 2, 3, 4], relevance.overlap_layer_indices[0])
+
+    def test_fringe_and_shield_layers(self):
+        self.assertEqual([0, 2], self.relevance.fringe_layer_indices[1])
+        self.assertEqual([0, 1, 3], self.relevance.fringe_layer_indices[2])
+        self.assertEqual([3], self.relevance.fringe_layer_indices[4])
+
+        self.assertEqual([0, 2], self.relevance.fringe_shield_layer_indices[1])
+        self.assertEqual([0, 1, 3], self.relevance.fringe_shield_layer_indices[2])
+        self.assertEqual([3], self.relevance.fringe_shield_layer_indices[4])
+
+    def test_shields_between_inside_and_fringe_layer(self):
+        relevance = layer_relevance(overlaps={('m3', 'poly'): 1.0}, sideoverlaps={('m3', 'poly'): 1.0})
+        self.assertEqual([1, 3], relevance.fringe_layer_indices[4])
+        self.assertEqual([1, 2, 3], relevance.fringe_shield_layer_indices[4])
+
+    def test_edge_pass(self):
+        self.assertFalse(self.relevance.needs_edge_pass(0))  # substrate
+        self.assertTrue(self.relevance.needs_edge_pass(3))   # m2 has only sidewall
@@ -0,0 +1,139 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+import allure
+import random
+import unittest
+from collections import defaultdict
+
+from klayout_pex.rcx25.c.overlap_sweep import OverlapSweep
+
+# stack: 0 VSUBS, 1 m1, 2 m2, 3 capm (no overlap specs at all), 4 m3
+VSUBS, M1, M2, CAPM, M3 = range(5)
+
+
+def brute_force_areas(boxes, layer_count, has_overlap_spec, bottom_net_override):
+    # NOTE: same semantics as OverlapSweep, evaluated per unit cell
+    stop_by_polygon = {}
+    area_by_pair = defaultdict(int)
+    for x in range(min(b[0] for b in boxes), max(b[2] for b in boxes)):
+        for y in range(min(b[1] for b in boxes), max(b[3] for b in boxes)):
+            stack = sorted((b for b in boxes if b[0] <= x < b[2] and b[1] <= y < b[3]),
+                           key=lambda b: (b[4], b[6]))
+            for i, bottom in enumerate(stack):
+                net_bot = bottom_net_override.get(bottom[4], bottom[5])
+                for top in stack[i + 1:]:
+                    if top[4] == bottom[4] or top[5] == net_bot:
+                        continue
+                    if not has_overlap_spec(top[4], bottom[4]):
+                        stop_by_polygon[bottom[6]] = min(stop_by_polygon.get(bottom[6], layer_count), top[4])
+                        break
+                    area_by_pair[(bottom[6], top[6])] += 1
+                    break
+    areas = defaultdict(int)
+    info = {b[6]: (b[4], b[5]) for b in boxes}
+    for (bottom_id, top_id), area in area_by_pair.items():
+        if info[top_id][0] < stop_by_polygon.get(bottom_id, layer_count):
+            bot_layer, net_bot = info[bottom_id]
+            areas[(info[top_id][0], info[top_id][1], bot_layer, bottom_net_override.get(bot_layer, net_bot))] += area
+    return dict(areas)
+
+
+def build_sweep() -> OverlapSweep:
+    sweep = OverlapSweep(layer_count=5,
+                         has_overlap_spec=lambda top, bot: CAPM not in (top, bot))
+    sweep.add_box(0, 0, 100, 100, VSUBS, None, 0)
+    sweep.add_box(10, 10, 50, 50, M1, 'A', 1)
+    sweep.add_box(30, 30, 70, 70, M2, 'B', 2)
+    sweep.add_box(0, 0, 100, 100, M3, 'C', 3)
+    return sweep
+
+
+@allure.parent_suite("Unit Tests")
+class OverlapSweepTest(unittest.TestCase):
+    def test_shielding(self):
+        areas = build_sweep().overlap_areas(bottom_net_override={VSUBS: 'VSUBS'})
+        self.assertEqual({
+            (M1, 'A', VSUBS, 'VSUBS'): 1600,
+            (M2, 'B', VSUBS, 'VSUBS'): 1600 - 400,
+            (M3, 'C', VSUBS, 'VSUBS'): 10000 - 2800,
+            (M2, 'B', M1, 'A'): 400,
+            (M3, 'C', M1, 'A'): 1600 - 400,
+            (M3, 'C', M2, 'B'): 1600,
+        }, dict(areas))
+
+    def test_same_net_does_not_shield(self):
+        sweep = build_sweep()
+        sweep.add_box(10, 10, 50, 50, M2, 'A', 4)  # same net as m1 below
+        areas = sweep.overlap_areas(bottom_net_override={VSUBS: 'VSUBS'})
+        self.assertEqual(400, areas[(M2, 'B', M1, 'A')])
+        self.assertEqual(1200, areas[(M3, 'C', M1, 'A')])
+
+    def test_layer_without_spec_stops_whole_polygon(self):
+        sweep = build_sweep()
+        sweep.add_box(12, 12, 18, 18, CAPM, 'D', 4)  # above m1 'A', not above m2 'B'
+        areas = sweep.overlap_areas(bottom_net_override={VSUBS: 'VSUBS'})
+        # layers below capm are still counted
+        self.assertEqual(400, areas[(M2, 'B', M1, 'A')])
+        self.assertEqual(1600, areas[(M1, 'A', VSUBS, 'VSUBS')])
+        # layers above capm are dropped for the complete bottom polygons below capm
+        self.assertNotIn((M3, 'C', M1, 'A'), areas)
+        self.assertNotIn((M3, 'C', VSUBS, 'VSUBS'), areas)
+        # m2 'B' is not below capm
+        self.assertEqual(1600, areas[(M3, 'C', M2, 'B')])
+
+    def test_pairs(self):
+        overlaps = build_sweep().sweep(bottom_net_override={VSUBS: 'VSUBS'}, collect_cells=True)
+        self.assertEqual({(0, 1), (0, 2), (0, 3), (1, 2), (1, 3), (2, 3)}, set(overlaps.keys()))
+        self.assertEqual(400, overlaps[(1, 2)].area)
+        self.assertEqual(400, sum((x2 - x1) * (y2 - y1) for x1, y1, x2, y2 in overlaps[(1, 2)].cells))
+        for x1, y1, x2, y2 in overlaps[(1, 2)].cells:
+            self.assertTrue(30 <= x1 < x2 <= 50 and 30 <= y1 < y2 <= 50)
+
+    def test_top_only(self):
+        sweep = OverlapSweep(layer_count=5, has_overlap_spec=lambda top, bot: CAPM not in (top, bot))
+        sweep.add_box(0, 0, 100, 100, VSUBS, None, 0)
+        sweep.add_box(10, 10, 50, 50, M1, 'A', 1, top_only=True)
+        sweep.add_box(0, 0, 100, 100, M3, 'C', 2)
+        overlaps = sweep.sweep(bottom_net_override={VSUBS: 'VSUBS'})
+        # m1 still shields the substrate, but is not a bottom polygon itself
+        self.assertEqual({(0, 1): 1600, (0, 2): 10000 - 1600},
+                         {pair: o.area for pair, o in overlaps.items()})
+
+    def test_random_against_brute_force(self):
+        def has_overlap_spec(top: int, bot: int) -> bool:
+            return CAPM not in (top, bot)
+
+        for seed in range(30):
+            rnd = random.Random(seed)
+            boxes = []
+            for polygon_id in range(rnd.randrange(1, 15)):
+                x, y = rnd.randrange(30), rnd.randrange(30)
+                boxes.append((x, y, x + rnd.randrange(1, 15), y + rnd.randrange(1, 15),
+                              rnd.randrange(5), f"n{rnd.randrange(3)}", polygon_id))
+            sweep = OverlapSweep(layer_count=5, has_overlap_spec=has_overlap_spec)
+            for b in boxes:
+                sweep.add_box(*b)
+            areas = {k: a for k, a in sweep.overlap_areas(bottom_net_override={VSUBS: 'VSUBS'}).items() if a}
+            expected = brute_force_areas(boxes, 5, has_overlap_spec, {VSUBS: 'VSUBS'})
+            self.assertEqual(expected, areas, f"seed {seed}")
@@ -0,0 +1,102 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+import allure
+import unittest
+
+from klayout_pex.rcx25.extraction_results import *
+from klayout_pex.rcx25.r.packed_r_network import pack_r_network, unpack_r_network
+
+import klayout_pex_protobuf.kpex.layout.location_pb2 as location_pb2
+import klayout_pex_protobuf.kpex.r.r_network_pb2 as r_network_pb2
+
+
+def build_network() -> r_network_pb2.RNetwork:
+    network = r_network_pb2.RNetwork()
+    network.net_name = 'VDD'
+
+    pin = network.nodes.add()
+    pin.node_id = 100
+    pin.node_name = 'VDD'
+    pin.net_name = 'VDD'
+    pin.node_kind = r_network_pb2.RNode.Kind.KIND_PIN
+    pin.layer_name = 'met1'
+    pin.location.kind = location_pb2.Location.Kind.LOCATION_KIND_POINT
+    pin.location.point.x = 10
+    pin.location.point.y = 20
+    pin.location.point.net = 'VDD'
+
+    for node_id, name in ((200, 'V1'), (300, 'W2')):
+        n = network.nodes.add()
+        n.node_id = node_id
+        n.node_name = name
+        n.net_name = f"VDD.{name}"
+        n.node_kind = r_network_pb2.RNode.Kind.KIND_WIRE_JUNCTION
+        n.layer_name = 'met1'
+        n.location.kind = location_pb2.Location.Kind.LOCATION_KIND_BOX
+        n.location.box.lower_left.x = node_id
+        n.location.box.lower_left.y = 0
+        n.location.box.upper_right.x = node_id + 50
+        n.location.box.upper_right.y = 30
+        n.location.box.net = n.net_name
+
+    for element_id, (a, b, r) in enumerate(((100, 200, 1.5), (200, 300, 2.0), (100, 300, 4.0))):
+        e = network.elements.add()
+        e.element_id = element_id
+        e.node_a.node_id = a
+        e.node_b.node_id = b
+        e.resistance = r
+
+    return network
+
+
+@allure.parent_suite("Unit Tests")
+class PackedRNetworkTest(unittest.TestCase):
+    def test_pack_unpack_roundtrip(self):
+        network = build_network()
+        packed = r_network_pb2.PackedRNetwork()
+        pack_r_network(network, packed)
+
+        self.assertEqual(3, len(packed.node_ids))
+        self.assertEqual(3, len(packed.element_resistances))
+        self.assertEqual('', packed.string_table[0])
+        # met1 is interned only once
+        self.assertEqual(1, list(packed.string_table).count('met1'))
+
+        obtained = r_network_pb2.RNetwork()
+        unpack_r_network(packed, obtained)
+        self.assertEqual(network, obtained)
+
+    def test_summarize_packed_equals_messages(self):
+        network = build_network()
+
+        message_results = CellExtractionResults(cell_name='Cell')
+        message_results.r_extraction_result.networks.add().CopyFrom(network)
+
+        packed_results = CellExtractionResults(cell_name='Cell')
+        pack_r_network(network, packed_results.r_extraction_result.packed_networks.add())
+
+        expected = message_results.summarize().resistances
+        obtained = packed_results.summarize().resistances
+        self.assertEqual(dict(expected), dict(obtained))
+        self.assertEqual(1.5, obtained[NetCoupleKey('VDD', 'VDD.V1').normed()])
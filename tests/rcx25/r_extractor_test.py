@@ -0,0 +1,128 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+import allure
+from types import SimpleNamespace
+import unittest
+
+from klayout_pex.klayout.lvsdb_extractor import KLayoutExtractedLayerInfo, KLayoutMergedExtractedLayerInfo
+from klayout_pex.rcx25.r.r_extractor import RExtractor
+from klayout_pex.tech_info import TechInfo
+
+from klayout_pex_protobuf.kpex.klayout.r_extractor_tech_pb2 import RExtractorTech as pb_RExtractorTech
+import klayout_pex_protobuf.kpex.tech.process_stack_pb2 as process_stack_pb2
+import klayout_pex_protobuf.kpex.tech.tech_pb2 as tech_pb2
+
+LP = tech_pb2.LayerInfo.Purpose
+
+
+def build_tech(precomputed: bool) -> tech_pb2.Technology:
+    tech = tech_pb2.Technology(name='test')
+    for name, purpose, gds_pair in (('m1', LP.PURPOSE_METAL, (10, 20)),
+                                    ('via1', LP.PURPOSE_VIA, (11, 44)),
+                                    ('m2', LP.PURPOSE_METAL, (12, 20)),
+                                    ('m2_pin', LP.PURPOSE_METAL, (12, 16))):
+        cl = tech.lvs_computed_layers.add()
+        cl.kind = tech_pb2.ComputedLayerInfo.Kind.KIND_PIN if name.endswith('_pin') \
+            else tech_pb2.ComputedLayerInfo.Kind.KIND_REGULAR
+        cl.layer_info.name = name
+        cl.layer_info.purpose = purpose
+        cl.layer_info.drw_gds_pair.layer, cl.layer_info.drw_gds_pair.datatype = gds_pair
+        cl.original_layer_name = name.removesuffix('_pin')
+
+    m1 = tech.process_stack.layers.add(name='m1',
+                                       layer_type=process_stack_pb2.ProcessStackInfo.LAYER_TYPE_METAL)
+    m1.metal_layer.contact_above.name = 'via1'
+    m1.metal_layer.contact_above.layer_below = 'm1'
+    m1.metal_layer.contact_above.metal_above = 'm2'
+    m1.metal_layer.contact_above.width = 0.2
+
+    ri = tech.process_parasitics.resistance
+    ri.layers.add(layer_name='m1', resistance=125.0)
+    ri.layers.add(layer_name='m2', resistance=100.0)
+    ri.vias.add(via_name='via1', resistance=4500.0)
+
+    if precomputed:
+        # what gen_tech_pb would emit
+        rex = ri.r_extractor_tech
+        for name, r in (('m1', 0.125), ('m2', 0.1)):
+            c = rex.conductors.add(resistance=r)
+            c.layer.canonical_layer_name = c.layer.lvs_layer_name = name
+        v = rex.vias.add(resistance=4500.0 / 1000.0 * 0.2 ** 2)
+        v.layer.canonical_layer_name = v.layer.lvs_layer_name = 'via1'
+        v.bottom_conductor.canonical_layer_name = v.bottom_conductor.lvs_layer_name = 'm1'
+        v.top_conductor.canonical_layer_name = v.top_conductor.lvs_layer_name = 'm2'
+    return tech
+
+
+class FakeLayout:
+    def layer(self, layer: int, datatype: int) -> int:
+        return layer * 100 + datatype
+
+
+def prepare(tech_info: TechInfo) -> pb_RExtractorTech:
+    extracted_layers = {}
+    for idx, cl in enumerate(tech_info.tech.lvs_computed_layers):
+        gds_pair = (cl.layer_info.drw_gds_pair.layer, cl.layer_info.drw_gds_pair.datatype)
+        extracted_layers[gds_pair] = KLayoutMergedExtractedLayerInfo(
+            source_layers=[KLayoutExtractedLayerInfo(index=idx, lvs_layer_name=cl.layer_info.name,
+                                                     gds_pair=gds_pair, region=None)],
+            gds_pair=gds_pair
+        )
+
+    # NOTE: prepare_r_extractor_tech_pb only needs the tech and layer index mapping
+    rex = object.__new__(RExtractor)
+    rex.pex_context = SimpleNamespace(tech=tech_info, extracted_layers=extracted_layers,
+                                      annotated_layout=FakeLayout())
+    rex.substrate_algorithm = pb_RExtractorTech.Algorithm.ALGORITHM_TESSELATION
+    rex.wire_algorithm = pb_RExtractorTech.Algorithm.ALGORITHM_SQUARE_COUNTING
+    rex.delaunay_b = 0.5
+    rex.delaunay_amax = 0.1
+    rex.via_merge_distance = 0.2
+    rex.skip_simplify = True
+
+    rex_tech = pb_RExtractorTech()
+    rex.prepare_r_extractor_tech_pb(rex_tech=rex_tech)
+    return rex_tech
+
+
+@allure.parent_suite("Unit Tests")
+@allure.tag("R", "RExtractorTech")
+class Test(unittest.TestCase):
+    def test_precomputed_tech_matches_fallback(self):
+        fallback = prepare(TechInfo(tech=build_tech(precomputed=False), dielectric_filter=None))
+        bound = prepare(TechInfo(tech=build_tech(precomputed=True), dielectric_filter=None))
+
+        self.assertEqual(2, len(bound.conductors))
+        self.assertEqual(1, len(bound.vias))
+        via = bound.vias[0]
+        self.assertEqual((1144, 1020, 1220), (via.layer.id, via.bottom_conductor.id, via.top_conductor.id))
+        self.assertAlmostEqual(0.18, via.resistance)
+
+        # the precomputed entries only add names to the via conductor references
+        for v in bound.vias:
+            v.bottom_conductor.ClearField('canonical_layer_name')
+            v.bottom_conductor.ClearField('lvs_layer_name')
+            v.top_conductor.ClearField('canonical_layer_name')
+            v.top_conductor.ClearField('lvs_layer_name')
+        self.assertEqual(fallback, bound)
@@ -0,0 +1,148 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+from __future__ import annotations
+
+import os
+from typing import *
+
+import allure
+import pytest
+
+from klayout_pex.cross_sections.cross_sections_cli import CrossSectionsCLI
+from klayout_pex.cross_sections.table_generator import CrossSectionTableGenerator
+from klayout_pex.kpex_cli import KpexCLI
+from klayout_pex.pdk_config import PDK
+from klayout_pex.rcx25.c.cross_section_tables import CrossSectionTables
+from klayout_pex.rcx25.extraction_results import CellExtractionResults
+from klayout_pex.tech_info import TechInfo
+
+
+parent_suite = "kpex/2.5D Extraction Tests"
+tags = ("PEX", "2.5D", "Cross-Section Tables")
+
+# NOTE: geometry of sidewall_20um_length_distance_200nm_li1.gds.gz,
+#       two parallel li1 wires without planes above or below
+PATTERN_LENGTH_UM = 20.0
+PATTERN_WIDTH_UM = 1.0
+PATTERN_SPACING_UM = 0.2
+
+# NOTE: resolution 3 keeps the test fast, the solve is ~2.4% above resolution 12,
+#       but table and reference share the same discretization
+SOLVER_RESOLUTION = 3.0
+
+
+def _gds(*path_components) -> str:
+    return os.path.realpath(os.path.join(__file__, '..', '..', '..',
+                                         'testdata', 'designs', 'sky130A', *path_components))
+
+
+@pytest.fixture
+def sky130a_tech_with_cross_section_tables(monkeypatch, tmp_path) -> str:
+    """
+    sky130A technology with (coarse) cross-section tables for li1,
+    used instead of the default technology file of the PDK.
+    The table widths (0.4 µm, 1.2 µm) bracket the pattern width, so it is interpolated, not clamped
+    """
+    config = PDK.SKY130A.config
+    tech_path = str(tmp_path / 'sky130A_tech_with_cross_sections.pb.json')
+    CrossSectionsCLI().main(['kpex_cross_sections',
+                             '--tech', config.tech_pb_json_path,
+                             '--out', tech_path,
+                             '--layers', 'li1',
+                             '--width_factors', '4,12',
+                             '--spacing_count', '8',
+                             '--resolution', f"{SOLVER_RESOLUTION:g}"])
+    monkeypatch.setattr(config, 'tech_pb_json_path', tech_path)
+    return tech_path
+
+
+def _direct_coupling(tech_path: str) -> float:
+    """
+    :return: field solver coupling of the pattern cross-section in aF/µm (no table lookup)
+    """
+    generator = CrossSectionTableGenerator(tech_info=TechInfo.from_json(tech_path, dielectric_filter=None),
+                                           resolution=SOLVER_RESOLUTION)
+    return generator.coupling(layer_name='li1', width=PATTERN_WIDTH_UM, spacing=PATTERN_SPACING_UM,
+                              below_layer_name='', above_layer_name='')
+
+
+def _run_rcx25d_single_cell(gds_path: str,
+                            output_dir_path: str,
+                            cross_section_tables: bool) -> CellExtractionResults:
+    cli = KpexCLI()
+    cli.main(['main',
+              '--pdk', 'sky130A',
+              '--gds', gds_path,
+              '--out_dir', output_dir_path,
+              '--2.5D',
+              '--halo', '10000',
+              '--scale', 'n',
+              '--cross_section_tables', 'yes' if cross_section_tables else 'no'])
+    assert cli.rcx25_extraction_results is not None
+    assert len(cli.rcx25_extraction_results.cell_extraction_results) == 1  # assume single cell test
+    return list(cli.rcx25_extraction_results.cell_extraction_results.values())[0]
+
+
+@allure.parent_suite(parent_suite)
+@allure.tag(*tags)
+@pytest.mark.slow
+def test_cross_section_tables_change_sidewall_li1(sky130a_tech_with_cross_section_tables, tmp_path):
+    gds_path = _gds('test_patterns', 'sidewall_20um_length_distance_200nm_li1.gds.gz')
+
+    direct = _direct_coupling(sky130a_tech_with_cross_section_tables)
+
+    formula = _run_rcx25d_single_cell(gds_path, str(tmp_path / 'formula'), cross_section_tables=False)
+    tables = _run_rcx25d_single_cell(gds_path, str(tmp_path / 'tables'), cross_section_tables=True)
+
+    formula_sidewall = formula.sidewall_cap_sums()
+    tables_sidewall = tables.sidewall_cap_sums()
+    assert len(formula_sidewall) >= 1
+    assert formula_sidewall.keys() == tables_sidewall.keys()
+    for key, cap in formula_sidewall.items():
+        assert tables_sidewall[key] > 0.0
+        assert tables_sidewall[key] != pytest.approx(cap, rel=1e-6), f"Sidewall {key} unchanged"
+
+    # NOTE: each of the two facing edges contributes half of length · coupling,
+    #       measured: table -0.16% vs. the direct solve (the formula is ~24% below it)
+    expected_femto = PATTERN_LENGTH_UM * direct / 1000.0
+    assert sum(tables_sidewall.values()) == pytest.approx(expected_femto, rel=0.01)
+
+    # NOTE: the tables only replace the sidewall coupling
+    assert formula.overlap_cap_sums() == pytest.approx(tables.overlap_cap_sums())
+    assert formula.sideoverlap_cap_sums() == pytest.approx(tables.sideoverlap_cap_sums())
+
+
+@allure.parent_suite(parent_suite)
+@allure.tag(*tags)
+@pytest.mark.slow
+def test_cross_section_table_matches_direct_solve_li1(sky130a_tech_with_cross_section_tables):
+    tech_path = sky130a_tech_with_cross_section_tables
+    tables = CrossSectionTables(tech_info=TechInfo.from_json(tech_path, dielectric_filter=None))
+    table = tables.table(layer_name='li1', below_layer_name='', above_layer_name='')
+    assert table is not None
+
+    direct = _direct_coupling(tech_path)
+    interpolated = table.coupling(width_um=PATTERN_WIDTH_UM, spacing_um=PATTERN_SPACING_UM)
+    # NOTE: measured -0.16% (98.83 vs. 98.98 aF/µm)
+    assert interpolated == pytest.approx(direct, rel=0.01)
@@ -0,0 +1,118 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+from __future__ import annotations
+
+import os
+from typing import *
+
+import allure
+import pytest
+
+from klayout_pex.kpex_cli import KpexCLI
+from klayout_pex.rcx25.extraction_results import CellExtractionResults
+
+
+parent_suite = "kpex/2.5D Extraction Tests"
+tags = ("PEX", "2.5D", "Substrate")
+
+SUBSTRATE_LAYER_NAME = 'VSUBS'
+
+# NOTE: the substrate area caps of both paths are computed from the same region boolean,
+#       the fringe of the fast path uses a substrate box synthesized per edge interval,
+#       which ends exactly at the halo (instead of the die sized box enlarged by the halo)
+AREA_REL_TOLERANCE = 1e-6
+FRINGE_REL_TOLERANCE = 1e-2
+
+
+def _gds(*path_components) -> str:
+    return os.path.realpath(os.path.join(__file__, '..', '..', '..',
+                                         'testdata', 'designs', 'sky130A', *path_components))
+
+
+def _run_rcx25d_single_cell(gds_path: str,
+                            output_dir_path: str,
+                            substrate_fast_path: bool) -> CellExtractionResults:
+    cli = KpexCLI()
+    cli.main(['main',
+              '--pdk', 'sky130A',
+              '--gds', gds_path,
+              '--out_dir', output_dir_path,
+              '--2.5D',
+              '--halo', '10000',
+              '--scale', 'n',
+              '--substrate_fast_path', 'yes' if substrate_fast_path else 'no'])
+    assert cli.rcx25_extraction_results is not None
+    assert len(cli.rcx25_extraction_results.cell_extraction_results) == 1  # assume single cell test
+    return list(cli.rcx25_extraction_results.cell_extraction_results.values())[0]
+
+
+def _split_by_substrate(cap_sums: Dict[Any, float],
+                        is_substrate: Callable[[Any], bool]) -> Tuple[Dict[Any, float], Dict[Any, float]]:
+    substrate = {k: v for k, v in cap_sums.items() if is_substrate(k)}
+    others = {k: v for k, v in cap_sums.items() if not is_substrate(k)}
+    return substrate, others
+
+
+@allure.parent_suite(parent_suite)
+@allure.tag(*tags)
+@pytest.mark.slow
+@pytest.mark.parametrize('gds_name', [
+    'single_plate_100um_x_100um_li1_over_substrate.gds.gz',
+    'overlap_plates_100um_x_100um_li1_m1_m2_m3.gds.gz',
+    'sideoverlap_simple_plates_li1_m1.gds.gz',
+    'sideoverlap_shielding_simple_plates_li1_m1_m2.gds.gz',
+    'nfet_li1_redux.gds.gz',
+])
+def test_substrate_fast_path_matches_generic_path(gds_name: str, tmp_path):
+    gds_path = _gds('test_patterns', gds_name)
+
+    generic = _run_rcx25d_single_cell(gds_path, str(tmp_path / 'generic'), substrate_fast_path=False)
+    fast = _run_rcx25d_single_cell(gds_path, str(tmp_path / 'fast'), substrate_fast_path=True)
+
+    generic_area, generic_overlap = _split_by_substrate(generic.overlap_cap_sums(),
+                                                        lambda k: k.layer_bot == SUBSTRATE_LAYER_NAME)
+    fast_area, fast_overlap = _split_by_substrate(fast.overlap_cap_sums(),
+                                                  lambda k: k.layer_bot == SUBSTRATE_LAYER_NAME)
+    assert len(generic_area) >= 1
+    assert fast_area.keys() == generic_area.keys()
+    for key, cap in generic_area.items():
+        assert fast_area[key] == pytest.approx(cap, rel=AREA_REL_TOLERANCE), f"Substrate area {key}"
+
+    # NOTE: the substrate box ends a halo beyond all shapes, so it has no fringe as the inside layer
+    generic_fringe = {k: v for k, v in generic.sideoverlap_cap_sums().items()
+                      if k.layer_outside == SUBSTRATE_LAYER_NAME}
+    fast_fringe = {k: v for k, v in fast.sideoverlap_cap_sums().items()
+                   if k.layer_outside == SUBSTRATE_LAYER_NAME}
+    assert sum(fast_fringe.values()) == pytest.approx(sum(generic_fringe.values()), rel=FRINGE_REL_TOLERANCE)
+    for key, cap in generic_fringe.items():
+        assert fast_fringe.get(key, 0.0) == pytest.approx(cap, rel=FRINGE_REL_TOLERANCE), f"Substrate fringe {key}"
+
+    # NOTE: the caps not involving the substrate do not depend on the substrate path
+    assert fast_overlap == pytest.approx(generic_overlap, rel=AREA_REL_TOLERANCE)
+    _, generic_sideoverlap = _split_by_substrate(generic.sideoverlap_cap_sums(),
+                                                 lambda k: SUBSTRATE_LAYER_NAME in (k.layer_inside, k.layer_outside))
+    _, fast_sideoverlap = _split_by_substrate(fast.sideoverlap_cap_sums(),
+                                              lambda k: SUBSTRATE_LAYER_NAME in (k.layer_inside, k.layer_outside))
+    assert fast_sideoverlap == pytest.approx(generic_sideoverlap, rel=AREA_REL_TOLERANCE)
+    assert fast.sidewall_cap_sums() == pytest.approx(generic.sidewall_cap_sums(), rel=AREA_REL_TOLERANCE)
@@ -0,0 +1,137 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+import allure
+import os
+import tempfile
+import unittest
+
+from klayout_pex.tech_info import TechInfo
+from klayout_pex.rcx25.c.geometric_moments import GeometricMoments
+from klayout_pex.rcx25.extraction_results import *
+from klayout_pex.rcx25.sensitivities import SensitivityExtractor, tech_parameters
+import klayout_pex_protobuf.kpex.r.r_network_pb2 as r_network_pb2
+import klayout_pex_protobuf.kpex.tech.tech_pb2 as tech_pb2
+
+
+def build_tech_info() -> TechInfo:
+    tech = tech_pb2.Technology(name='test')
+    pp = tech.process_parasitics
+    pp.side_halo = 8.0
+    ov = pp.capacitance.overlaps.add()
+    ov.top_layer_name, ov.bottom_layer_name, ov.capacitance = 'm2', 'm1', 40.0
+    sw = pp.capacitance.sidewalls.add()
+    sw.layer_name, sw.capacitance, sw.offset = 'm1', 50.0, 0.1
+    soc = pp.capacitance.sideoverlaps.add()
+    soc.in_layer_name, soc.out_layer_name, soc.capacitance = 'm1', 'm2', 30.0
+    lr = pp.resistance.layers.add()
+    lr.layer_name, lr.resistance = 'm1', 125.0
+    vr = pp.resistance.vias.add()
+    vr.via_name, vr.resistance = 'via1', 4500.0
+    return TechInfo(tech=tech, dielectric_filter=None)
+
+
+def build_results() -> ExtractionResults:
+    moments = GeometricMoments(scale_ratio_to_fit_halo=True)
+    moments.add_overlap(OverlapKey(layer_top='m2', net_top='A', layer_bot='m1', net_bot='B'), 2.5)
+    moments.add_sidewall(SidewallKey(layer='m1', net1='A', net2='B'), length_um=4.0, distance_um=0.2)
+    moments.add_fringe(SideOverlapKey(layer_inside='m1', net_inside='A', layer_outside='m2', net_outside='B'),
+                       length_um=1.0, distance_near_um=0.0, distance_far_um=0.5, halo_um=8.0)
+
+    cell_results = CellExtractionResults(cell_name='Cell', moments=moments)
+    moments.evaluate(tech_info=build_tech_info(), results=cell_results)
+
+    network = cell_results.r_extraction_result.networks.add()
+    network.net_name = 'A'
+    for node_id, layer_name in ((1, 'm1'), (2, 'm1'), (3, 'via1')):
+        n = network.nodes.add()
+        n.node_id = node_id
+        n.node_name = f"n{node_id}"
+        n.layer_name = layer_name
+    for element_id, (a, b, r) in enumerate(((1, 2, 3.0), (2, 3, 0.5))):
+        e = network.elements.add()
+        e.element_id = element_id
+        e.node_a.node_id = a
+        e.node_b.node_id = b
+        e.resistance = r
+
+    results = ExtractionResults()
+    results.cell_extraction_results['Cell'] = cell_results
+    return results
+
+
+@allure.parent_suite("Unit Tests")
+class SensitivitiesTest(unittest.TestCase):
+    def test_tech_parameters(self):
+        names = [p.name for p in tech_parameters(build_tech_info())]
+        self.assertEqual(['overlap_cap[m2/m1]', 'sidewall_cap[m1]', 'sidewall_offset[m1]',
+                          'sideoverlap_cap[m1/m2]', 'layer_resistance[m1]', 'via_resistance[via1]'],
+                         names)
+
+    def test_capacitance_derivatives(self):
+        sensitivities = SensitivityExtractor(tech_info=build_tech_info()).extract(build_results())
+        d = sensitivities.capacitance_derivatives[NetCoupleKey('A', 'B').normed()]
+
+        # sidewall caps are linear in their coefficient
+        self.assertAlmostEqual(4.0 / 0.3 / 2.0 / 1000.0, d['sidewall_cap[m1]'])
+        # C = c * l / (s + offset) / 2000 => dC/doffset = -c * l / (s + offset)^2 / 2000
+        self.assertAlmostEqual(-50.0 * 4.0 / 0.3 ** 2 / 2000.0, d['sidewall_offset[m1]'], places=6)
+        # the fringe depends on the sideoverlap coefficient and (via alpha) on the overlap coefficient,
+        # so the overlap derivative exceeds the pure area term
+        self.assertGreater(d['sideoverlap_cap[m1/m2]'], 0.0)
+        self.assertGreater(d['overlap_cap[m2/m1]'], 2.5 / 1000.0)
+
+    def test_overlap_derivative_is_area(self):
+        results = build_results()
+        moments = results.cell_extraction_results['Cell'].moments
+        moments.fringe_spans.clear()
+        sensitivities = SensitivityExtractor(tech_info=build_tech_info()).extract(results)
+        d = sensitivities.capacitance_derivatives[NetCoupleKey('A', 'B').normed()]
+        self.assertAlmostEqual(2.5 / 1000.0, d['overlap_cap[m2/m1]'])
+
+    def test_resistance_derivatives(self):
+        sensitivities = SensitivityExtractor(tech_info=build_tech_info()).extract(build_results())
+        wire = sensitivities.resistance_derivatives[NetCoupleKey('A.n1', 'A.n2').normed()]
+        self.assertAlmostEqual(3.0 / 125.0, wire['layer_resistance[m1]'])
+        via = sensitivities.resistance_derivatives[NetCoupleKey('A.n2', 'A.n3').normed()]
+        self.assertAlmostEqual(0.5 / 4500.0, via['via_resistance[via1]'])
+
+    def test_requires_moments(self):
+        results = ExtractionResults()
+        results.cell_extraction_results['Cell'] = CellExtractionResults(cell_name='Cell')
+        with self.assertRaises(ValueError):
+            SensitivityExtractor(tech_info=build_tech_info()).extract(results)
+
+    def test_write_csv(self):
+        sensitivities = SensitivityExtractor(tech_info=build_tech_info()).extract(build_results())
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            path = os.path.join(tmp_dir, 'sensitivities.csv')
+            sensitivities.write_csv(path)
+            with open(path, 'r', encoding='utf-8') as f:
+                lines = f.read().splitlines()
+        self.assertEqual('Device;Net1;Net2;Parameter;Parameter Value;Value;Derivative;Relative Sensitivity',
+                         lines[0])
+        self.assertTrue(any(line.startswith('C1;A;B;overlap_cap[m2/m1];40.0;') for line in lines))
+        # R relative sensitivity w.r.t. its own sheet resistance is 1
+        self.assertTrue(any(line.startswith('R1;A.n1;A.n2;layer_resistance[m1];') and line.endswith(';1')
+                            for line in lines))
@@ -0,0 +1,57 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+from __future__ import annotations
+
+from typing import *
+
+from klayout_pex.tech_info import TechInfo
+import klayout_pex_protobuf.kpex.tech.tech_pb2 as tech_pb2
+
+
+def build_tech_info(substrates: Dict[str, Tuple[float, float]] = None,
+                    overlaps: Dict[Tuple[str, str], float] = None,
+                    sidewalls: Dict[str, Tuple[float, float]] = None,
+                    sideoverlaps: Dict[Tuple[str, str], float] = None,
+                    side_halo: float = 8.0) -> TechInfo:
+    """
+    Minimal technology with only the capacitance specs of the 2.5D engine,
+    the substrate (VSUBS) specs are derived by TechInfo, as for the PDK technologies
+
+    :param substrates: layer name -> (area capacitance, perimeter capacitance)
+    :param overlaps: (top layer name, bottom layer name) -> capacitance
+    :param sidewalls: layer name -> (capacitance, offset)
+    :param sideoverlaps: (in layer name, out layer name) -> capacitance
+    """
+    tech = tech_pb2.Technology(name='test')
+    tech.process_parasitics.side_halo = side_halo
+    ci = tech.process_parasitics.capacitance
+    for layer_name, (area_cap, perimeter_cap) in (substrates or {}).items():
+        ci.substrates.add(layer_name=layer_name, area_capacitance=area_cap, perimeter_capacitance=perimeter_cap)
+    for (top_layer_name, bottom_layer_name), cap in (overlaps or {}).items():
+        ci.overlaps.add(top_layer_name=top_layer_name, bottom_layer_name=bottom_layer_name, capacitance=cap)
+    for layer_name, (cap, offset) in (sidewalls or {}).items():
+        ci.sidewalls.add(layer_name=layer_name, capacitance=cap, offset=offset)
+    for (in_layer_name, out_layer_name), cap in (sideoverlaps or {}).items():
+        ci.sideoverlaps.add(in_layer_name=in_layer_name, out_layer_name=out_layer_name, capacitance=cap)
+    return TechInfo(tech=tech, dielectric_filter=None)
@@ -0,0 +1,127 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+from __future__ import annotations
+
+import allure
+import unittest
+
+from klayout_pex.tech_info import TechInfo
+from klayout_pex.util.multiple_choice import MultipleChoicePattern
+import klayout_pex_protobuf.kpex.tech.process_stack_pb2 as process_stack_pb2
+import klayout_pex_protobuf.kpex.tech.tech_pb2 as tech_pb2
+
+LT = process_stack_pb2.ProcessStackInfo.LayerType
+ResolvedStack = process_stack_pb2.ProcessStackInfo.ResolvedStack
+
+
+def build_tech() -> tech_pb2.Technology:
+    tech = tech_pb2.Technology(name='test')
+    layers = tech.process_stack.layers
+
+    diff = layers.add(name='diff', layer_type=LT.LAYER_TYPE_DIFFUSION)
+    diff.diffusion_layer.reference = 'fox'
+    fox = layers.add(name='fox', layer_type=LT.LAYER_TYPE_FIELD_OXIDE)
+    fox.field_oxide_layer.dielectric_k = 3.9
+    m1 = layers.add(name='m1', layer_type=LT.LAYER_TYPE_METAL)
+    m1.metal_layer.z, m1.metal_layer.thickness = 1.0, 0.5
+    sw = layers.add(name='sw', layer_type=LT.LAYER_TYPE_SIDEWALL_DIELECTRIC)
+    sw.sidewall_dielectric_layer.dielectric_k = 7.0
+    sw.sidewall_dielectric_layer.width_outside_sidewall = 0.1
+    sw.sidewall_dielectric_layer.reference = 'm1'
+    cf = layers.add(name='cf', layer_type=LT.LAYER_TYPE_CONFORMAL_DIELECTRIC)
+    cf.conformal_dielectric_layer.dielectric_k = 6.0
+    cf.conformal_dielectric_layer.thickness_over_metal = 0.2
+    cf.conformal_dielectric_layer.thickness_where_no_metal = 0.05
+    cf.conformal_dielectric_layer.thickness_sidewall = 0.15
+    cf.conformal_dielectric_layer.reference = 'sw'
+    ild = layers.add(name='ild', layer_type=LT.LAYER_TYPE_SIMPLE_DIELECTRIC)
+    ild.simple_dielectric_layer.dielectric_k = 4.0
+    ild.simple_dielectric_layer.reference = 'fox'
+    m2 = layers.add(name='m2', layer_type=LT.LAYER_TYPE_METAL)
+    m2.metal_layer.z, m2.metal_layer.thickness = 3.0, 0.5
+    return tech
+
+
+def add_resolved_stack(tech: tech_pb2.Technology):
+    # what gen_tech_pb would emit for build_tech()
+    rs = tech.process_stack.resolved
+    for name, layer_type, z_bottom, z_top in (('diff', LT.LAYER_TYPE_DIFFUSION, 0.0, 0.25),
+                                              ('fox', LT.LAYER_TYPE_FIELD_OXIDE, 0.0, 1.0),
+                                              ('m1', LT.LAYER_TYPE_METAL, 1.0, 1.5),
+                                              ('sw', LT.LAYER_TYPE_SIDEWALL_DIELECTRIC, 1.0, 1.5),
+                                              ('cf', LT.LAYER_TYPE_CONFORMAL_DIELECTRIC, 1.0, 2.2),
+                                              ('ild', LT.LAYER_TYPE_SIMPLE_DIELECTRIC, 1.0, 3.0),
+                                              ('m2', LT.LAYER_TYPE_METAL, 3.0, 3.5)):
+        rs.intervals.add(name=name, layer_type=layer_type, z_bottom=z_bottom, z_top=z_top)
+    m1 = rs.metals.add(name='m1', metal_above='m2', simple_dielectric_above='ild', simple_dielectric_height=2.0)
+    m1.sidewall_shells.add(name='sw', layer_type=LT.LAYER_TYPE_SIDEWALL_DIELECTRIC,
+                           dielectric_k=7.0, width_outside=0.1, height=0.5)
+    m1.sidewall_shells.add(name='cf', layer_type=LT.LAYER_TYPE_CONFORMAL_DIELECTRIC,
+                           dielectric_k=6.0, width_outside=0.15, height=1.2, thickness_where_no_metal=0.05)
+    rs.metals.add(name='m2', metal_below='m1', simple_dielectric_height=5.0)
+
+
+@allure.parent_suite("Unit Tests")
+@allure.tag("Tech", "Process Stack")
+class Test(unittest.TestCase):
+    def test_resolved_stack_matches_derived(self):
+        legacy = TechInfo(tech=build_tech(), dielectric_filter=None)
+        self.assertIsNone(legacy.resolved_process_stack)
+
+        tech = build_tech()
+        add_resolved_stack(tech)
+        resolved = TechInfo(tech=tech, dielectric_filter=None)
+        self.assertIsNotNone(resolved.resolved_process_stack)
+
+        for metal in ('m1', 'm2'):
+            self.assertEqual(list(legacy.sidewall_dielectric_shells(metal)),
+                             list(resolved.sidewall_dielectric_shells(metal)))
+            legacy_diel, legacy_height = legacy.simple_dielectric_above_metal(metal)
+            resolved_diel, resolved_height = resolved.simple_dielectric_above_metal(metal)
+            self.assertEqual(legacy_diel, resolved_diel)
+            self.assertAlmostEqual(legacy_height, resolved_height)
+
+        shells = resolved.sidewall_dielectric_shells('m1')
+        self.assertEqual(['sw', 'cf'], [s.name for s in shells])
+        self.assertAlmostEqual(1.2, shells[1].height)
+        self.assertEqual(('ild', 2.0), (resolved.simple_dielectric_above_metal('m1')[0].name,
+                                        resolved.simple_dielectric_above_metal('m1')[1]))
+        self.assertEqual((None, 5.0), resolved.simple_dielectric_above_metal('m2'))
+
+    def test_dielectric_filter_applies_to_resolved_stack(self):
+        tech = build_tech()
+        add_resolved_stack(tech)
+        ti = TechInfo(tech=tech, dielectric_filter=MultipleChoicePattern(pattern='all,-cf,-ild'))
+        self.assertEqual(['sw'], [s.name for s in ti.sidewall_dielectric_shells('m1')])
+        self.assertEqual((None, 0.0), ti.simple_dielectric_above_metal('m1'))
+
+    def test_diffusion_z_interval(self):
+        legacy = TechInfo(tech=build_tech(), dielectric_filter=None)
+        # z of 0 in the stack, fallback height
+        self.assertEqual((0.0, 0.1), legacy.diffusion_z_interval_by_name['diff'])
+
+        tech = build_tech()
+        add_resolved_stack(tech)
+        resolved = TechInfo(tech=tech, dielectric_filter=None)
+        self.assertEqual((0.0, 0.25), resolved.diffusion_z_interval_by_name['diff'])
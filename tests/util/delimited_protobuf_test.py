@@ -0,0 +1,66 @@
+#
+# --------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: 2024-2025 Martin Jan Köhler and Harald Pretl
+# Johannes Kepler University, Institute for Integrated Circuits.
+#
+# This file is part of KPEX 
+# (see https://github.com/iic-jku/klayout-pex).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+# SPDX-License-Identifier: GPL-3.0-or-later
+# --------------------------------------------------------------------------------
+#
+import allure
+import io
+import unittest
+
+from klayout_pex.util.delimited_protobuf import read_delimited, write_delimited
+
+import klayout_pex_protobuf.kpex.c.capacitance_pb2 as capacitance_pb2
+
+
+@allure.parent_suite("Unit Tests")
+class DelimitedProtobufTest(unittest.TestCase):
+    def test_roundtrip(self):
+        messages = []
+        for i in range(300):  # sizes > 127 need multi-byte varints
+            m = capacitance_pb2.NetCoupleCapacitance()
+            m.net1 = 'a' * i
+            m.net2 = 'VSUBS'
+            m.capacitance = i * 0.5
+            messages.append(m)
+
+        stream = io.BytesIO()
+        for m in messages:
+            write_delimited(stream, m)
+
+        stream.seek(0)
+        obtained = list(read_delimited(stream, capacitance_pb2.NetCoupleCapacitance))
+        self.assertEqual(messages, obtained)
+
+    def test_empty_message(self):
+        stream = io.BytesIO()
+        write_delimited(stream, capacitance_pb2.NetCoupleCapacitance())
+        stream.seek(0)
+        obtained = list(read_delimited(stream, capacitance_pb2.NetCoupleCapacitance))
+        self.assertEqual([capacitance_pb2.NetCoupleCapacitance()], obtained)
+
+    def test_truncated_stream(self):
+        m = capacitance_pb2.NetCoupleCapacitance()
+        m.net1 = 'VDD'
+        stream = io.BytesIO()
+        write_delimited(stream, m)
+        truncated = io.BytesIO(stream.getvalue()[:-1])
+        with self.assertRaises(EOFError):
+            list(read_delimited(truncated, capacitance_pb2.NetCoupleCapacitance))